@@ -152,6 +152,18 @@ class V8_EXPORT ResourceConstraints {
     initial_young_generation_size_ = initial_size;
   }
 
+  /**
+   * The target duration of garbage collection pauses on the main thread, in
+   * milliseconds. With a target, V8 keeps incremental marking steps below
+   * it, moves more marking work to background threads and finalizes marking
+   * as soon as possible. Pauses may still exceed the target, e.g. when
+   * memory runs out. Zero means no target.
+   */
+  double gc_pause_target_in_ms() const { return gc_pause_target_in_ms_; }
+  void set_gc_pause_target_in_ms(double target) {
+    gc_pause_target_in_ms_ = target;
+  }
+
  private:
   static constexpr size_t kMB = 1048576u;
   size_t code_range_size_ = 0;
@@ -159,6 +171,7 @@ class V8_EXPORT ResourceConstraints {
   size_t max_young_generation_size_ = 0;
   size_t initial_old_generation_size_ = 0;
   size_t initial_young_generation_size_ = 0;
+  double gc_pause_target_in_ms_ = 0;
   uint32_t* stack_limit_ = nullptr;
 };
 
@@ -401,6 +414,31 @@ class V8_EXPORT Isolate {
     bool prev_value_;
   };
 
+  /**
+   * Scope for a short-lived unit of work, such as handling a single request,
+   * whose allocations are expected to die when the work is done. Young
+   * objects allocated inside the outermost scope are placed on dedicated
+   * pages. If none of them is reachable from outside of these pages when the
+   * scope ends, the pages are reused right away without a garbage collection.
+   * Otherwise the objects are left to the next regular young generation
+   * garbage collection.
+   *
+   * Handles that are still alive at the end of the scope keep the objects
+   * they refer to, so the scope should enclose the HandleScope of the work.
+   */
+  class V8_EXPORT V8_NODISCARD RequestScope {
+   public:
+    explicit RequestScope(Isolate* isolate);
+    ~RequestScope();
+
+    // Prevent copying of Scope objects.
+    RequestScope(const RequestScope&) = delete;
+    RequestScope& operator=(const RequestScope&) = delete;
+
+   private:
+    internal::Isolate* const i_isolate_;
+  };
+
   /**
    * Types of garbage collections that can be requested via
    * RequestGarbageCollectionForTesting.
@@ -1361,6 +1399,14 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Sets the target duration of garbage collection pauses on the main thread,
+   * in milliseconds. See ResourceConstraints::gc_pause_target_in_ms(). A
+   * target of zero removes the target. How often the target was exceeded is
+   * reported in HeapStatistics.
+   */
+  void SetGCPauseTarget(double target_in_ms);
+
   /**
    * Update load start time of the RAIL mode
    */
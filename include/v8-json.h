@@ -5,15 +5,25 @@
 #ifndef INCLUDE_V8_JSON_H_
 #define INCLUDE_V8_JSON_H_
 
-#include "v8-local-handle.h"  // NOLINT(build/include_directory)
-#include "v8config.h"         // NOLINT(build/include_directory)
+#include <memory>
+
+#include "v8-local-handle.h"       // NOLINT(build/include_directory)
+#include "v8-maybe.h"              // NOLINT(build/include_directory)
+#include "v8-persistent-handle.h"  // NOLINT(build/include_directory)
+#include "v8config.h"              // NOLINT(build/include_directory)
 
 namespace v8 {
 
 class Context;
+class Isolate;
+class OutputStream;
 class Value;
 class String;
 
+namespace internal {
+class BackgroundJsonParseTask;
+}  // namespace internal
+
 /**
  * A JSON Parser and Stringifier.
  */
@@ -30,6 +40,56 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<Value> Parse(
       Local<Context> context, Local<String> json_string);
 
+  /**
+   * A task which the embedder can run on a background thread to tokenize and
+   * validate a JSON string. Returned by JSON::StartParse.
+   */
+  class V8_EXPORT ParseTask final {
+   public:
+    ~ParseTask();
+
+    /**
+     * Scans the JSON text. Can execute on any thread, and does not access the
+     * isolate's heap. Must be called at most once.
+     */
+    void Run();
+
+   private:
+    friend class JSON;
+
+    ParseTask(Isolate* isolate, Local<String> json_string,
+              std::unique_ptr<internal::BackgroundJsonParseTask> impl);
+
+    Global<String> json_string_;
+    std::unique_ptr<internal::BackgroundJsonParseTask> impl_;
+  };
+
+  /**
+   * Starts parsing |json_string| off the isolate's thread. This copies the
+   * string's characters; the embedder is then responsible for calling
+   * ParseTask::Run, typically on a background thread, and for passing the task
+   * and the same string to FinishParse afterwards. Only creating the resulting
+   * objects then happens on the isolate's thread. The task holds on to
+   * |json_string| and must be destroyed on the isolate's thread.
+   */
+  static std::unique_ptr<ParseTask> StartParse(Isolate* isolate,
+                                               Local<String> json_string);
+
+  /**
+   * Finishes a parse started with StartParse and returns the same result as
+   * Parse would for |json_string|. If the task was not run, or the string is
+   * not valid JSON, the string is parsed on the calling thread instead, so
+   * that errors are reported exactly as by Parse.
+   *
+   * \param context The context in which to create the value.
+   * \param json_string The string that was passed to StartParse.
+   * \param task The task returned by StartParse.
+   * \return The corresponding value if successfully parsed.
+   */
+  static V8_WARN_UNUSED_RESULT MaybeLocal<Value> FinishParse(
+      Local<Context> context, Local<String> json_string,
+      std::unique_ptr<ParseTask> task);
+
   /**
    * Tries to stringify the JSON-serializable object |json_object| and returns
    * it as string if successful.
@@ -40,6 +100,24 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> Stringify(
       Local<Context> context, Local<Value> json_object,
       Local<String> gap = Local<String>());
+
+  /**
+   * Like Stringify, but writes the result to |stream| as UTF-8 while the
+   * object is being serialized, in chunks of at most stream->GetChunkSize()
+   * bytes, instead of creating a string. Memory use stays bounded and the
+   * result is not limited by the maximum string length.
+   *
+   * The stream's EndOfStream is called once the whole result has been
+   * written. If the stream returns kAbort, the remaining output is discarded.
+   * Lone surrogates, which can only stem from |gap|, are written as U+FFFD.
+   *
+   * \return Just(true) if the value was serialized, Just(false) if it is not
+   * JSON-serializable (for example undefined), in which case nothing is
+   * written, and Nothing if an exception was thrown.
+   */
+  static V8_WARN_UNUSED_RESULT Maybe<bool> StringifyToStream(
+      Local<Context> context, Local<Value> json_object, OutputStream* stream,
+      Local<String> gap = Local<String>());
 };
 
 }  // namespace v8
@@ -8,6 +8,7 @@
 #include <limits.h>
 
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -22,6 +23,7 @@
 namespace v8 {
 
 enum class EmbedderStateTag : uint8_t;
+struct HeapCensusEntry;
 class HeapGraphNode;
 struct HeapStatsUpdate;
 class Object;
@@ -632,7 +634,8 @@ class V8_EXPORT HeapGraphNode {
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,            // See format description near 'Serialize' method.
+    kCompressedJSON = 1,  // The JSON format, compressed with gzip.
   };
 
   /** Returns the root node of the heap graph. */
@@ -682,6 +685,12 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * For the compressed JSON format, the stream receives a gzip stream of the
+   * JSON representation instead, which can be expanded offline with any gzip
+   * tool. The chunks passed to OutputStream::WriteAsciiChunk contain binary
+   * data in this case. This format is only available if V8 is built with
+   * zlib.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
@@ -1157,6 +1166,31 @@ class V8_EXPORT HeapProfiler {
    */
   AllocationProfile* GetAllocationProfile();
 
+  /**
+   * Starts a sampled census of the live heap. The census is taken during
+   * regular full garbage collections: on average one object is sampled every
+   * |sample_interval| bytes of marked memory, and the samples are scaled up to
+   * estimate the number and size of live objects per instance type and
+   * constructor name. No garbage collection is triggered.
+   *
+   * Larger intervals reduce the overhead but increase the estimation error
+   * for rare object kinds.
+   */
+  void StartHeapCensus(size_t sample_interval = 64 * 1024);
+
+  /**
+   * Stops sampling. The census of the last garbage collection remains
+   * available.
+   */
+  void StopHeapCensus();
+
+  /**
+   * Returns the census of the last full garbage collection since
+   * StartHeapCensus was called, sorted by decreasing size. Returns an empty
+   * vector if no full garbage collection has completed since then.
+   */
+  std::vector<HeapCensusEntry> GetHeapCensus();
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
@@ -1196,6 +1230,19 @@ struct HeapStatsUpdate {
   uint32_t size;  // New value of size field for the interval with this index.
 };
 
+/**
+ * An estimate of the live objects of one kind.
+ * See HeapProfiler::GetHeapCensus.
+ */
+struct HeapCensusEntry {
+  // Name of the internal instance type, e.g. "JS_OBJECT_TYPE".
+  const char* instance_type;
+  // Name of the constructor for JavaScript objects, empty otherwise.
+  std::string constructor_name;
+  size_t count;
+  size_t size;
+};
+
 #define CODE_EVENTS_LIST(V)                          \
   V(Builtin)                                         \
   V(Callback)                                        \
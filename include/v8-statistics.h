@@ -174,6 +174,18 @@ class V8_EXPORT HeapStatistics {
    */
   size_t does_zap_garbage() { return does_zap_garbage_; }
 
+  /**
+   * Returns the number of garbage collection pauses on the main thread that
+   * were observed while a pause target was set (see
+   * Isolate::SetGCPauseTarget()), and how many of them exceeded the target.
+   */
+  size_t number_of_gc_pauses_with_target() {
+    return number_of_gc_pauses_with_target_;
+  }
+  size_t number_of_gc_pauses_exceeding_target() {
+    return number_of_gc_pauses_exceeding_target_;
+  }
+
  private:
   size_t total_heap_size_;
   size_t total_heap_size_executable_;
@@ -189,6 +201,8 @@ class V8_EXPORT HeapStatistics {
   size_t number_of_detached_contexts_;
   size_t total_global_handles_size_;
   size_t used_global_handles_size_;
+  size_t number_of_gc_pauses_with_target_;
+  size_t number_of_gc_pauses_exceeding_target_;
 
   friend class V8;
   friend class Isolate;
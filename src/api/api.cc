@@ -61,8 +61,10 @@
 #include "src/handles/persistent-handles.h"
 #include "src/handles/shared-object-conveyor-handles.h"
 #include "src/handles/traced-handles.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap-write-barrier.h"
+#include "src/heap/request-scope-nursery.h"
 #include "src/heap/safepoint.h"
 #include "src/init/bootstrapper.h"
 #include "src/init/icu_util.h"
@@ -3364,6 +3366,39 @@ MaybeLocal<Value> JSON::Parse(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+JSON::ParseTask::ParseTask(Isolate* isolate, Local<String> json_string,
+                           std::unique_ptr<i::BackgroundJsonParseTask> impl)
+    : json_string_(isolate, json_string), impl_(std::move(impl)) {}
+
+JSON::ParseTask::~ParseTask() = default;
+
+void JSON::ParseTask::Run() { impl_->Run(); }
+
+std::unique_ptr<JSON::ParseTask> JSON::StartParse(Isolate* v8_isolate,
+                                                  Local<String> json_string) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  DCHECK_NO_SCRIPT_NO_EXCEPTION(i_isolate);
+  i::Handle<i::String> string = Utils::OpenHandle(*json_string);
+  // The constructor is private, so std::make_unique can't be used here.
+  return std::unique_ptr<ParseTask>(new ParseTask(
+      v8_isolate, json_string,
+      std::make_unique<i::BackgroundJsonParseTask>(i_isolate, string)));
+}
+
+MaybeLocal<Value> JSON::FinishParse(Local<Context> context,
+                                    Local<String> json_string,
+                                    std::unique_ptr<ParseTask> task) {
+  PREPARE_FOR_EXECUTION(context, JSON, FinishParse, Value);
+  Utils::ApiCheck(task->json_string_ == json_string, "v8::JSON::FinishParse",
+                  "String differs from the one passed to StartParse");
+  i::Handle<i::String> string = Utils::OpenHandle(*json_string);
+  Local<Value> result;
+  has_pending_exception =
+      !ToLocal<Value>(task->impl_->Finish(i_isolate, string), &result);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
 MaybeLocal<String> JSON::Stringify(Local<Context> context,
                                    Local<Value> json_object,
                                    Local<String> gap) {
@@ -3385,6 +3420,23 @@ MaybeLocal<String> JSON::Stringify(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+Maybe<bool> JSON::StringifyToStream(Local<Context> context,
+                                    Local<Value> json_object,
+                                    OutputStream* stream, Local<String> gap) {
+  auto i_isolate = reinterpret_cast<i::Isolate*>(context->GetIsolate());
+  ENTER_V8(i_isolate, context, JSON, StringifyToStream, Nothing<bool>(),
+           i::HandleScope);
+  i::Handle<i::Object> object = Utils::OpenHandle(*json_object);
+  i::Handle<i::Object> gap_string = gap.IsEmpty()
+                                        ? i_isolate->factory()->empty_string()
+                                        : Utils::OpenHandle(*gap);
+  Maybe<bool> result =
+      i::JsonStringifyToStream(i_isolate, object, gap_string, stream);
+  has_pending_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
 // --- V a l u e   S e r i a l i z a t i o n ---
 
 SharedValueConveyor::SharedValueConveyor(SharedValueConveyor&& other) noexcept
@@ -6413,7 +6465,9 @@ HeapStatistics::HeapStatistics()
       peak_malloced_memory_(0),
       does_zap_garbage_(false),
       number_of_native_contexts_(0),
-      number_of_detached_contexts_(0) {}
+      number_of_detached_contexts_(0),
+      number_of_gc_pauses_with_target_(0),
+      number_of_gc_pauses_exceeding_target_(0) {}
 
 HeapSpaceStatistics::HeapSpaceStatistics()
     : space_name_(nullptr),
@@ -9519,6 +9573,15 @@ Isolate::SafeForTerminationScope::~SafeForTerminationScope() {
   i_isolate_->set_next_v8_call_is_safe_for_termination(prev_value_);
 }
 
+Isolate::RequestScope::RequestScope(Isolate* v8_isolate)
+    : i_isolate_(reinterpret_cast<i::Isolate*>(v8_isolate)) {
+  i_isolate_->heap()->request_scope_nursery()->Enter();
+}
+
+Isolate::RequestScope::~RequestScope() {
+  i_isolate_->heap()->request_scope_nursery()->Exit();
+}
+
 i::Address* Isolate::GetDataFromSnapshotOnce(size_t index) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
   i::FixedArray list = i_isolate->heap()->serialized_objects();
@@ -9578,6 +9641,10 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
   heap_statistics->number_of_detached_contexts_ =
       heap->NumberOfDetachedContexts();
   heap_statistics->does_zap_garbage_ = i::heap::ShouldZapGarbage();
+  heap_statistics->number_of_gc_pauses_with_target_ =
+      heap->tracer()->pauses_with_target();
+  heap_statistics->number_of_gc_pauses_exceeding_target_ =
+      heap->tracer()->pauses_exceeding_target();
 
 #if V8_ENABLE_WEBASSEMBLY
   heap_statistics->malloced_memory_ +=
@@ -9930,6 +9997,12 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return i_isolate->SetRAILMode(rail_mode);
 }
 
+void Isolate::SetGCPauseTarget(double target_in_ms) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  i_isolate->heap()->SetGCPauseTarget(
+      base::TimeDelta::FromMillisecondsD(target_in_ms));
+}
+
 void Isolate::UpdateLoadStartTime() {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
   i_isolate->UpdateLoadStartTime();
@@ -10854,11 +10927,21 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kCompressedJSON,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
+  if (format == kCompressedJSON) {
+#ifdef V8_USE_ZLIB
+    serializer.SerializeCompressed(stream);
+#else
+    Utils::ApiCheck(false, "v8::HeapSnapshot::Serialize",
+                    "Compressed serialization requires V8 built with zlib");
+#endif  // V8_USE_ZLIB
+    return;
+  }
   serializer.Serialize(stream);
 }
 
@@ -10946,6 +11029,20 @@ AllocationProfile* HeapProfiler::GetAllocationProfile() {
   return reinterpret_cast<i::HeapProfiler*>(this)->GetAllocationProfile();
 }
 
+void HeapProfiler::StartHeapCensus(size_t sample_interval) {
+  Utils::ApiCheck(sample_interval > 0, "v8::HeapProfiler::StartHeapCensus",
+                  "sample_interval must be positive");
+  reinterpret_cast<i::HeapProfiler*>(this)->StartHeapCensus(sample_interval);
+}
+
+void HeapProfiler::StopHeapCensus() {
+  reinterpret_cast<i::HeapProfiler*>(this)->StopHeapCensus();
+}
+
+std::vector<HeapCensusEntry> HeapProfiler::GetHeapCensus() {
+  return reinterpret_cast<i::HeapProfiler*>(this)->GetHeapCensus();
+}
+
 void HeapProfiler::DeleteAllHeapSnapshots() {
   reinterpret_cast<i::HeapProfiler*>(this)->DeleteAllSnapshots();
 }
@@ -49,6 +49,10 @@
 constexpr int kReturnAddressStackSlotCount =
     V8_TARGET_ARCH_STORES_RETURN_ADDRESS_ON_STACK ? 1 : 0;
 
+// Size of a transparent huge page on x64 and arm64 Linux.
+constexpr int kHugePageBits = 21;
+constexpr int kHugePageSize = 1 << kHugePageBits;
+
 // Number of bits to represent the page size for paged spaces.
 #if (defined(V8_HOST_ARCH_PPC) || defined(V8_HOST_ARCH_PPC64)) && !defined(_AIX)
 // Native PPC linux has large (64KB) physical pages.
@@ -57,8 +61,6 @@ constexpr int kPageSizeBits = 19;
 #elif defined(ENABLE_HUGEPAGE)
 // When enabling huge pages, adjust V8 page size to take up exactly one huge
 // page. This avoids huge-page-internal fragmentation for unused address ranges.
-constexpr int kHugePageBits = 21;
-constexpr int kHugePageSize = 1 << kHugePageBits;
 constexpr int kPageSizeBits = kHugePageBits;
 #else
 // Arm64 supports up to 64k OS pages on Linux, however 4k pages are more common
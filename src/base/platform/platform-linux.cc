@@ -276,6 +276,17 @@ std::vector<OS::SharedLibraryAddress> OS::GetSharedLibraryAddresses() {
   return ::v8::base::GetSharedLibraryAddresses(nullptr);
 }
 
+// static
+bool OS::AdviseHugePages(void* address, size_t size) {
+  DCHECK(IsAligned(reinterpret_cast<uintptr_t>(address), CommitPageSize()));
+  DCHECK(IsAligned(size, CommitPageSize()));
+#ifdef MADV_HUGEPAGE
+  return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
 // static
 bool OS::RemapPages(const void* address, size_t size, void* new_address,
                     MemoryPermission access) {
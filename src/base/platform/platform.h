@@ -343,6 +343,24 @@ class V8_BASE_EXPORT OS {
                                                void* new_address,
                                                MemoryPermission access);
 
+  // Whether the platform supports backing memory with transparent huge pages.
+  V8_WARN_UNUSED_RESULT static constexpr bool IsTransparentHugePageSupported() {
+#if defined(V8_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Asks the kernel to back the memory in the given range with transparent
+  // huge pages. The range may be reserved but not yet committed, in which case
+  // the advice applies to pages committed later. Only the parts of the range
+  // that are aligned to kHugePageSize can be backed by huge pages.
+  //
+  // Must not be called if |IsTransparentHugePageSupported()| returns false.
+  // Returns true for success.
+  V8_WARN_UNUSED_RESULT static bool AdviseHugePages(void* address, size_t size);
+
   // Make part of the process's data memory read-only.
   static void SetDataReadOnly(void* address, size_t size);
 
@@ -184,12 +184,26 @@ class WriteBarrierCodeStubAssembler : public CodeStubAssembler {
 
   void InsertIntoRememberedSet(TNode<IntPtrT> object, TNode<IntPtrT> slot,
                                SaveFPRegsMode fp_mode) {
-    Label slow_path(this), next(this);
+    Label slow_path(this), slot_set_path(this), next(this);
     TNode<IntPtrT> page = PageFromAddress(object);
+    TNode<IntPtrT> slot_offset = IntPtrSub(slot, page);
 
+    // Pages with a card table only need the card to be dirtied, which is a
+    // single byte store. It still takes a branch on the card table pointer,
+    // which is null for every page that uses the slot set, since only large
+    // old pages have card tables.
+    TNode<IntPtrT> card_table = UncheckedCast<IntPtrT>(
+        Load(MachineType::Pointer(), page,
+             IntPtrConstant(MemoryChunk::kCardTableOffset)));
+    GotoIf(WordEqual(card_table, IntPtrConstant(0)), &slot_set_path);
+    StoreNoWriteBarrier(
+        MachineRepresentation::kWord8, card_table,
+        WordShr(slot_offset, MemoryChunk::kCardSizeLog2), Int32Constant(1));
+    Goto(&next);
+
+    BIND(&slot_set_path);
     // Load address of SlotSet
     TNode<IntPtrT> slot_set = LoadSlotSet(page, &slow_path);
-    TNode<IntPtrT> slot_offset = IntPtrSub(slot, page);
 
     // Load bucket
     TNode<IntPtrT> bucket = LoadBucket(slot_set, slot_offset, &slow_path);
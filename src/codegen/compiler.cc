@@ -1090,7 +1090,10 @@ bool CompileTurbofan_Concurrent(Isolate* isolate,
   DCHECK_EQ(compilation_info->code_kind(), CodeKind::TURBOFAN);
   Handle<JSFunction> function = compilation_info->closure();
 
-  if (!isolate->optimizing_compile_dispatcher()->IsQueueAvailable()) {
+  OptimizingCompileDispatcher* dispatcher =
+      isolate->optimizing_compile_dispatcher();
+  if (!dispatcher->IsQueueAvailable()) dispatcher->CancelStaleJobs();
+  if (!dispatcher->IsQueueAvailable()) {
     if (v8_flags.trace_concurrent_recompilation) {
       PrintF("  ** Compilation queue full, will retry optimizing ");
       ShortPrint(*function);
@@ -1120,7 +1123,7 @@ bool CompileTurbofan_Concurrent(Isolate* isolate,
   }
 
   // The background recompile will own this job.
-  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job.release());
+  dispatcher->QueueForOptimization(job.release());
 
   if (v8_flags.trace_concurrent_recompilation) {
     PrintF("  ** Queued ");
@@ -2145,6 +2145,16 @@ inline std::ostream& operator<<(std::ostream& os, TieringState marker) {
 
 #undef TIERING_STATE_LIST
 
+// The highest tier a function reached before, kept on its SharedFunctionInfo
+// (and thus in the code cache). With --profile-guided-optimization, closures
+// of the function tier up to it early. Ordered by tier.
+enum class CachedTieringDecision : uint8_t {
+  kPending,
+  kEarlySparkplug,
+  kEarlyMaglev,
+  kEarlyTurbofan,
+};
+
 enum class SpeculationMode { kAllowSpeculation, kDisallowSpeculation };
 enum class CallFeedbackContent { kTarget, kReceiver };
 
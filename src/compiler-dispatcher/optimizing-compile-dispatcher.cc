@@ -4,6 +4,9 @@
 
 #include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "src/base/atomicops.h"
 #include "src/codegen/compiler.h"
 #include "src/codegen/optimized-compilation-info.h"
@@ -15,7 +18,7 @@
 #include "src/logging/counters.h"
 #include "src/logging/log.h"
 #include "src/logging/runtime-call-stats-scope.h"
-#include "src/objects/js-function.h"
+#include "src/objects/js-function-inl.h"
 #include "src/tasks/cancelable-task.h"
 #include "src/tracing/trace-event.h"
 
@@ -74,24 +77,51 @@ class OptimizingCompileDispatcher::CompileTask : public v8::JobTask {
 };
 
 OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
-  DCHECK_EQ(0, input_queue_length_);
+  DCHECK(input_queue_.empty());
   if (job_handle_ && job_handle_->IsValid()) {
     // Wait for the job handle to complete, so that we know the queue
     // pointers are safe.
     job_handle_->Cancel();
   }
-  DeleteArray(input_queue_);
 }
 
 TurbofanCompilationJob* OptimizingCompileDispatcher::NextInput(
     LocalIsolate* local_isolate) {
-  base::MutexGuard access_input_queue_(&input_queue_mutex_);
-  if (input_queue_length_ == 0) return nullptr;
-  TurbofanCompilationJob* job = input_queue_[InputQueueIndex(0)];
-  DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
-  return job;
+  InputQueueEntry entry;
+  {
+    base::MutexGuard access_input_queue_(&input_queue_mutex_);
+    if (input_queue_.empty()) return nullptr;
+    std::pop_heap(input_queue_.begin(), input_queue_.end(), IsColder);
+    entry = input_queue_.back();
+    input_queue_.pop_back();
+  }
+  DCHECK_NOT_NULL(entry.job);
+  isolate_->counters()->turbofan_optimize_queue_wait_time()->AddTimedSample(
+      base::TimeTicks::Now() - entry.queued_at);
+  return entry.job;
+}
+
+uint64_t OptimizingCompileDispatcher::HotnessOf(
+    TurbofanCompilationJob* job) const {
+  if (!v8_flags.concurrent_recompilation_prioritize_hot) return 0;
+  OptimizedCompilationInfo* info = job->compilation_info();
+  // OSR is only requested for functions stuck in a long-running loop, so they
+  // are the hottest by definition.
+  if (info->is_osr()) return std::numeric_limits<uint64_t>::max();
+  JSFunction function = *info->closure();
+  if (!function->has_feedback_vector()) return 0;
+  return function->feedback_vector()->invocation_count(kRelaxedLoad);
+}
+
+bool OptimizingCompileDispatcher::IsStale(TurbofanCompilationJob* job) const {
+  OptimizedCompilationInfo* info = job->compilation_info();
+  // OSR code is requested for a specific loop and stays useful.
+  if (info->is_osr()) return false;
+  JSFunction function = *info->closure();
+  return function->HasAvailableCodeKind(info->code_kind()) ||
+         function->shared()->optimization_disabled() ||
+         !function->has_feedback_vector() ||
+         !IsInProgress(function->tiering_state());
 }
 
 void OptimizingCompileDispatcher::CompileNext(TurbofanCompilationJob* job,
@@ -131,14 +161,40 @@ void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
 
 void OptimizingCompileDispatcher::FlushInputQueue() {
   base::MutexGuard access_input_queue_(&input_queue_mutex_);
-  while (input_queue_length_ > 0) {
-    std::unique_ptr<TurbofanCompilationJob> job(
-        input_queue_[InputQueueIndex(0)]);
+  for (const InputQueueEntry& entry : input_queue_) {
+    std::unique_ptr<TurbofanCompilationJob> job(entry.job);
     DCHECK_NOT_NULL(job);
-    input_queue_shift_ = InputQueueIndex(1);
-    input_queue_length_--;
     Compiler::DisposeTurbofanCompilationJob(isolate_, job.get(), true);
   }
+  input_queue_.clear();
+}
+
+void OptimizingCompileDispatcher::CancelStaleJobs() {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  HandleScope handle_scope(isolate_);
+  base::MutexGuard access_input_queue_(&input_queue_mutex_);
+  auto stale_begin = std::partition(
+      input_queue_.begin(), input_queue_.end(),
+      [this](const InputQueueEntry& entry) { return !IsStale(entry.job); });
+  if (stale_begin == input_queue_.end()) return;
+  for (auto it = stale_begin; it != input_queue_.end(); ++it) {
+    std::unique_ptr<TurbofanCompilationJob> job(it->job);
+    JSFunction function = *job->compilation_info()->closure();
+    if (v8_flags.trace_concurrent_recompilation) {
+      PrintF("  ** Cancelling stale compilation for ");
+      ShortPrint(function);
+      PrintF(".\n");
+    }
+    isolate_->counters()->turbofan_stale_jobs_cancelled()->Increment();
+    // Leave the tiering state alone if the request was reset already, a new
+    // request may have been made in the meantime.
+    if (function->has_feedback_vector() &&
+        IsInProgress(function->tiering_state())) {
+      Compiler::DisposeTurbofanCompilationJob(isolate_, job.get(), false);
+    }
+  }
+  input_queue_.erase(stale_begin, input_queue_.end());
+  std::make_heap(input_queue_.begin(), input_queue_.end(), IsColder);
 }
 
 void OptimizingCompileDispatcher::AwaitCompileTasks() {
@@ -153,7 +209,7 @@ void OptimizingCompileDispatcher::AwaitCompileTasks() {
 
 #ifdef DEBUG
   base::MutexGuard access_input_queue(&input_queue_mutex_);
-  CHECK_EQ(input_queue_length_, 0);
+  CHECK(input_queue_.empty());
 #endif  // DEBUG
 }
 
@@ -178,8 +234,8 @@ void OptimizingCompileDispatcher::Stop() {
   HandleScope handle_scope(isolate_);
   FlushQueues(BlockingBehavior::kBlock, false);
   // At this point the optimizing compiler thread's event loop has stopped.
-  // There is no need for a mutex when reading input_queue_length_.
-  DCHECK_EQ(input_queue_length_, 0);
+  // There is no need for a mutex when reading input_queue_.
+  DCHECK(input_queue_.empty());
 }
 
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
@@ -220,12 +276,13 @@ bool OptimizingCompileDispatcher::HasJobs() {
 void OptimizingCompileDispatcher::QueueForOptimization(
     TurbofanCompilationJob* job) {
   DCHECK(IsQueueAvailable());
+  const uint64_t hotness = HotnessOf(job);
   {
-    // Add job to the back of the input queue.
     base::MutexGuard access_input_queue(&input_queue_mutex_);
-    DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
-    input_queue_length_++;
+    DCHECK_LT(static_cast<int>(input_queue_.size()), input_queue_capacity_);
+    input_queue_.push_back(
+        {job, hotness, next_sequence_number_++, base::TimeTicks::Now()});
+    std::push_heap(input_queue_.begin(), input_queue_.end(), IsColder);
   }
   job_handle_->NotifyConcurrencyIncrease();
 }
@@ -233,10 +290,8 @@ void OptimizingCompileDispatcher::QueueForOptimization(
 OptimizingCompileDispatcher::OptimizingCompileDispatcher(Isolate* isolate)
     : isolate_(isolate),
       input_queue_capacity_(v8_flags.concurrent_recompilation_queue_length),
-      input_queue_length_(0),
-      input_queue_shift_(0),
       recompilation_delay_(v8_flags.concurrent_recompilation_delay) {
-  input_queue_ = NewArray<TurbofanCompilationJob*>(input_queue_capacity_);
+  input_queue_.reserve(input_queue_capacity_);
   if (v8_flags.concurrent_recompilation) {
     job_handle_ = V8::GetCurrentPlatform()->PostJob(
         kTaskPriority, std::make_unique<CompileTask>(isolate, this));
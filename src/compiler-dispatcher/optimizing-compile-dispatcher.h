@@ -7,9 +7,11 @@
 
 #include <atomic>
 #include <queue>
+#include <vector>
 
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/time.h"
 #include "src/common/globals.h"
 #include "src/flags/flags.h"
 #include "src/heap/parked-scope.h"
@@ -31,19 +33,25 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
 
   void Stop();
   void Flush(BlockingBehavior blocking_behavior);
-  // Takes ownership of |job|.
+  // Takes ownership of |job|. Jobs of hotter functions are compiled first.
   void QueueForOptimization(TurbofanCompilationJob* job);
   void AwaitCompileTasks();
   void InstallOptimizedFunctions();
 
+  // Disposes queued jobs that have not started yet and whose function is no
+  // longer worth optimizing, e.g. because it was optimized in the meantime or
+  // its tiering request was reset by a deoptimization. Must be called on the
+  // main thread.
+  void CancelStaleJobs();
+
   inline bool IsQueueAvailable() {
     base::MutexGuard access_input_queue(&input_queue_mutex_);
-    return input_queue_length_ < input_queue_capacity_;
+    return static_cast<int>(input_queue_.size()) < input_queue_capacity_;
   }
 
   inline int InputQueueLength() {
     base::MutexGuard access_input_queue(&input_queue_mutex_);
-    return input_queue_length_;
+    return static_cast<int>(input_queue_.size());
   }
 
   static bool Enabled() { return v8_flags.concurrent_recompilation; }
@@ -63,6 +71,20 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
  private:
   class CompileTask;
 
+  struct InputQueueEntry {
+    TurbofanCompilationJob* job;
+    uint64_t hotness;
+    // Keeps jobs of equal hotness in FIFO order.
+    uint64_t sequence_number;
+    base::TimeTicks queued_at;
+  };
+
+  // Orders the input queue as a max-heap by hotness.
+  static bool IsColder(const InputQueueEntry& a, const InputQueueEntry& b) {
+    if (a.hotness != b.hotness) return a.hotness < b.hotness;
+    return a.sequence_number > b.sequence_number;
+  }
+
   enum ModeFlag { COMPILE, FLUSH };
   static constexpr TaskPriority kTaskPriority = TaskPriority::kUserVisible;
 
@@ -72,21 +94,16 @@ class V8_EXPORT_PRIVATE OptimizingCompileDispatcher {
   void FlushOutputQueue(bool restore_function_code);
   void CompileNext(TurbofanCompilationJob* job, LocalIsolate* local_isolate);
   TurbofanCompilationJob* NextInput(LocalIsolate* local_isolate);
-
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  uint64_t HotnessOf(TurbofanCompilationJob* job) const;
+  bool IsStale(TurbofanCompilationJob* job) const;
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  TurbofanCompilationJob** input_queue_;
+  // Priority queue of incoming recompilation tasks (including OSR), see
+  // IsColder().
+  std::vector<InputQueueEntry> input_queue_;
   int input_queue_capacity_;
-  int input_queue_length_;
-  int input_queue_shift_;
+  uint64_t next_sequence_number_ = 0;
   base::Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
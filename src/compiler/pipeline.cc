@@ -14,6 +14,7 @@
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/bailout-reason.h"
 #include "src/codegen/compiler.h"
+#include "src/codegen/cpu-features.h"
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/codegen/register-configuration.h"
 #include "src/codegen/reloc-info.h"
@@ -85,6 +86,8 @@
 #include "src/compiler/turboshaft/dead-code-elimination-phase.h"
 #include "src/compiler/turboshaft/decompression-optimization-phase.h"
 #include "src/compiler/turboshaft/instruction-selection-phase.h"
+#include "src/compiler/turboshaft/loop-peeling-phase.h"
+#include "src/compiler/turboshaft/loop-unrolling-phase.h"
 #include "src/compiler/turboshaft/machine-lowering-phase.h"
 #include "src/compiler/turboshaft/optimize-phase.h"
 #include "src/compiler/turboshaft/phase.h"
@@ -118,6 +121,7 @@
 #if V8_ENABLE_WEBASSEMBLY
 #include "src/compiler/int64-lowering.h"
 #include "src/compiler/turboshaft/int64-lowering-phase.h"
+#include "src/compiler/turboshaft/loop-vectorization-phase.h"
 #include "src/compiler/turboshaft/wasm-optimize-phase.h"
 #include "src/compiler/wasm-compiler.h"
 #include "src/compiler/wasm-escape-analysis.h"
@@ -3094,6 +3098,23 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
 
     Run<turboshaft::MachineLoweringPhase>();
 
+    if (v8_flags.turboshaft_loop_peeling) {
+      Run<turboshaft::LoopPeelingPhase>();
+    }
+
+#if V8_ENABLE_WEBASSEMBLY && V8_TARGET_LITTLE_ENDIAN
+    // The vector loop uses the Simd128 operations of wasm, whose lanes are in
+    // memory order on little endian targets only.
+    if (v8_flags.turboshaft_loop_vectorization &&
+        CpuFeatures::SupportsWasmSimd128()) {
+      Run<turboshaft::LoopVectorizationPhase>();
+    }
+#endif  // V8_ENABLE_WEBASSEMBLY && V8_TARGET_LITTLE_ENDIAN
+
+    if (v8_flags.turboshaft_loop_unrolling) {
+      Run<turboshaft::LoopUnrollingPhase>();
+    }
+
     if (v8_flags.turbo_store_elimination) {
       Run<turboshaft::StoreStoreEliminationPhase>();
     }
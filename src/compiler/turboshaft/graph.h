@@ -353,6 +353,14 @@ class Block : public RandomAccessStackDominatorNode<Block> {
     next_graph_mapping_ = next_graph_block;
     next_graph_block->SetOrigin(this);
   }
+  // Temporarily redirects the mapping of a block that is already mapped, when
+  // it is emitted multiple times. Only for `GraphVisitor::CloneSubGraph`.
+  void RemapToNextGraph(Block* next_graph_block) {
+    DCHECK_NOT_NULL(next_graph_mapping_);
+    DCHECK_NOT_NULL(next_graph_block);
+    next_graph_mapping_ = next_graph_block;
+    next_graph_block->SetOrigin(this);
+  }
   Block* MapToNextGraph() const {
     DCHECK_NOT_NULL(next_graph_mapping_);
     return next_graph_mapping_;
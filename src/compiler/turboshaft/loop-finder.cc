@@ -0,0 +1,88 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/loop-finder.h"
+
+#include "src/base/iterator.h"
+#include "src/codegen/external-reference.h"
+#include "src/compiler/turboshaft/phase.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+void LoopFinder::Run() {
+  for (const Block* block : base::Reversed(input_graph_->blocks_vector())) {
+    if (block->IsLoop()) {
+      loop_header_info_.insert({block, VisitLoop(block)});
+    }
+  }
+}
+
+LoopFinder::LoopInfo LoopFinder::VisitLoop(const Block* header) {
+  const Block* backedge = header->LastPredecessor();
+  DCHECK_GE(backedge->index().id(), header->index().id());
+
+  LoopInfo info;
+  info.start = header;
+  info.end = backedge;
+
+  // Returns false if {block} was already visited for the current loop.
+  auto add_block = [&](const Block* block) {
+    if (visited_by_[block->index()] == header) return false;
+    visited_by_[block->index()] = header;
+    // Inner loops have already been visited, so a block that already has a
+    // loop header is in an inner loop.
+    if (loop_headers_[block->index()] == nullptr) {
+      loop_headers_[block->index()] = header;
+    }
+    if (block != header && block->IsLoop()) info.has_inner_loops = true;
+    info.block_count++;
+    info.op_count += OpCountUpperBound(block);
+    return true;
+  };
+
+  // The predecessors of the header are outside of the loop, except for the
+  // backedge, so the walk stops at the header.
+  add_block(header);
+  queue_.clear();
+  if (add_block(backedge)) queue_.push_back(backedge);
+  while (!queue_.empty()) {
+    const Block* curr = queue_.back();
+    queue_.pop_back();
+    for (const Block* pred = curr->LastPredecessor(); pred != nullptr;
+         pred = pred->NeighboringPredecessor()) {
+      if (add_block(pred)) queue_.push_back(pred);
+    }
+  }
+  return info;
+}
+
+LoopFinder::LoopBody LoopFinder::GetLoopBody(const Block* loop_header) {
+  DCHECK(!GetLoopInfo(loop_header).has_inner_loops);
+  LoopBody body(phase_zone_);
+  body.insert(loop_header);
+
+  queue_.clear();
+  queue_.push_back(loop_header->LastPredecessor());
+  while (!queue_.empty()) {
+    const Block* curr = queue_.back();
+    queue_.pop_back();
+    if (!body.insert(curr).second) continue;
+    for (const Block* pred = curr->LastPredecessor(); pred != nullptr;
+         pred = pred->NeighboringPredecessor()) {
+      queue_.push_back(pred);
+    }
+  }
+  return body;
+}
+
+bool IsLoopInterruptRequestLoad(const Graph& graph, const LoadOp& load) {
+  if (load.kind.tagged_base || load.index().valid()) return false;
+  const ConstantOp* base = graph.Get(load.base()).TryCast<ConstantOp>();
+  return base != nullptr && base->kind == ConstantOp::Kind::kExternal &&
+         base->external_reference() ==
+             ExternalReference::address_of_no_heap_write_interrupt_request(
+                 PipelineData::Get().isolate());
+}
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -0,0 +1,102 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_FINDER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_FINDER_H_
+
+#include "src/base/logging.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/sidetable.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// Computes the loops of a graph: the header of the innermost loop of each
+// block, and for each loop a few properties that loop transformations use in
+// their heuristics.
+//
+// Loops are found by walking backwards from the backedge of each loop header
+// until the header is reached. Headers are visited in decreasing block order,
+// which means that inner loops are visited before the loops that contain them.
+class V8_EXPORT_PRIVATE LoopFinder {
+ public:
+  struct LoopInfo {
+    const Block* start = nullptr;
+    // The block that ends with the backedge.
+    const Block* end = nullptr;
+    bool has_inner_loops = false;
+    size_t block_count = 0;
+    // An upper bound of the number of operations of the loop, including the
+    // operations of its inner loops.
+    size_t op_count = 0;
+  };
+
+  struct BlockCmp {
+    bool operator()(const Block* a, const Block* b) const {
+      return a->index() < b->index();
+    }
+  };
+  using LoopBody = ZoneSet<const Block*, BlockCmp>;
+
+  LoopFinder(Zone* phase_zone, const Graph* input_graph)
+      : phase_zone_(phase_zone),
+        input_graph_(input_graph),
+        loop_headers_(input_graph->block_count(), nullptr, phase_zone),
+        visited_by_(input_graph->block_count(), nullptr, phase_zone),
+        loop_header_info_(phase_zone),
+        queue_(phase_zone) {
+    Run();
+  }
+
+  const ZoneUnorderedMap<const Block*, LoopInfo>& LoopHeaders() const {
+    return loop_header_info_;
+  }
+
+  // Returns the header of the innermost loop that contains {block}, or nullptr
+  // if {block} is not in a loop. The header of a loop is part of the loop.
+  const Block* GetLoopHeader(const Block* block) const {
+    return loop_headers_[block->index()];
+  }
+
+  LoopInfo GetLoopInfo(const Block* loop_header) const {
+    DCHECK(loop_header->IsLoop());
+    auto it = loop_header_info_.find(loop_header);
+    DCHECK(it != loop_header_info_.end());
+    return it->second;
+  }
+
+  // Returns the blocks of the loop starting at {loop_header}, which must not
+  // have inner loops.
+  LoopBody GetLoopBody(const Block* loop_header);
+
+ private:
+  void Run();
+  LoopInfo VisitLoop(const Block* header);
+
+  static size_t OpCountUpperBound(const Block* block) {
+    return block->end().id() - block->begin().id();
+  }
+
+  Zone* phase_zone_;
+  const Graph* input_graph_;
+
+  // Header of the innermost loop of each block.
+  FixedBlockSidetable<const Block*> loop_headers_;
+  // Header of the last loop whose visit reached each block.
+  FixedBlockSidetable<const Block*> visited_by_;
+  ZoneUnorderedMap<const Block*, LoopInfo> loop_header_info_;
+  // Blocks that remain to be visited by {VisitLoop}.
+  ZoneVector<const Block*> queue_;
+};
+
+// Returns true if {load} reads the flag that the interrupt checks of JS loops
+// poll (see `JSGenericLowering::LowerJSStackCheck`).
+V8_EXPORT_PRIVATE bool IsLoopInterruptRequestLoad(const Graph& graph,
+                                                  const LoadOp& load);
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_FINDER_H_
@@ -0,0 +1,140 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_PEELING_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_PEELING_REDUCER_H_
+
+#include "src/base/logging.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#include "src/compiler/turboshaft/define-assembler-macros.inc"
+
+// LoopPeelingReducer emits the first iteration of innermost loops in front of
+// the loop:
+//
+//     Loop:                           Loop':
+//       x = Phi(x0, x1)                 ... x0 ...
+//       if (c) goto Exit                if (c) goto Exit
+//       x1 = ...                        x1' = ...
+//       goto Loop                       goto Loop
+//                           ======>   Loop:
+//                                       x = Phi(x1', x1)
+//                                       if (c) goto Exit
+//                                       x1 = ...
+//                                       goto Loop
+//
+// Checks and loads that are invariant in the loop are then dominated by the
+// ones of the peeled iteration, so that later phases can remove them from the
+// loop.
+//
+// The peeled iteration and the loop are both emitted with
+// `GraphVisitor::CloneSubGraph`, when visiting the forward edge to the loop
+// header. The backedge of the peeled iteration is skipped, and the Goto to the
+// loop that starts the second copy takes its place.
+template <class Next>
+class LoopPeelingReducer : public Next {
+ public:
+  TURBOSHAFT_REDUCER_BOILERPLATE()
+
+  OpIndex REDUCE_INPUT_GRAPH(Goto)(OpIndex ig_idx, const GotoOp& gto) {
+    LABEL_BLOCK(no_change) { return Next::ReduceInputGraphGoto(ig_idx, gto); }
+
+    const Block* dst = gto.destination;
+    if (!dst->IsLoop()) goto no_change;
+
+    if (IsBackedge(dst)) {
+      if (peeling_ == PeelingStatus::kEmittingPeeledIteration &&
+          dst == current_loop_header_) {
+        // The current block stays open. `PeelFirstIteration` continues it
+        // with a forward edge to the loop.
+        return OpIndex::Invalid();
+      }
+      goto no_change;
+    }
+
+    // Note that, unlike the backedge skipping above, the peeling itself is an
+    // optional step.
+    if (!CanPeelLoop(dst) || ShouldSkipOptimizationStep()) goto no_change;
+    PeelFirstIteration(dst);
+    return OpIndex::Invalid();
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(Phi)(OpIndex ig_idx, const PhiOp& phi) {
+    if (peeling_ != PeelingStatus::kEmittingLoop ||
+        Asm().current_input_block() != current_loop_header_) {
+      return Next::ReduceInputGraphPhi(ig_idx, phi);
+    }
+    OpIndex backedge_input = phi.input(PhiOp::kLoopPhiBackEdgeIndex);
+    if (backedge_input == ig_idx) {
+      // The Phi is loop invariant, and thus still equal to its first input.
+      return Next::ReduceInputGraphPhi(ig_idx, phi);
+    }
+    // The first input of the Phis of the loop is the value on the backedge of
+    // the peeled iteration.
+    return Asm().PendingLoopPhi(Asm().MapToNewGraph(backedge_input), phi.rep,
+                                backedge_input);
+  }
+
+ private:
+  // Loops bigger than this are not peeled, since peeling doubles their size.
+  static constexpr size_t kMaxSizeForPeeling = 1000;
+
+  enum class PeelingStatus {
+    kNotPeeling,
+    kEmittingPeeledIteration,
+    kEmittingLoop
+  };
+
+  bool IsBackedge(const Block* loop_header) {
+    return Asm().current_input_block()->index() >= loop_header->index();
+  }
+
+  bool CanPeelLoop(const Block* loop_header) {
+    if (peeling_ != PeelingStatus::kNotPeeling) return false;
+    LoopFinder::LoopInfo info = loop_finder_.GetLoopInfo(loop_header);
+    return !info.has_inner_loops && info.op_count < kMaxSizeForPeeling &&
+           info.end != loop_header;
+  }
+
+  void PeelFirstIteration(const Block* loop_header) {
+    DCHECK_EQ(peeling_, PeelingStatus::kNotPeeling);
+    ScopedModification<PeelingStatus> scope(
+        &peeling_, PeelingStatus::kEmittingPeeledIteration);
+    current_loop_header_ = loop_header;
+
+    LoopFinder::LoopBody loop_body = loop_finder_.GetLoopBody(loop_header);
+    // Every block of the loop reaches the backedge without going through the
+    // header, so the backedge is the last block that `CloneSubGraph` visits,
+    // and the current block is the end of the peeled iteration afterwards.
+    DCHECK_EQ(*loop_body.rbegin(), loop_header->LastPredecessor());
+    Block* peeled_header =
+        Asm().CloneSubGraph(loop_body, /* keep_loop_kinds */ true);
+    if (Asm().current_block() == nullptr) {
+      // The end of the peeled iteration is unreachable, and so is the loop.
+      // `CloneSubGraph` already turned the peeled header into a merge.
+      return;
+    }
+    // The backedge of the peeled iteration was skipped.
+    Asm().FinalizeLoop(peeled_header);
+
+    peeling_ = PeelingStatus::kEmittingLoop;
+    Asm().CloneSubGraph(loop_body, /* keep_loop_kinds */ true);
+  }
+
+  PeelingStatus peeling_ = PeelingStatus::kNotPeeling;
+  const Block* current_loop_header_ = nullptr;
+  LoopFinder loop_finder_{Asm().phase_zone(), &Asm().modifiable_input_graph()};
+};
+
+#include "src/compiler/turboshaft/undef-assembler-macros.inc"
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_PEELING_REDUCER_H_
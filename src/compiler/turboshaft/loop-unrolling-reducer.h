@@ -0,0 +1,158 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_UNROLLING_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_UNROLLING_REDUCER_H_
+
+#include <algorithm>
+
+#include "src/base/logging.h"
+#include "src/compiler/globals.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#include "src/compiler/turboshaft/define-assembler-macros.inc"
+
+// LoopUnrollingReducer partially unrolls small innermost loops: the body of
+// the loop is emitted {unroll_count} times before the backedge. Each copy
+// keeps the exit condition of the loop, so that this is valid regardless of
+// the trip count:
+//
+//     Loop:                           Loop:
+//       x = Phi(x0, x1)                 x = Phi(x0, x1'')
+//       if (c(x)) goto Exit             if (c(x)) goto Exit
+//       x1 = f(x)                       x1 = f(x)
+//       goto Loop          ======>      if (c(x1)) goto Exit
+//                                       x1'' = f(x1)
+//                                       goto Loop
+//
+// This removes backedges and loop interrupt checks, and exposes the operations
+// of consecutive iterations to value numbering and machine optimizations.
+//
+// Like LoopPeelingReducer, the copies are emitted with
+// `GraphVisitor::CloneSubGraph` when visiting the forward edge to the loop.
+// Only the first copy keeps a loop header. The headers of the following
+// copies are merges with a single predecessor, in which the loop Phis are
+// replaced by the value of their backedge input in the previous copy.
+template <class Next>
+class LoopUnrollingReducer : public Next {
+ public:
+  TURBOSHAFT_REDUCER_BOILERPLATE()
+
+  OpIndex REDUCE_INPUT_GRAPH(Goto)(OpIndex ig_idx, const GotoOp& gto) {
+    LABEL_BLOCK(no_change) { return Next::ReduceInputGraphGoto(ig_idx, gto); }
+
+    const Block* dst = gto.destination;
+    if (!dst->IsLoop()) goto no_change;
+
+    if (IsBackedge(dst)) {
+      if (unrolling_ != UnrollingStatus::kNotUnrolling &&
+          dst == current_loop_header_) {
+        // The current block stays open. `PartiallyUnrollLoop` continues it
+        // with the next copy of the body, or with the backedge.
+        return OpIndex::Invalid();
+      }
+      goto no_change;
+    }
+
+    int unroll_count = GetUnrollCount(dst);
+    if (unroll_count < 2 || ShouldSkipOptimizationStep()) goto no_change;
+    PartiallyUnrollLoop(dst, unroll_count);
+    return OpIndex::Invalid();
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(Phi)(OpIndex ig_idx, const PhiOp& phi) {
+    if (unrolling_ != UnrollingStatus::kEmittingFoldedIteration ||
+        Asm().current_input_block() != current_loop_header_) {
+      return Next::ReduceInputGraphPhi(ig_idx, phi);
+    }
+    return Asm().MapToNewGraph(phi.input(PhiOp::kLoopPhiBackEdgeIndex));
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(Load)(OpIndex ig_idx, const LoadOp& load) {
+    if (unrolling_ == UnrollingStatus::kEmittingFoldedIteration &&
+        IsLoopInterruptRequestLoad(Asm().input_graph(), load)) {
+      // The interrupt check of the first copy is enough to handle interrupts
+      // in the unrolled loop. Reading the flag as unset folds away the check
+      // of this copy and its runtime call.
+      return Asm().Word32Constant(0);
+    }
+    return Next::ReduceInputGraphLoad(ig_idx, load);
+  }
+
+ private:
+  // Only loops up to this size are unrolled.
+  static constexpr size_t kMaxLoopSizeForUnrolling = 50;
+  // Loops are unrolled at most this many times, and less if the unrolled loop
+  // would be bigger than {kMaxUnrolledLoopSize}.
+  static constexpr size_t kMaxUnrollCount = 4;
+  static constexpr size_t kMaxUnrolledLoopSize = 160;
+
+  enum class UnrollingStatus {
+    kNotUnrolling,
+    kEmittingFirstIteration,
+    kEmittingFoldedIteration
+  };
+
+  bool IsBackedge(const Block* loop_header) {
+    return Asm().current_input_block()->index() >= loop_header->index();
+  }
+
+  int GetUnrollCount(const Block* loop_header) {
+    if (unrolling_ != UnrollingStatus::kNotUnrolling) return 0;
+    LoopFinder::LoopInfo info = loop_finder_.GetLoopInfo(loop_header);
+    if (info.has_inner_loops || info.end == loop_header ||
+        info.op_count == 0 || info.op_count > kMaxLoopSizeForUnrolling) {
+      return 0;
+    }
+    return static_cast<int>(
+        std::min(kMaxUnrollCount, kMaxUnrolledLoopSize / info.op_count));
+  }
+
+  void PartiallyUnrollLoop(const Block* loop_header, int unroll_count) {
+    DCHECK_EQ(unrolling_, UnrollingStatus::kNotUnrolling);
+    ScopedModification<UnrollingStatus> scope(
+        &unrolling_, UnrollingStatus::kEmittingFirstIteration);
+    current_loop_header_ = loop_header;
+
+    LoopFinder::LoopBody loop_body = loop_finder_.GetLoopBody(loop_header);
+    // The backedge is the last block that `CloneSubGraph` visits, so the
+    // current block is the end of the copy afterwards (see
+    // LoopPeelingReducer).
+    DCHECK_EQ(*loop_body.rbegin(), loop_header->LastPredecessor());
+    Block* output_loop_header =
+        Asm().CloneSubGraph(loop_body, /* keep_loop_kinds */ true);
+    if (Asm().current_block() == nullptr) {
+      // The loop has no backedge anymore, and its header has already been
+      // turned into a merge.
+      return;
+    }
+
+    unrolling_ = UnrollingStatus::kEmittingFoldedIteration;
+    for (int i = 1; i < unroll_count; i++) {
+      Asm().CloneSubGraph(loop_body, /* keep_loop_kinds */ false);
+      if (Asm().current_block() == nullptr) {
+        // The end of this copy is unreachable, so the loop has no backedge.
+        Asm().FinalizeLoop(output_loop_header);
+        return;
+      }
+    }
+    Asm().EmitLoopBackedge(output_loop_header);
+  }
+
+  UnrollingStatus unrolling_ = UnrollingStatus::kNotUnrolling;
+  const Block* current_loop_header_ = nullptr;
+  LoopFinder loop_finder_{Asm().phase_zone(), &Asm().modifiable_input_graph()};
+};
+
+#include "src/compiler/turboshaft/undef-assembler-macros.inc"
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_UNROLLING_REDUCER_H_
@@ -0,0 +1,625 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/loop-vectorization-reducer.h"
+
+#include "src/flags/flags.h"
+#include "src/utils/utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#define TRACE(...)                                      \
+  do {                                                  \
+    if (v8_flags.turboshaft_trace_loop_vectorization) { \
+      PrintF(__VA_ARGS__);                              \
+    }                                                   \
+  } while (false)
+
+namespace {
+
+LoopVectorizationAnalyzer::LaneType GetLaneType(MemoryRepresentation rep) {
+  using LaneType = LoopVectorizationAnalyzer::LaneType;
+  if (rep == MemoryRepresentation::Int8() ||
+      rep == MemoryRepresentation::Uint8()) {
+    return LaneType::kInt8;
+  }
+  if (rep == MemoryRepresentation::Int16() ||
+      rep == MemoryRepresentation::Uint16()) {
+    return LaneType::kInt16;
+  }
+  if (rep == MemoryRepresentation::Int32() ||
+      rep == MemoryRepresentation::Uint32()) {
+    return LaneType::kInt32;
+  }
+  if (rep == MemoryRepresentation::Float32()) return LaneType::kFloat32;
+  if (rep == MemoryRepresentation::Float64()) return LaneType::kFloat64;
+  return LaneType::kNone;
+}
+
+bool IsFloatLaneType(LoopVectorizationAnalyzer::LaneType lane_type) {
+  return lane_type == LoopVectorizationAnalyzer::LaneType::kFloat32 ||
+         lane_type == LoopVectorizationAnalyzer::LaneType::kFloat64;
+}
+
+// Operations that are emitted in front of the vector loop if their inputs are
+// loop invariant. They cannot fail and don't depend on the checks of the loop.
+bool CanBeHoisted(const Operation& op) {
+  switch (op.opcode) {
+    case Opcode::kConstant:
+    case Opcode::kShift:
+    case Opcode::kComparison:
+    case Opcode::kEqual:
+    case Opcode::kChange:
+    case Opcode::kTaggedBitcast:
+      return true;
+    case Opcode::kWordBinop:
+      switch (op.Cast<WordBinopOp>().kind) {
+        case WordBinopOp::Kind::kSignedDiv:
+        case WordBinopOp::Kind::kUnsignedDiv:
+        case WordBinopOp::Kind::kSignedMod:
+        case WordBinopOp::Kind::kUnsignedMod:
+          return false;
+        default:
+          return true;
+      }
+    case Opcode::kFloatBinop:
+      switch (op.Cast<FloatBinopOp>().kind) {
+        case FloatBinopOp::Kind::kAdd:
+        case FloatBinopOp::Kind::kSub:
+        case FloatBinopOp::Kind::kMul:
+        case FloatBinopOp::Kind::kDiv:
+        case FloatBinopOp::Kind::kMin:
+        case FloatBinopOp::Kind::kMax:
+          return true;
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
+}
+
+// Returns true if {op} is a Float64 constant whose value is a Float32.
+bool IsFloat32Constant(const Operation& op) {
+  const ConstantOp* constant = op.TryCast<ConstantOp>();
+  if (constant == nullptr || constant->kind != ConstantOp::Kind::kFloat64) {
+    return false;
+  }
+  double value = constant->float64();
+  return static_cast<double>(static_cast<float>(value)) == value;
+}
+
+}  // namespace
+
+// static
+int LoopVectorizationAnalyzer::LaneSizeLog2(LaneType lane_type) {
+  switch (lane_type) {
+    case LaneType::kInt8:
+      return 0;
+    case LaneType::kInt16:
+      return 1;
+    case LaneType::kInt32:
+    case LaneType::kFloat32:
+      return 2;
+    case LaneType::kFloat64:
+      return 3;
+    case LaneType::kNone:
+      UNREACHABLE();
+  }
+}
+
+// static
+base::Optional<Simd128BinopOp::Kind>
+LoopVectorizationAnalyzer::GetSimd128BinopKind(LaneType lane_type,
+                                               const Operation& op) {
+  using Kind = Simd128BinopOp::Kind;
+  if (lane_type == LaneType::kNone) return {};
+  if (const WordBinopOp* binop = op.TryCast<WordBinopOp>()) {
+    if (IsFloatLaneType(lane_type) ||
+        binop->rep != WordRepresentation::Word32()) {
+      return {};
+    }
+    switch (binop->kind) {
+      case WordBinopOp::Kind::kAdd:
+        return lane_type == LaneType::kInt8    ? Kind::kI8x16Add
+               : lane_type == LaneType::kInt16 ? Kind::kI16x8Add
+                                               : Kind::kI32x4Add;
+      case WordBinopOp::Kind::kSub:
+        return lane_type == LaneType::kInt8    ? Kind::kI8x16Sub
+               : lane_type == LaneType::kInt16 ? Kind::kI16x8Sub
+                                               : Kind::kI32x4Sub;
+      case WordBinopOp::Kind::kMul:
+        if (lane_type == LaneType::kInt8) return {};
+        return lane_type == LaneType::kInt16 ? Kind::kI16x8Mul
+                                             : Kind::kI32x4Mul;
+      case WordBinopOp::Kind::kBitwiseAnd:
+        return Kind::kS128And;
+      case WordBinopOp::Kind::kBitwiseOr:
+        return Kind::kS128Or;
+      case WordBinopOp::Kind::kBitwiseXor:
+        return Kind::kS128Xor;
+      default:
+        return {};
+    }
+  }
+  if (const FloatBinopOp* binop = op.TryCast<FloatBinopOp>()) {
+    if (!IsFloatLaneType(lane_type)) return {};
+    // Float64 operations on Float32 lanes are widened operations.
+    bool f32 = lane_type == LaneType::kFloat32;
+    switch (binop->kind) {
+      case FloatBinopOp::Kind::kAdd:
+        return f32 ? Kind::kF32x4Add : Kind::kF64x2Add;
+      case FloatBinopOp::Kind::kSub:
+        return f32 ? Kind::kF32x4Sub : Kind::kF64x2Sub;
+      case FloatBinopOp::Kind::kMul:
+        return f32 ? Kind::kF32x4Mul : Kind::kF64x2Mul;
+      case FloatBinopOp::Kind::kDiv:
+        return f32 ? Kind::kF32x4Div : Kind::kF64x2Div;
+      default:
+        return {};
+    }
+  }
+  return {};
+}
+
+void LoopVectorizationAnalyzer::Run() {
+  for (const auto& [header, info] : loop_finder_.LoopHeaders()) {
+    if (info.has_inner_loops) continue;
+    if (info.op_count > kMaxLoopSize) {
+      Reject(header, "too many operations");
+      continue;
+    }
+    VectorizableLoop loop(phase_zone_);
+    if (AnalyzeLoop(header, &loop)) {
+      TRACE("Vectorizing loop B%d (%d lanes)\n", header->index().id(),
+            LaneCount(loop.lane_type));
+      loops_.emplace(header, std::move(loop));
+    }
+  }
+}
+
+bool LoopVectorizationAnalyzer::Reject(const Block* header,
+                                       const char* reason) const {
+  TRACE("Not vectorizing loop B%d: %s\n", header->index().id(), reason);
+  return false;
+}
+
+bool LoopVectorizationAnalyzer::AnalyzeLoop(const Block* header,
+                                            VectorizableLoop* loop) {
+  current_header_ = header;
+  exit_successor_ = nullptr;
+  slow_path_ = nullptr;
+  exit_condition_ = OpIndex::Invalid();
+  interrupt_condition_ = OpIndex::Invalid();
+  checked_increment_ = OpIndex::Invalid();
+  induction_variable_ = OpIndex::Invalid();
+
+  if (header->PredecessorCount() != 2) {
+    return Reject(header, "unexpected predecessors");
+  }
+  if (!AnalyzeControlFlow(header, loop)) return false;
+
+  // The induction variable, which must be the only Phi of the loop.
+  for (OpIndex index : graph_.OperationIndices(*header)) {
+    const PhiOp* phi = graph_.Get(index).TryCast<PhiOp>();
+    if (phi == nullptr) continue;
+    if (loop->induction_variable.valid()) {
+      return Reject(header, "more than one Phi");
+    }
+    if (phi->rep != RegisterRepresentation::Word32() &&
+        phi->rep != RegisterRepresentation::WordPtr()) {
+      return Reject(header, "unexpected induction variable");
+    }
+    loop->induction_variable = index;
+    induction_variable_ = index;
+    loop->induction_rep = WordRepresentation(phi->rep);
+    loop->start = phi->input(0);
+    roles_[index] = OpRole::kInductionVariable;
+  }
+  if (!loop->induction_variable.valid()) {
+    return Reject(header, "no induction variable");
+  }
+  OpIndex increment = graph_.Get(loop->induction_variable)
+                          .input(PhiOp::kLoopPhiBackEdgeIndex);
+  if (!IsIncrement(graph_.Get(increment))) {
+    return Reject(header, "unexpected induction variable");
+  }
+
+  size_t memory_access_count = 0;
+  for (const Block* block : loop->blocks) {
+    for (OpIndex index : graph_.OperationIndices(*block)) {
+      const Operation& op = graph_.Get(index);
+      if (op.Is<PhiOp>()) {
+        if (block != header) return Reject(header, "unexpected Phi");
+        continue;
+      }
+      base::Optional<OpRole> role = GetOpRole(index, op, loop);
+      if (!role.has_value()) {
+        TRACE("Not vectorizing loop B%d: unsupported operation #%d (%s)\n",
+              header->index().id(), index.id(), OpcodeName(op.opcode));
+        return false;
+      }
+      if (index == increment && *role != OpRole::kIncrement) {
+        return Reject(header, "unexpected induction variable");
+      }
+      switch (*role) {
+        case OpRole::kLane:
+        case OpRole::kWidenedResult:
+        case OpRole::kStore:
+          // These have to be emitted after the exit check of each iteration.
+          if (!block->IsDominatedBy(exit_successor_)) {
+            return Reject(header, "operation before the exit check");
+          }
+          break;
+        default:
+          break;
+      }
+      if (op.Is<LoadOp>() && *role == OpRole::kLane) {
+        memory_access_count++;
+        loop->load_bases.push_back(op.Cast<LoadOp>().base());
+      } else if (*role == OpRole::kStore) {
+        memory_access_count++;
+        loop->store_bases.push_back(op.Cast<StoreOp>().base());
+      }
+      roles_[index] = *role;
+    }
+  }
+
+  if (!loop->end.valid()) return Reject(header, "unexpected exit condition");
+  if (loop->store_bases.empty()) return Reject(header, "no stores");
+  if (memory_access_count > kMaxMemoryAccesses) {
+    return Reject(header, "too many memory accesses");
+  }
+  return true;
+}
+
+// Only the exit check and the interrupt check can branch, so that all the
+// blocks of an iteration that doesn't exit or handle an interrupt are executed.
+bool LoopVectorizationAnalyzer::AnalyzeControlFlow(const Block* header,
+                                                   VectorizableLoop* loop) {
+  LoopFinder::LoopBody body = loop_finder_.GetLoopBody(header);
+  for (const Block* block : body) {
+    const Operation& last = block->LastOperation(graph_);
+    if (last.Is<GotoOp>()) continue;
+    const BranchOp* branch = last.TryCast<BranchOp>();
+    if (branch == nullptr) return Reject(header, "unsupported control flow");
+    bool true_in_loop = body.count(branch->if_true) != 0;
+    bool false_in_loop = body.count(branch->if_false) != 0;
+    if (true_in_loop && !false_in_loop) {
+      if (exit_successor_ != nullptr) {
+        return Reject(header, "more than one exit");
+      }
+      exit_successor_ = branch->if_true;
+      exit_condition_ = branch->condition();
+    } else if (!true_in_loop || slow_path_ != nullptr ||
+               !IsInterruptCheck(*branch, &slow_path_)) {
+      return Reject(header, "unsupported control flow");
+    } else {
+      interrupt_condition_ = branch->condition();
+      loop->interrupt_request = interrupt_condition_;
+      if (const EqualOp* equal =
+              graph_.Get(interrupt_condition_).TryCast<EqualOp>()) {
+        loop->interrupt_request = equal->left();
+      }
+    }
+  }
+  if (exit_successor_ == nullptr) return Reject(header, "no exit");
+
+  for (const Block* block : body) {
+    if (block != slow_path_) loop->blocks.push_back(block);
+  }
+  return true;
+}
+
+// The interrupt check of JS loops (see `JSGenericLowering::LowerJSStackCheck`)
+// calls the runtime in a separate block if an interrupt is requested, and
+// continues with the loop afterwards.
+bool LoopVectorizationAnalyzer::IsInterruptCheck(
+    const BranchOp& branch, const Block** slow_path) const {
+  const Operation& condition = graph_.Get(branch.condition());
+  if (const LoadOp* load = condition.TryCast<LoadOp>()) {
+    if (!IsLoopInterruptRequestLoad(graph_, *load)) return false;
+    *slow_path = branch.if_true;
+  } else if (const EqualOp* equal = condition.TryCast<EqualOp>()) {
+    const LoadOp* load = graph_.Get(equal->left()).TryCast<LoadOp>();
+    const ConstantOp* zero =
+        graph_.Get(equal->right()).TryCast<ConstantOp>();
+    if (load == nullptr || !IsLoopInterruptRequestLoad(graph_, *load) ||
+        zero == nullptr || zero->kind != ConstantOp::Kind::kWord32 ||
+        zero->word32() != 0) {
+      return false;
+    }
+    *slow_path = branch.if_false;
+  } else {
+    return false;
+  }
+  if ((*slow_path)->PredecessorCount() != 1) return false;
+  const GotoOp* gto = (*slow_path)->LastOperation(graph_).TryCast<GotoOp>();
+  return gto != nullptr && gto->destination != current_header_;
+}
+
+bool LoopVectorizationAnalyzer::IsIncrement(const Operation& op) {
+  auto is_increment_of_induction_variable = [&](OpIndex left, OpIndex right) {
+    const ConstantOp* one = graph_.Get(right).TryCast<ConstantOp>();
+    return left == induction_variable_ && one != nullptr &&
+           (one->kind == ConstantOp::Kind::kWord32 ||
+            one->kind == ConstantOp::Kind::kWord64) &&
+           one->integral() == 1;
+  };
+  if (const WordBinopOp* binop = op.TryCast<WordBinopOp>()) {
+    return binop->kind == WordBinopOp::Kind::kAdd &&
+           is_increment_of_induction_variable(binop->left(), binop->right());
+  }
+  if (const ProjectionOp* projection = op.TryCast<ProjectionOp>()) {
+    const OverflowCheckedBinopOp* binop =
+        graph_.Get(projection->input()).TryCast<OverflowCheckedBinopOp>();
+    if (projection->index != 0 || binop == nullptr ||
+        binop->kind != OverflowCheckedBinopOp::Kind::kSignedAdd ||
+        !is_increment_of_induction_variable(binop->left(), binop->right())) {
+      return false;
+    }
+    checked_increment_ = projection->input();
+    return true;
+  }
+  return false;
+}
+
+base::Optional<LoopVectorizationAnalyzer::OpRole>
+LoopVectorizationAnalyzer::GetOpRole(OpIndex index, const Operation& op,
+                                     VectorizableLoop* loop) {
+  if (CanBeHoisted(op)) {
+    bool is_invariant = true;
+    for (OpIndex input : op.inputs()) {
+      if (!IsInvariant(input)) {
+        is_invariant = false;
+        break;
+      }
+    }
+    if (is_invariant) return OpRole::kInvariant;
+  }
+
+  switch (op.opcode) {
+    case Opcode::kGoto:
+    case Opcode::kBranch:
+    case Opcode::kFrameState:
+      return OpRole::kNone;
+
+    case Opcode::kRetain:
+      if (!IsInvariant(op.Cast<RetainOp>().retained())) return {};
+      return OpRole::kRetain;
+
+    case Opcode::kWordBinop:
+      if (IsIncrement(op)) return OpRole::kIncrement;
+      if (!GetSimd128BinopKind(loop->lane_type, op).has_value() ||
+          !IsLaneOperand(op.input(0), loop->lane_type, OpRole::kLane) ||
+          !IsLaneOperand(op.input(1), loop->lane_type, OpRole::kLane)) {
+        return {};
+      }
+      return OpRole::kLane;
+
+    case Opcode::kOverflowCheckedBinop:
+      if (index != checked_increment_) return {};
+      return OpRole::kNone;
+
+    case Opcode::kProjection: {
+      const ProjectionOp& projection = op.Cast<ProjectionOp>();
+      if (projection.input() != checked_increment_) return {};
+      // The overflow bit. The increment itself is checked below.
+      if (projection.index == 1) return OpRole::kNone;
+      if (!IsIncrement(op)) return {};
+      return OpRole::kIncrement;
+    }
+
+    case Opcode::kFloatBinop: {
+      const FloatBinopOp& binop = op.Cast<FloatBinopOp>();
+      if (!GetSimd128BinopKind(loop->lane_type, op).has_value()) return {};
+      if (loop->lane_type == LaneType::kFloat32 &&
+          binop.rep == FloatRepresentation::Float64()) {
+        if (!IsLaneOperand(binop.left(), loop->lane_type,
+                           OpRole::kWidenedLane) ||
+            !IsLaneOperand(binop.right(), loop->lane_type,
+                           OpRole::kWidenedLane)) {
+          return {};
+        }
+        return OpRole::kWidenedResult;
+      }
+      if (binop.rep != (loop->lane_type == LaneType::kFloat32
+                            ? FloatRepresentation::Float32()
+                            : FloatRepresentation::Float64()) ||
+          !IsLaneOperand(binop.left(), loop->lane_type, OpRole::kLane) ||
+          !IsLaneOperand(binop.right(), loop->lane_type, OpRole::kLane)) {
+        return {};
+      }
+      return OpRole::kLane;
+    }
+
+    case Opcode::kChange: {
+      const ChangeOp& change = op.Cast<ChangeOp>();
+      OpRole input_role = GetLoopRole(change.input());
+      if (input_role == OpRole::kInductionVariable &&
+          (change.kind == ChangeOp::Kind::kZeroExtend ||
+           change.kind == ChangeOp::Kind::kSignExtend) &&
+          change.from == RegisterRepresentation::Word32() &&
+          change.to == RegisterRepresentation::WordPtr()) {
+        return OpRole::kIndex;
+      }
+      if (change.kind != ChangeOp::Kind::kFloatConversion ||
+          loop->lane_type != LaneType::kFloat32) {
+        return {};
+      }
+      if (change.from == RegisterRepresentation::Float32() &&
+          input_role == OpRole::kLane) {
+        return OpRole::kWidenedLane;
+      }
+      if (change.to == RegisterRepresentation::Float32() &&
+          (input_role == OpRole::kWidenedResult ||
+           input_role == OpRole::kWidenedLane)) {
+        // Double rounding is innocuous for a single operation, so that this
+        // is the rounded result of the operation on Float32 values.
+        return OpRole::kLane;
+      }
+      return {};
+    }
+
+    case Opcode::kComparison: {
+      if (index == exit_condition_) {
+        const ComparisonOp& comparison = op.Cast<ComparisonOp>();
+        if ((comparison.kind != ComparisonOp::Kind::kSignedLessThan &&
+             comparison.kind != ComparisonOp::Kind::kUnsignedLessThan) ||
+            !(comparison.left() == induction_variable_ ||
+              IsIndex(comparison.left())) ||
+            !IsInvariant(comparison.right())) {
+          return {};
+        }
+        loop->end = comparison.right();
+        loop->end_rep = WordRepresentation(comparison.rep);
+        return OpRole::kNone;
+      }
+      BoundsCheck check;
+      if (!IsBoundsCheck(index, &check)) return {};
+      // Recorded with its DeoptimizeIf.
+      return OpRole::kNone;
+    }
+
+    case Opcode::kEqual:
+      if (index != interrupt_condition_) return {};
+      return OpRole::kNone;
+
+    case Opcode::kDeoptimizeIf: {
+      const DeoptimizeIfOp& deoptimize_if = op.Cast<DeoptimizeIfOp>();
+      BoundsCheck check;
+      if (deoptimize_if.negated &&
+          IsBoundsCheck(deoptimize_if.condition(), &check)) {
+        loop->bounds_checks.push_back(check);
+        return OpRole::kNone;
+      }
+      // The increment cannot overflow, since it is at most {end}.
+      const ProjectionOp* overflow =
+          graph_.Get(deoptimize_if.condition()).TryCast<ProjectionOp>();
+      if (!deoptimize_if.negated && overflow != nullptr &&
+          overflow->index == 1 && overflow->input() == checked_increment_) {
+        return OpRole::kNone;
+      }
+      return {};
+    }
+
+    case Opcode::kLoad: {
+      const LoadOp& load = op.Cast<LoadOp>();
+      if (index == loop->interrupt_request) return OpRole::kInterruptRequest;
+      if (!IsLaneAccess(load.base(), load.index(), load.kind, load.loaded_rep,
+                        load.offset, load.element_size_log2, loop)) {
+        return {};
+      }
+      if (load.result_rep != (IsFloatLaneType(loop->lane_type)
+                                  ? load.loaded_rep.ToRegisterRepresentation()
+                                  : RegisterRepresentation::Word32())) {
+        return {};
+      }
+      return OpRole::kLane;
+    }
+
+    case Opcode::kStore: {
+      const StoreOp& store = op.Cast<StoreOp>();
+      if (store.write_barrier != WriteBarrierKind::kNoWriteBarrier ||
+          !IsLaneAccess(store.base(), store.index(), store.kind,
+                        store.stored_rep, store.offset,
+                        store.element_size_log2, loop) ||
+          !IsLaneOperand(store.value(), loop->lane_type, OpRole::kLane)) {
+        return {};
+      }
+      return OpRole::kStore;
+    }
+
+    default:
+      return {};
+  }
+}
+
+bool LoopVectorizationAnalyzer::IsInLoop(OpIndex index) const {
+  return loop_finder_.GetLoopHeader(&graph_.Get(graph_.BlockOf(index))) ==
+         current_header_;
+}
+
+bool LoopVectorizationAnalyzer::IsInvariant(OpIndex index) const {
+  return !IsInLoop(index) || roles_[index] == OpRole::kInvariant;
+}
+
+// {roles_} also contains the roles of the operations of the loops that were
+// analyzed before, which don't matter for the current loop.
+LoopVectorizationAnalyzer::OpRole LoopVectorizationAnalyzer::GetLoopRole(
+    OpIndex index) const {
+  return IsInLoop(index) ? roles_[index] : OpRole::kNone;
+}
+
+bool LoopVectorizationAnalyzer::IsIndex(OpIndex index) const {
+  if (GetLoopRole(index) == OpRole::kIndex) return true;
+  return index == induction_variable_ &&
+         graph_.Get(index).Cast<PhiOp>().rep ==
+             RegisterRepresentation::WordPtr();
+}
+
+// Lane operands are lane values or constants, which are splatted.
+bool LoopVectorizationAnalyzer::IsLaneOperand(OpIndex index,
+                                              LaneType lane_type,
+                                              OpRole role) const {
+  const Operation& op = graph_.Get(index);
+  if (const ConstantOp* constant = op.TryCast<ConstantOp>()) {
+    switch (lane_type) {
+      case LaneType::kInt8:
+      case LaneType::kInt16:
+      case LaneType::kInt32:
+        return constant->kind == ConstantOp::Kind::kWord32;
+      case LaneType::kFloat32:
+        if (role == OpRole::kWidenedLane) return IsFloat32Constant(op);
+        return constant->kind == ConstantOp::Kind::kFloat32;
+      case LaneType::kFloat64:
+        return constant->kind == ConstantOp::Kind::kFloat64;
+      case LaneType::kNone:
+        return false;
+    }
+  }
+  return GetLoopRole(index) == role;
+}
+
+// Lane accesses are untagged accesses of element {i} of a loop invariant base,
+// whose elements all have the same size.
+bool LoopVectorizationAnalyzer::IsLaneAccess(OpIndex base, OpIndex index,
+                                             LoadOp::Kind kind,
+                                             MemoryRepresentation rep,
+                                             int32_t offset,
+                                             uint8_t element_size_log2,
+                                             VectorizableLoop* loop) const {
+  if (kind.tagged_base || kind.with_trap_handler || offset != 0 ||
+      !index.valid() || !IsIndex(index) || !IsInvariant(base) ||
+      element_size_log2 != rep.SizeInBytesLog2()) {
+    return false;
+  }
+  LaneType lane_type = GetLaneType(rep);
+  if (lane_type == LaneType::kNone) return false;
+  if (loop->lane_type == LaneType::kNone) {
+    loop->lane_type = lane_type;
+    return true;
+  }
+  return loop->lane_type == lane_type;
+}
+
+bool LoopVectorizationAnalyzer::IsBoundsCheck(OpIndex condition,
+                                              BoundsCheck* check) const {
+  const ComparisonOp* comparison =
+      graph_.Get(condition).TryCast<ComparisonOp>();
+  if (comparison == nullptr ||
+      comparison->kind != ComparisonOp::Kind::kUnsignedLessThan ||
+      !(comparison->left() == induction_variable_ ||
+        IsIndex(comparison->left())) ||
+      !IsInvariant(comparison->right())) {
+    return false;
+  }
+  check->limit = comparison->right();
+  check->rep = WordRepresentation(comparison->rep);
+  return true;
+}
+
+#undef TRACE
+
+}  // namespace v8::internal::compiler::turboshaft
@@ -0,0 +1,529 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOOP_VECTORIZATION_REDUCER_H_
+#define V8_COMPILER_TURBOSHAFT_LOOP_VECTORIZATION_REDUCER_H_
+
+#include "src/base/logging.h"
+#include "src/base/optional.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/index.h"
+#include "src/compiler/turboshaft/loop-finder.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/representations.h"
+#include "src/compiler/turboshaft/sidetable.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+#include "src/compiler/turboshaft/define-assembler-macros.inc"
+
+// Finds the innermost loops that LoopVectorizationReducer can vectorize, which
+// are loops of the form
+//
+//     for (let i = start; i < end; i++) {
+//       out[i] = f(a[i], b[i], ...);
+//     }
+//
+// where `a`, `b` and `out` are typed arrays whose elements have the same size,
+// and `f` only consists of arithmetic operations that have a Simd128
+// equivalent. Besides these, the loop can only contain the interrupt check of
+// JS loops, bounds checks of `i` against loop invariant limits, and loop
+// invariant computations such as the data pointers of the typed arrays.
+class V8_EXPORT_PRIVATE LoopVectorizationAnalyzer {
+ public:
+  // Integer lanes don't have a signedness: the loop can only contain integer
+  // operations whose result on the bits of a lane only depends on the bits of
+  // this lane in their inputs.
+  enum class LaneType : uint8_t {
+    kNone,
+    kInt8,
+    kInt16,
+    kInt32,
+    kFloat32,
+    kFloat64
+  };
+
+  // How an operation of a vectorizable loop is emitted in the vector loop.
+  enum class OpRole : uint8_t {
+    // Not emitted. This includes the operations that only matter for the
+    // scalar loop: its exit condition, bounds and overflow checks, frame
+    // states, and the slow path of the interrupt check.
+    kNone,
+    // Pure and loop invariant. Emitted once in front of the vector loop.
+    kInvariant,
+    kInductionVariable,
+    // The induction variable plus 1.
+    kIncrement,
+    // The induction variable, extended to pointer size.
+    kIndex,
+    // The load of the flag that the interrupt check polls.
+    kInterruptRequest,
+    // A lane value, which becomes a Simd128 value.
+    kLane,
+    // A Float32 lane value converted to Float64.
+    kWidenedLane,
+    // The Float64 result of an operation on widened lanes, which is then
+    // rounded to Float32. Float64 has more than twice the precision of
+    // Float32, so this is the result of the Float32 operation.
+    kWidenedResult,
+    kStore,
+    kRetain
+  };
+
+  struct BoundsCheck {
+    OpIndex limit;
+    // The representation in which the index is compared with {limit}.
+    WordRepresentation rep;
+  };
+
+  struct VectorizableLoop {
+    explicit VectorizableLoop(Zone* zone)
+        : bounds_checks(zone),
+          load_bases(zone),
+          store_bases(zone),
+          blocks(zone) {}
+
+    OpIndex induction_variable;
+    WordRepresentation induction_rep = WordRepresentation::Word32();
+    OpIndex start;
+    // The loop exits when the induction variable, extended to {end_rep}, is
+    // not less than {end}.
+    OpIndex end;
+    WordRepresentation end_rep = WordRepresentation::Word32();
+    LaneType lane_type = LaneType::kNone;
+    OpIndex interrupt_request;
+    ZoneVector<BoundsCheck> bounds_checks;
+    ZoneVector<OpIndex> load_bases;
+    ZoneVector<OpIndex> store_bases;
+    // The blocks of the loop in order, without the slow path of the interrupt
+    // check.
+    ZoneVector<const Block*> blocks;
+  };
+
+  LoopVectorizationAnalyzer(Zone* phase_zone, const Graph* input_graph)
+      : phase_zone_(phase_zone),
+        graph_(*input_graph),
+        loop_finder_(phase_zone, input_graph),
+        roles_(input_graph->op_id_count(), OpRole::kNone, phase_zone),
+        loops_(phase_zone) {
+    Run();
+  }
+
+  // Returns nullptr if the loop starting at {loop_header} cannot be
+  // vectorized.
+  const VectorizableLoop* GetVectorizableLoop(const Block* loop_header) const {
+    auto it = loops_.find(loop_header);
+    return it == loops_.end() ? nullptr : &it->second;
+  }
+
+  OpRole GetRole(OpIndex index) const { return roles_[index]; }
+
+  static int LaneCount(LaneType lane_type) {
+    return kSimd128Size >> LaneSizeLog2(lane_type);
+  }
+  static int LaneSizeLog2(LaneType lane_type);
+
+  // Returns the Simd128 operation that performs {op} on each lane.
+  static base::Optional<Simd128BinopOp::Kind> GetSimd128BinopKind(
+      LaneType lane_type, const Operation& op);
+
+ private:
+  // Loops bigger than this are not vectorized.
+  static constexpr size_t kMaxLoopSize = 200;
+  // Each pair of a store and another memory access needs an alias check.
+  static constexpr size_t kMaxMemoryAccesses = 8;
+
+  void Run();
+  bool AnalyzeLoop(const Block* header, VectorizableLoop* loop);
+  bool AnalyzeControlFlow(const Block* header, VectorizableLoop* loop);
+  bool AnalyzeOperation(OpIndex index, const Operation& op,
+                        const Block* block, VectorizableLoop* loop);
+  base::Optional<OpRole> GetOpRole(OpIndex index, const Operation& op,
+                                   VectorizableLoop* loop);
+
+  bool IsInLoop(OpIndex index) const;
+  bool IsInvariant(OpIndex index) const;
+  OpRole GetLoopRole(OpIndex index) const;
+  bool IsIndex(OpIndex index) const;
+  bool IsInterruptCheck(const BranchOp& branch, const Block** slow_path) const;
+  bool IsLaneOperand(OpIndex index, LaneType lane_type, OpRole role) const;
+  bool IsLaneAccess(OpIndex base, OpIndex index, LoadOp::Kind kind,
+                    MemoryRepresentation rep, int32_t offset,
+                    uint8_t element_size_log2, VectorizableLoop* loop) const;
+  bool IsIncrement(const Operation& op);
+  bool IsBoundsCheck(OpIndex condition, BoundsCheck* check) const;
+
+  bool Reject(const Block* header, const char* reason) const;
+
+  Zone* phase_zone_;
+  const Graph& graph_;
+  LoopFinder loop_finder_;
+  FixedSidetable<OpRole> roles_;
+  ZoneUnorderedMap<const Block*, VectorizableLoop> loops_;
+
+  // State of the loop being analyzed.
+  const Block* current_header_ = nullptr;
+  const Block* exit_successor_ = nullptr;
+  const Block* slow_path_ = nullptr;
+  OpIndex exit_condition_ = OpIndex::Invalid();
+  OpIndex interrupt_condition_ = OpIndex::Invalid();
+  OpIndex checked_increment_ = OpIndex::Invalid();
+  OpIndex induction_variable_ = OpIndex::Invalid();
+};
+
+// LoopVectorizationReducer vectorizes the loops found by
+// LoopVectorizationAnalyzer. The forward edge to such a loop is replaced by
+//
+//     if (0 <= start && start < end && end - start >= kLanes &&
+//         end <= bounds check limits && memory accesses don't overlap) {
+//       for (i = start; i <= end - kLanes; i += kLanes) {
+//         if (interrupt requested) break;
+//         out[i:i+kLanes] = f(a[i:i+kLanes], b[i:i+kLanes], ...);
+//       }
+//       start = i;
+//     }
+//     goto Loop;   // The scalar loop, now starting from `start`.
+//
+// The scalar loop executes the remaining iterations, and all iterations if the
+// condition doesn't hold, which means that the vector loop doesn't need any
+// check that can deoptimize. Interrupts are handled by leaving the vector loop,
+// so that the interrupt check of the scalar loop handles them with its frame
+// state.
+template <class Next>
+class LoopVectorizationReducer : public Next {
+ public:
+  TURBOSHAFT_REDUCER_BOILERPLATE()
+
+  using Analyzer = LoopVectorizationAnalyzer;
+
+  OpIndex REDUCE_INPUT_GRAPH(Goto)(OpIndex ig_idx, const GotoOp& gto) {
+    LABEL_BLOCK(no_change) { return Next::ReduceInputGraphGoto(ig_idx, gto); }
+
+    const Block* dst = gto.destination;
+    if (!dst->IsLoop() ||
+        Asm().current_input_block()->index() >= dst->index()) {
+      goto no_change;
+    }
+    const Analyzer::VectorizableLoop* loop = analyzer_.GetVectorizableLoop(dst);
+    if (loop == nullptr || ShouldSkipOptimizationStep()) goto no_change;
+    EmitVectorLoop(*loop);
+    goto no_change;
+  }
+
+  OpIndex REDUCE_INPUT_GRAPH(Phi)(OpIndex ig_idx, const PhiOp& phi) {
+    if (OpIndex start = scalar_loop_start_[ig_idx]; start.valid()) {
+      // The scalar loop starts where the vector loop stopped.
+      return Asm().PendingLoopPhi(start, phi.rep,
+                                  phi.input(PhiOp::kLoopPhiBackEdgeIndex));
+    }
+    return Next::ReduceInputGraphPhi(ig_idx, phi);
+  }
+
+ private:
+  void EmitVectorLoop(const Analyzer::VectorizableLoop& loop) {
+    const Graph& input_graph = Asm().input_graph();
+    const WordRepresentation rep = loop.induction_rep;
+    const int lane_count = Analyzer::LaneCount(loop.lane_type);
+
+    OpIndex start = Asm().MapToNewGraph(loop.start);
+    Variable scalar_start = Asm().NewLoopInvariantVariable(rep);
+    Asm().SetVariable(scalar_start, start);
+
+    // The vector loop doesn't call anything and thus cannot trigger a GC, so
+    // that this is also correct for raw pointers into the heap, such as the
+    // data pointer of on-heap typed arrays.
+    for (const Block* block : loop.blocks) {
+      for (OpIndex index : input_graph.OperationIndices(*block)) {
+        if (analyzer_.GetRole(index) == Analyzer::OpRole::kInvariant) {
+          vector_values_[index] = EmitInvariant(input_graph.Get(index));
+        }
+      }
+    }
+
+    V<WordPtr> start_index = ChangeToWordPtr(start, rep);
+    V<WordPtr> end_index =
+        ChangeToWordPtr(MapInvariant(loop.end), loop.end_rep);
+    IF (LIKELY(CanUseVectorLoop(loop, start_index, end_index))) {
+      V<WordPtr> last_index = __ WordPtrSub(end_index, lane_count);
+
+      Label<WordPtr> done(this);
+      LoopLabel<WordPtr> vector_loop(this);
+      GOTO(vector_loop, start_index);
+
+      LOOP(vector_loop, index) {
+        GOTO_IF_NOT(LIKELY(__ UintPtrLessThanOrEqual(index, last_index)),
+                    done, index);
+        if (loop.interrupt_request.valid()) {
+          const LoadOp& load =
+              input_graph.Get(loop.interrupt_request).Cast<LoadOp>();
+          V<Word32> requested = __ Load(MapInvariant(load.base()), load.kind,
+                                        load.loaded_rep, load.offset);
+          GOTO_IF(UNLIKELY(requested), done, index);
+        }
+
+        EmitVectorBody(loop, index);
+
+        GOTO(vector_loop, __ WordPtrAdd(index, lane_count));
+      }
+
+      BIND(done, next_index);
+      Asm().SetVariable(scalar_start, ChangeFromWordPtr(next_index, rep));
+    }
+    END_IF
+
+    scalar_loop_start_[loop.induction_variable] =
+        Asm().GetVariable(scalar_start);
+  }
+
+  // The vector loop executes the iterations of the scalar loop from {start} to
+  // {end}, which is only correct if none of the checks of the scalar loop
+  // fails in these iterations, and if no iteration reads or writes memory that
+  // an other iteration of the same vector iteration writes.
+  V<Word32> CanUseVectorLoop(const Analyzer::VectorizableLoop& loop,
+                             V<WordPtr> start, V<WordPtr> end) {
+    const WordRepresentation word_ptr = WordRepresentation::PointerSized();
+    const int lane_count = Analyzer::LaneCount(loop.lane_type);
+
+    // Both {start} and {end} are sign-extended, so that this also ensures
+    // that the induction variable doesn't overflow.
+    V<Word32> result = __ Word32BitwiseAnd(
+        __ IntLessThanOrEqual(__ IntPtrConstant(0), start, word_ptr),
+        __ IntLessThan(start, end, word_ptr));
+    result = __ Word32BitwiseAnd(
+        result, __ IntLessThanOrEqual(__ IntPtrConstant(lane_count),
+                                      __ WordPtrSub(end, start), word_ptr));
+    if (loop.induction_rep != loop.end_rep) {
+      result = __ Word32BitwiseAnd(
+          result, __ IntLessThanOrEqual(end, __ IntPtrConstant(kMaxInt),
+                                        word_ptr));
+    }
+
+    // Limits are unsigned, and the induction variable is less than {end}.
+    for (const Analyzer::BoundsCheck& check : loop.bounds_checks) {
+      V<WordPtr> limit = check.rep == word_ptr
+                             ? V<WordPtr>::Cast(MapInvariant(check.limit))
+                             : __ ChangeUint32ToUintPtr(
+                                   V<Word32>::Cast(MapInvariant(check.limit)));
+      result = __ Word32BitwiseAnd(result,
+                                   __ UintPtrLessThanOrEqual(end, limit));
+    }
+
+    // Accesses to the same address are done by the same iteration, and
+    // accesses that are at least a Simd128 apart are done by different
+    // iterations of the vector loop, in the same order as in the scalar loop.
+    auto add_alias_check = [&](OpIndex store_base, OpIndex other_base) {
+      V<WordPtr> a = MapInvariant(store_base);
+      V<WordPtr> b = MapInvariant(other_base);
+      V<Word32> disjoint = __ Word32BitwiseAnd(
+          __ UintPtrLessThanOrEqual(__ IntPtrConstant(kSimd128Size),
+                                    __ WordPtrSub(a, b)),
+          __ UintPtrLessThanOrEqual(__ IntPtrConstant(kSimd128Size),
+                                    __ WordPtrSub(b, a)));
+      result = __ Word32BitwiseAnd(
+          result, __ Word32BitwiseOr(__ WordPtrEqual(a, b), disjoint));
+    };
+    for (size_t i = 0; i < loop.store_bases.size(); i++) {
+      OpIndex store_base = loop.store_bases[i];
+      for (size_t j = i + 1; j < loop.store_bases.size(); j++) {
+        if (loop.store_bases[j] != store_base) {
+          add_alias_check(store_base, loop.store_bases[j]);
+        }
+      }
+      for (OpIndex load_base : loop.load_bases) {
+        if (load_base != store_base) add_alias_check(store_base, load_base);
+      }
+    }
+    return result;
+  }
+
+  void EmitVectorBody(const Analyzer::VectorizableLoop& loop,
+                      V<WordPtr> index) {
+    const Graph& input_graph = Asm().input_graph();
+    for (const Block* block : loop.blocks) {
+      for (OpIndex ig_index : input_graph.OperationIndices(*block)) {
+        const Operation& op = input_graph.Get(ig_index);
+        switch (analyzer_.GetRole(ig_index)) {
+          case Analyzer::OpRole::kLane:
+          case Analyzer::OpRole::kWidenedResult:
+            vector_values_[ig_index] = EmitLaneOp(loop.lane_type, op, index);
+            break;
+          case Analyzer::OpRole::kWidenedLane:
+            // Float32 lanes are not converted, since the operations on them
+            // are done on Float32 lanes.
+            vector_values_[ig_index] =
+                vector_values_[op.Cast<ChangeOp>().input()];
+            break;
+          case Analyzer::OpRole::kStore: {
+            const StoreOp& store = op.Cast<StoreOp>();
+            __ Store(MapInvariant(store.base()), index,
+                     GetLaneOperand(loop.lane_type, store.value()),
+                     StoreOp::Kind::RawUnaligned(),
+                     MemoryRepresentation::Simd128(),
+                     WriteBarrierKind::kNoWriteBarrier, 0,
+                     store.element_size_log2);
+            break;
+          }
+          case Analyzer::OpRole::kRetain:
+            __ Retain(MapInvariant(op.Cast<RetainOp>().retained()));
+            break;
+          default:
+            break;
+        }
+      }
+    }
+  }
+
+  OpIndex EmitLaneOp(Analyzer::LaneType lane_type, const Operation& op,
+                     V<WordPtr> index) {
+    if (const LoadOp* load = op.TryCast<LoadOp>()) {
+      return __ Load(MapInvariant(load->base()), index,
+                     LoadOp::Kind::RawUnaligned(),
+                     MemoryRepresentation::Simd128(), 0,
+                     load->element_size_log2);
+    }
+    if (const ChangeOp* change = op.TryCast<ChangeOp>()) {
+      // Rounding a widened result to Float32.
+      return vector_values_[change->input()];
+    }
+    DCHECK_EQ(op.input_count, 2);
+    base::Optional<Simd128BinopOp::Kind> kind =
+        Analyzer::GetSimd128BinopKind(lane_type, op);
+    DCHECK(kind.has_value());
+    return __ Simd128Binop(GetLaneOperand(lane_type, op.input(0)),
+                           GetLaneOperand(lane_type, op.input(1)), *kind);
+  }
+
+  V<Simd128> GetLaneOperand(Analyzer::LaneType lane_type, OpIndex ig_index) {
+    const ConstantOp* constant =
+        Asm().input_graph().Get(ig_index).template TryCast<ConstantOp>();
+    if (constant == nullptr) {
+      DCHECK(vector_values_[ig_index].valid());
+      return vector_values_[ig_index];
+    }
+    uint8_t value[kSimd128Size];
+    switch (lane_type) {
+      case Analyzer::LaneType::kInt8:
+        Splat(value, static_cast<uint8_t>(constant->word32()));
+        break;
+      case Analyzer::LaneType::kInt16:
+        Splat(value, static_cast<uint16_t>(constant->word32()));
+        break;
+      case Analyzer::LaneType::kInt32:
+        Splat(value, constant->word32());
+        break;
+      case Analyzer::LaneType::kFloat32:
+        Splat(value, constant->kind == ConstantOp::Kind::kFloat32
+                         ? constant->float32()
+                         : static_cast<float>(constant->float64()));
+        break;
+      case Analyzer::LaneType::kFloat64:
+        Splat(value, constant->float64());
+        break;
+      case Analyzer::LaneType::kNone:
+        UNREACHABLE();
+    }
+    return __ Simd128Constant(value);
+  }
+
+  template <typename T>
+  static void Splat(uint8_t* value, T lane) {
+    for (size_t offset = 0; offset < kSimd128Size; offset += sizeof(T)) {
+      memcpy(value + offset, &lane, sizeof(T));
+    }
+  }
+
+  OpIndex EmitInvariant(const Operation& op) {
+    switch (op.opcode) {
+      case Opcode::kConstant: {
+        const ConstantOp& constant = op.Cast<ConstantOp>();
+        return Asm().ReduceConstant(constant.kind, constant.storage);
+      }
+      case Opcode::kWordBinop: {
+        const WordBinopOp& binop = op.Cast<WordBinopOp>();
+        return Asm().ReduceWordBinop(MapInvariant(binop.left()),
+                                     MapInvariant(binop.right()), binop.kind,
+                                     binop.rep);
+      }
+      case Opcode::kFloatBinop: {
+        const FloatBinopOp& binop = op.Cast<FloatBinopOp>();
+        return Asm().ReduceFloatBinop(MapInvariant(binop.left()),
+                                      MapInvariant(binop.right()), binop.kind,
+                                      binop.rep);
+      }
+      case Opcode::kShift: {
+        const ShiftOp& shift = op.Cast<ShiftOp>();
+        return Asm().ReduceShift(MapInvariant(shift.left()),
+                                 MapInvariant(shift.right()), shift.kind,
+                                 shift.rep);
+      }
+      case Opcode::kComparison: {
+        const ComparisonOp& comparison = op.Cast<ComparisonOp>();
+        return Asm().ReduceComparison(MapInvariant(comparison.left()),
+                                      MapInvariant(comparison.right()),
+                                      comparison.kind, comparison.rep);
+      }
+      case Opcode::kEqual: {
+        const EqualOp& equal = op.Cast<EqualOp>();
+        return Asm().ReduceEqual(MapInvariant(equal.left()),
+                                 MapInvariant(equal.right()), equal.rep);
+      }
+      case Opcode::kChange: {
+        const ChangeOp& change = op.Cast<ChangeOp>();
+        return Asm().ReduceChange(MapInvariant(change.input()), change.kind,
+                                  change.assumption, change.from, change.to);
+      }
+      case Opcode::kTaggedBitcast: {
+        const TaggedBitcastOp& bitcast = op.Cast<TaggedBitcastOp>();
+        return Asm().ReduceTaggedBitcast(MapInvariant(bitcast.input()),
+                                         bitcast.from, bitcast.to);
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+
+  // Loop invariant operations of the loop are emitted by {EmitInvariant}, the
+  // other ones have already been emitted in front of the loop.
+  OpIndex MapInvariant(OpIndex ig_index) {
+    if (OpIndex result = vector_values_[ig_index]; result.valid()) {
+      return result;
+    }
+    return Asm().MapToNewGraph(ig_index);
+  }
+
+  // The induction variable and the end of the loop are signed.
+  V<WordPtr> ChangeToWordPtr(OpIndex value, WordRepresentation rep) {
+    if (rep == WordRepresentation::PointerSized()) {
+      return V<WordPtr>::Cast(value);
+    }
+    return __ ChangeInt32ToIntPtr(V<Word32>::Cast(value));
+  }
+
+  OpIndex ChangeFromWordPtr(V<WordPtr> value, WordRepresentation rep) {
+    if (rep == WordRepresentation::PointerSized()) return value;
+    return __ TruncateWord64ToWord32(V<Word64>::Cast(value));
+  }
+
+  Analyzer analyzer_{Asm().phase_zone(), &Asm().input_graph()};
+  // The values of the vector loop, and the loop invariant operations of the
+  // loop that are emitted in front of it.
+  FixedSidetable<OpIndex> vector_values_{Asm().input_graph().op_id_count(),
+                                         Asm().phase_zone()};
+  // The first value of the induction variable of the scalar loops that follow
+  // a vector loop.
+  FixedSidetable<OpIndex> scalar_loop_start_{
+      Asm().input_graph().op_id_count(), Asm().phase_zone()};
+};
+
+#include "src/compiler/turboshaft/undef-assembler-macros.inc"
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOOP_VECTORIZATION_REDUCER_H_
@@ -174,6 +174,65 @@ class GraphVisitor {
     return VisitOp<false>(index, input_block);
   }
 
+  // Emits a copy of the input blocks {sub_graph}, starting with a Goto from
+  // the current block to the copy of the first block. {sub_graph} has to be
+  // sorted by block index, so that blocks are visited after their forward
+  // predecessors. Edges between blocks of {sub_graph} go to the copies, all
+  // other edges keep their usual destination. If {keep_loop_kinds} is false,
+  // loop headers are copied as merges, and the reducer that requested the
+  // copy has to take care of their Phis. Returns the copy of the first block.
+  //
+  // Like {CloneAndInlineBlock}, this can be called multiple times for the same
+  // blocks: the operations of cloned blocks are mapped through Variables.
+  template <class Set>
+  Block* CloneSubGraph(const Set& sub_graph, bool keep_loop_kinds) {
+    DCHECK(std::is_sorted(sub_graph.begin(), sub_graph.end(),
+                          [](const Block* a, const Block* b) {
+                            return a->index() < b->index();
+                          }));
+    ScopedModification<const Block*> restore_input_block(&current_input_block_,
+                                                         current_input_block_);
+    ScopedModification<bool> restore_needs_variables(
+        &current_block_needs_variables_, current_block_needs_variables_);
+
+    // The input blocks are temporarily mapped to their copies, so that Gotos
+    // and Branches between them are emitted to the copies.
+    base::SmallVector<Block*, 16> old_mappings;
+    for (const Block* input_block : sub_graph) {
+      Block& block = modifiable_input_graph().Get(input_block->index());
+      old_mappings.push_back(block.MapToNextGraph());
+      block.RemapToNextGraph(keep_loop_kinds && block.IsLoop()
+                                 ? output_graph().NewLoopHeader()
+                                 : output_graph().NewBlock());
+      blocks_needing_variables.insert(input_block->index());
+    }
+
+    Block* start = (*sub_graph.begin())->MapToNextGraph();
+    assembler().Goto(start);
+    for (const Block* input_block : sub_graph) {
+      VisitBlock<false>(input_block);
+    }
+
+    auto old_mapping = old_mappings.begin();
+    for (const Block* input_block : sub_graph) {
+      modifiable_input_graph()
+          .Get(input_block->index())
+          .RemapToNextGraph(*old_mapping++);
+    }
+    return start;
+  }
+
+  // Emits the backedge from the current block to {loop_header}, which is a
+  // loop header of the output graph, for reducers that skipped the backedge of
+  // the input graph. The pending Phis of {loop_header} take the value that
+  // their backedge input currently maps to.
+  void EmitLoopBackedge(Block* loop_header) {
+    DCHECK(loop_header->IsLoop());
+    DCHECK(loop_header->IsBound());
+    FixLoopPhis(loop_header);
+    assembler().ReduceGoto(loop_header);
+  }
+
   template <bool can_be_invalid = false>
   OpIndex MapToNewGraph(OpIndex old_index, int predecessor_index = -1) {
     DCHECK(old_index.valid());
@@ -252,7 +311,13 @@ class GraphVisitor {
     if (auto* final_goto = last_op.TryCast<GotoOp>()) {
       if (final_goto->destination->IsLoop()) {
         if (input_block->index() > final_goto->destination->index()) {
-          assembler().FinalizeLoop(final_goto->destination->MapToNextGraph());
+          Block* new_loop = final_goto->destination->MapToNextGraph();
+          // Loop headers copied as merges by {CloneSubGraph} have no
+          // backedge. If the current block is still open, a reducer skipped
+          // the backedge and is responsible for finalizing the loop.
+          if (new_loop->IsLoop() && !assembler().current_block()) {
+            assembler().FinalizeLoop(new_loop);
+          }
         } else {
           // We have a forward jump to a loop, rather than a backedge. We
           // don't need to do anything.
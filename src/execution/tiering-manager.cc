@@ -122,6 +122,37 @@ void TraceRecompile(Isolate* isolate, JSFunction function,
   }
 }
 
+void RecordTieringDecision(SharedFunctionInfo shared,
+                           CachedTieringDecision decision) {
+  if (!v8_flags.profile_guided_optimization) return;
+  if (shared->cached_tiering_decision() >= decision) return;
+  shared->set_cached_tiering_decision(decision);
+}
+
+// Whether the next tier-up of a function in `active_tier` is to a tier its
+// closures reached before.
+bool TiersUpEarly(SharedFunctionInfo shared,
+                  base::Optional<CodeKind> active_tier,
+                  TieringState tiering_state) {
+  if (!v8_flags.profile_guided_optimization) return false;
+  if (tiering_state != TieringState::kNone) return false;
+  // Optimizing early would only deoptimize again, let the closure collect
+  // its own feedback first.
+  if (shared->cached_feedback_unstable()) return false;
+  switch (shared->cached_tiering_decision()) {
+    case CachedTieringDecision::kPending:
+    case CachedTieringDecision::kEarlySparkplug:
+      return false;
+    case CachedTieringDecision::kEarlyMaglev:
+      return maglev::IsMaglevEnabled() && active_tier.has_value() &&
+             CodeKindIsUnoptimizedJSFunction(active_tier.value());
+    case CachedTieringDecision::kEarlyTurbofan:
+      return active_tier.has_value() &&
+             active_tier.value() != CodeKind::TURBOFAN;
+  }
+  UNREACHABLE();
+}
+
 }  // namespace
 
 void TraceManualRecompile(JSFunction function, CodeKind code_kind,
@@ -137,6 +168,10 @@ void TraceManualRecompile(JSFunction function, CodeKind code_kind,
 void TieringManager::Optimize(JSFunction function, OptimizationDecision d) {
   DCHECK(d.should_optimize());
   TraceRecompile(isolate_, function, d);
+  RecordTieringDecision(function->shared(),
+                        d.code_kind == CodeKind::MAGLEV
+                            ? CachedTieringDecision::kEarlyMaglev
+                            : CachedTieringDecision::kEarlyTurbofan);
   function->MarkForOptimization(isolate_, d.code_kind, d.concurrency_mode);
 }
 
@@ -144,6 +179,11 @@ void TieringManager::MarkForTurboFanOptimization(JSFunction function) {
   Optimize(function, OptimizationDecision::TurbofanHotAndStable());
 }
 
+void TieringManager::NotifyDeoptimized(JSFunction function) {
+  if (!v8_flags.profile_guided_optimization) return;
+  function->shared()->set_cached_feedback_unstable(true);
+}
+
 namespace {
 
 // Returns true when |function| should be enqueued for sparkplug compilation for
@@ -198,6 +238,13 @@ int TieringManager::InterruptBudgetFor(
       function->shared()->GetBytecodeArray(isolate)->length();
 
   if (FirstTimeTierUpToSparkplug(isolate, function)) {
+    if (v8_flags.profile_guided_optimization &&
+        function->shared()->cached_tiering_decision() !=
+            CachedTieringDecision::kPending) {
+      // Allocate the feedback vector on the first tick, the function got
+      // hot before.
+      return bytecode_length;
+    }
     return bytecode_length * v8_flags.invocation_count_for_feedback_allocation;
   }
 
@@ -208,6 +255,12 @@ int TieringManager::InterruptBudgetFor(
     // operation for forward jump.
     return INT_MAX / 2;
   }
+  base::Optional<CodeKind> active_tier =
+      override_active_tier ? override_active_tier : function->GetActiveTier();
+  if (TiersUpEarly(function->shared(), active_tier,
+                   function->tiering_state())) {
+    return v8_flags.invocation_count_for_early_optimization * bytecode_length;
+  }
   return ::i::InterruptBudgetFor(
       override_active_tier ? override_active_tier : function->GetActiveTier(),
       function->tiering_state(), bytecode_length);
@@ -423,6 +476,8 @@ void TieringManager::OnInterruptTick(Handle<JSFunction> function,
   // compile request and fulfillment, which doesn't work with strictly linear
   // tiering.
   if (compile_sparkplug) {
+    RecordTieringDecision(function->shared(),
+                          CachedTieringDecision::kEarlySparkplug);
     if (v8_flags.baseline_batch_compilation) {
       isolate_->baseline_batch_compiler()->EnqueueFunction(function);
     } else {
@@ -42,6 +42,9 @@ class TieringManager {
 
   void MarkForTurboFanOptimization(JSFunction function);
 
+  // Called when optimized code of |function| is invalidated by a deopt.
+  void NotifyDeoptimized(JSFunction function);
+
  private:
   // Make the decision whether to optimize the given function, and mark it for
   // optimization if the decision was 'yes'.
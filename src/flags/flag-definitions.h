@@ -795,6 +795,14 @@ DEFINE_INT(minimum_invocations_after_ic_update, 500,
 DEFINE_INT(minimum_invocations_before_optimization, 2,
            "Minimum number of invocations we need before non-OSR optimization")
 
+// Tiering: cached tiering decisions.
+DEFINE_BOOL(profile_guided_optimization, false,
+            "record the highest tier of functions on their SharedFunctionInfo "
+            "(and in the code cache), and tier up closures early to it")
+DEFINE_INT(invocation_count_for_early_optimization, 30,
+           "invocation count required for tiering up early to a cached "
+           "tiering decision")
+
 // Tiering: JIT fuzzing.
 //
 // When --jit-fuzzing is enabled, various tiering related thresholds are
@@ -955,6 +963,8 @@ DEFINE_INT(concurrent_recompilation_queue_length, 8,
            "the length of the concurrent compilation queue")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
+DEFINE_BOOL(concurrent_recompilation_prioritize_hot, true,
+            "compile queued jobs of functions with more invocations first")
 DEFINE_UINT(
     concurrent_turbofan_max_threads, 0,
     "max number of threads that concurrent Turbofan can use (0 for unbounded)")
@@ -1226,6 +1236,15 @@ DEFINE_EXPERIMENTAL_FEATURE(turboshaft_load_elimination,
                             "enable Turboshaft's low-level load elimination")
 DEFINE_EXPERIMENTAL_FEATURE(turboshaft_machine_lowering_opt,
                             "enable MachineOptimization during MachineLowering")
+DEFINE_EXPERIMENTAL_FEATURE(turboshaft_loop_peeling,
+                            "enable Turboshaft's loop peeling")
+DEFINE_EXPERIMENTAL_FEATURE(turboshaft_loop_unrolling,
+                            "enable Turboshaft's partial loop unrolling")
+DEFINE_EXPERIMENTAL_FEATURE(
+    turboshaft_loop_vectorization,
+    "vectorize simple loops over typed arrays with Simd128 operations")
+DEFINE_BOOL(turboshaft_trace_loop_vectorization, false,
+            "trace Turboshaft's loop vectorization")
 DEFINE_EXPERIMENTAL_FEATURE(
     turboshaft_future,
     "enable Turboshaft features that we want to ship in the not-too-far future")
@@ -1607,6 +1626,15 @@ DEFINE_UINT(minor_gc_task_trigger, 80,
 DEFINE_BOOL(scavenge_separate_stack_scanning, false,
             "use a separate phase for stack scanning in scavenge")
 DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenge")
+DEFINE_EXPERIMENTAL_FEATURE(
+    card_marking_remembered_set,
+    "record old-to-new slots of large objects in per-page card tables instead "
+    "of slot sets")
+// Minor mark-sweep extracts the remembered sets outside of a safepoint.
+DEFINE_NEG_IMPLICATION(card_marking_remembered_set, minor_ms)
+DEFINE_BOOL(request_scope_nursery, true,
+            "drop the young objects of a v8::Isolate::RequestScope without a "
+            "GC if none of them escaped the scope")
 DEFINE_EXPERIMENTAL_FEATURE(
     cppgc_young_generation,
     "run young generation garbage collections in Oilpan")
@@ -1628,9 +1656,21 @@ DEFINE_INT(
     "max worker number of concurrent marking, 0 for NumberOfWorkerThreads")
 DEFINE_BOOL(concurrent_array_buffer_sweeping, true,
             "concurrently sweep array buffers")
+DEFINE_BOOL(backing_store_pool, false,
+            "cache the memory of small array buffers in a per-isolate pool")
+DEFINE_UINT(backing_store_pool_max_block_size, 64,
+            "largest array buffer in KB served by the backing store pool")
+DEFINE_UINT(backing_store_pool_size, 4 * KB,
+            "maximum amount of memory in KB cached by the backing store pool")
 DEFINE_BOOL(stress_concurrent_allocation, false,
             "start background threads that allocate memory")
 DEFINE_BOOL(parallel_marking, true, "use parallel marking in atomic pause")
+DEFINE_FLOAT(gc_pause_target, 0.0,
+             "target duration of main-thread GC pauses in ms, 0 for none")
+DEFINE_INT(gc_worklist_stacks, 1,
+           "number of segment stacks in GC worklists; with more than one, "
+           "parallel GC threads publish to their own stack and steal from "
+           "the others, 0 for the number of processors")
 DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "number of fixpoint iterations it takes to switch to linear "
            "ephemeron algorithm")
@@ -1709,6 +1749,9 @@ DEFINE_INT(memory_reducer_gc_count, 3,
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "back the pointer compression cage and the code range with "
+            "transparent huge pages where supported")
 DEFINE_BOOL(allocation_buffer_parking, true, "allocation buffer parking")
 DEFINE_BOOL(compact, true,
             "Perform compaction on full GCs based on V8's default heuristics")
@@ -1810,6 +1853,9 @@ DEFINE_FLOAT(memory_balancer_c_value, 3e-10,
              "A special constant to balance between memory and space tradeoff. "
              "The smaller the more memory it uses.")
 DEFINE_NEG_IMPLICATION(memory_balancer, memory_reducer)
+DEFINE_SIZE_T(heap_budget, 0,
+              "process-wide budget for the old generations of all isolates "
+              "(in Mbytes), 0 for none")
 
 // assembler-ia32.cc / assembler-arm.cc / assembler-arm64.cc / assembler-x64.cc
 #ifdef V8_ENABLE_DEBUG_CODE
@@ -2061,6 +2107,8 @@ DEFINE_INT(heap_snapshot_string_limit, 1024,
 DEFINE_BOOL(heap_profiler_show_hidden_objects, false,
             "use 'native' rather than 'hidden' node type in snapshot")
 DEFINE_BOOL(profile_heap_snapshot, false, "dump time spent on heap snapshot")
+DEFINE_BOOL(heap_snapshot_parallel_serialization, true,
+            "format the nodes and edges of heap snapshots on worker threads")
 #ifdef V8_ENABLE_HEAP_SNAPSHOT_VERIFY
 DEFINE_BOOL(heap_snapshot_verify, false,
             "verify that heap snapshot matches marking visitor behavior")
@@ -2226,6 +2274,15 @@ DEFINE_BOOL(verify_snapshot_checksum, DEBUG_BOOL,
             "default in debug builds and once per process for Android.")
 DEFINE_BOOL(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
+DEFINE_STRING(read_only_heap_image, nullptr,
+              "Map the read-only heap from the given image written by "
+              "mksnapshot instead of deserializing it (static roots only)")
+DEFINE_STRING(snapshot_compression_codec, "deflate",
+              "codec used to compress snapshots if V8 is built with snapshot "
+              "compression (deflate, store)")
+DEFINE_INT(snapshot_compression_chunk_size, 256,
+           "size in KB of the independently compressed chunks of a snapshot, "
+           "which are decompressed in parallel")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
 // Regexp
@@ -2326,6 +2383,9 @@ DEFINE_STRING(startup_src, nullptr,
               "Write V8 startup as C++ src. (mksnapshot only)")
 DEFINE_STRING(startup_blob, nullptr,
               "Write V8 startup blob file. (mksnapshot only)")
+DEFINE_STRING(startup_read_only_heap_image, nullptr,
+              "Write the read-only heap image file. (mksnapshot only, static "
+              "roots only)")
 DEFINE_STRING(target_arch, nullptr,
               "The mksnapshot target arch. (mksnapshot only)")
 DEFINE_STRING(target_os, nullptr, "The mksnapshot target os. (mksnapshot only)")
@@ -2707,6 +2767,7 @@ DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(single_threaded,
                        parallel_compile_tasks_for_eager_toplevel)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_lazy)
+DEFINE_NEG_IMPLICATION(single_threaded, heap_snapshot_parallel_serialization)
 #ifdef V8_ENABLE_MAGLEV
 DEFINE_NEG_IMPLICATION(single_threaded, maglev_deopt_data_on_background)
 DEFINE_NEG_IMPLICATION(single_threaded, maglev_build_code_on_background)
@@ -13,6 +13,7 @@
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
 #include "src/heap/remembered-set.h"
+#include "src/objects/backing-store-pool.h"
 #include "src/objects/js-array-buffer.h"
 #include "src/tasks/cancelable-task.h"
 #include "src/tasks/task-utils.h"
@@ -233,6 +234,11 @@ void ArrayBufferSweeper::Finalize() {
   old_.Append(&job_->old_);
   DecrementExternalMemoryCounters(job_->freed_bytes_);
   job_.reset();
+  // Memory-reducing GCs also release the memory that the swept backing
+  // stores returned to the pool.
+  if (heap_->ShouldReduceMemory() && heap_->backing_store_pool()) {
+    heap_->backing_store_pool()->Trim();
+  }
   DCHECK(!sweeping_in_progress());
 }
 
@@ -4,6 +4,7 @@
 
 #include "src/heap/base/incremental-marking-schedule.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "src/base/platform/time.h"
@@ -97,24 +98,42 @@ size_t IncrementalMarkingSchedule::GetNextIncrementalStepDuration(
   // Stash away the current data for others to access.
   current_step_ = {mutator_thread_marked_bytes_, GetConcurrentlyMarkedBytes(),
                    estimated_live_bytes, expected_marked_bytes, elapsed_time};
+  size_t step_size;
   if ((actual_marked_bytes >= last_marked_bytes) &&
       (actual_marked_bytes - last_marked_bytes) <
           kStepSizeWhenNotMakingProgress) {
-    return std::max(kStepSizeWhenNotMakingProgress, min_marked_bytes_per_step_);
-  }
-  if (expected_marked_bytes < actual_marked_bytes) {
+    step_size =
+        std::max(kStepSizeWhenNotMakingProgress, min_marked_bytes_per_step_);
+  } else if (expected_marked_bytes < actual_marked_bytes) {
     // Marking is ahead of schedule, incremental marking should do the minimum.
-    return min_marked_bytes_per_step_;
+    step_size = min_marked_bytes_per_step_;
+  } else {
+    // Assuming marking will take |kEstimatedMarkingTime|, overall there will
+    // be |estimated_live_bytes| live bytes to mark, and that marking speed is
+    // constant, after |elapsed_time| the number of marked_bytes should be
+    // |estimated_live_bytes| * (|elapsed_time| / |kEstimatedMarkingTime|),
+    // denoted as |expected_marked_bytes|.  If |actual_marked_bytes| is less,
+    // i.e. marking is behind schedule, incremental marking should help "catch
+    // up" by marking (|expected_marked_bytes| - |actual_marked_bytes|).
+    step_size = std::max(min_marked_bytes_per_step_,
+                         expected_marked_bytes - actual_marked_bytes);
+  }
+  if (step_size > max_marked_bytes_per_step_) {
+    current_step_.limited_by_pause_target = true;
+    step_size = max_marked_bytes_per_step_;
+  }
+  return step_size;
+}
+
+void IncrementalMarkingSchedule::SetPauseTarget(
+    v8::base::TimeDelta pause_target, double marking_speed_in_bytes_per_ms) {
+  if (pause_target.IsZero() || marking_speed_in_bytes_per_ms <= 0) {
+    max_marked_bytes_per_step_ = std::numeric_limits<size_t>::max();
+    return;
   }
-  // Assuming marking will take |kEstimatedMarkingTime|, overall there will
-  // be |estimated_live_bytes| live bytes to mark, and that marking speed is
-  // constant, after |elapsed_time| the number of marked_bytes should be
-  // |estimated_live_bytes| * (|elapsed_time| / |kEstimatedMarkingTime|),
-  // denoted as |expected_marked_bytes|.  If |actual_marked_bytes| is less,
-  // i.e. marking is behind schedule, incremental marking should help "catch
-  // up" by marking (|expected_marked_bytes| - |actual_marked_bytes|).
-  return std::max(min_marked_bytes_per_step_,
-                  expected_marked_bytes - actual_marked_bytes);
+  // Always allow some progress, even if the pause target is tiny.
+  max_marked_bytes_per_step_ = std::max<size_t>(
+      1, pause_target.InMillisecondsF() * marking_speed_in_bytes_per_ms);
 }
 
 constexpr double
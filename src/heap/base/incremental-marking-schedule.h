@@ -6,6 +6,7 @@
 #define V8_HEAP_BASE_INCREMENTAL_MARKING_SCHEDULE_H_
 
 #include <atomic>
+#include <limits>
 #include <memory>
 
 #include "src/base/optional.h"
@@ -30,6 +31,8 @@ class V8_EXPORT_PRIVATE IncrementalMarkingSchedule final {
     size_t estimated_live_bytes = 0;
     size_t expected_marked_bytes = 0;
     v8::base::TimeDelta elapsed_time;
+    // Whether the step size was cut down to meet the pause target.
+    bool limited_by_pause_target = false;
 
     size_t marked_bytes() const {
       return mutator_marked_bytes + concurrent_marked_bytes;
@@ -94,6 +97,14 @@ class V8_EXPORT_PRIVATE IncrementalMarkingSchedule final {
   // current `estimated_live_bytes`.
   size_t GetNextIncrementalStepDuration(size_t estimated_live_bytes);
 
+  // Limits the steps returned from `GetNextIncrementalStepDuration()` to the
+  // bytes that can be marked within `pause_target` at
+  // `marking_speed_in_bytes_per_ms`. The limit takes precedence over the
+  // minimum step size. A zero pause target or marking speed removes the
+  // limit.
+  void SetPauseTarget(v8::base::TimeDelta pause_target,
+                      double marking_speed_in_bytes_per_ms);
+
   // Returns the step info for the current step. This function is most useful
   // after calling `GetNextIncrementalStepDuration()` to report scheduling
   // details.
@@ -129,6 +140,7 @@ class V8_EXPORT_PRIVATE IncrementalMarkingSchedule final {
   double ephemeron_pairs_flushing_ratio_target_ = 0.25;
   StepInfo current_step_;
   const size_t min_marked_bytes_per_step_;
+  size_t max_marked_bytes_per_step_ = std::numeric_limits<size_t>::max();
   const bool predictable_schedule_ = false;
   v8::base::Optional<v8::base::TimeDelta> elapsed_time_override_;
 };
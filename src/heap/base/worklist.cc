@@ -4,13 +4,27 @@
 
 #include "src/heap/base/worklist.h"
 
+#include <algorithm>
+
 namespace heap::base {
 
 // static
 bool WorklistBase::predictable_order_ = false;
 
 // static
-void WorklistBase::EnforcePredictableOrder() { predictable_order_ = true; }
+size_t WorklistBase::num_stacks_ = 1;
+
+// static
+void WorklistBase::EnforcePredictableOrder() {
+  predictable_order_ = true;
+  num_stacks_ = 1;
+}
+
+// static
+void WorklistBase::EnableWorkStealing(size_t num_stacks) {
+  if (predictable_order_) return;
+  num_stacks_ = std::clamp(num_stacks, size_t{1}, kMaxStacks);
+}
 
 namespace internal {
 
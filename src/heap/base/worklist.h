@@ -5,7 +5,9 @@
 #ifndef V8_HEAP_BASE_WORKLIST_H_
 #define V8_HEAP_BASE_WORKLIST_H_
 
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <utility>
 
 #include "src/base/logging.h"
@@ -40,8 +42,19 @@ class V8_EXPORT_PRIVATE WorklistBase final {
   static void EnforcePredictableOrder();
   static bool PredictableOrder() { return predictable_order_; }
 
+  // Makes worklists created afterwards keep published segments on
+  // `num_stacks` separate stacks instead of a single global one. Local views
+  // publish to their own stack and steal from randomly chosen other stacks
+  // once it runs empty. Has no effect in predictable mode.
+  static void EnableWorkStealing(size_t num_stacks);
+  // Returns the number of segment stacks used by newly created worklists.
+  static size_t NumStacks() { return num_stacks_; }
+
+  static constexpr size_t kMaxStacks = 128;
+
  private:
   static bool predictable_order_;
+  static size_t num_stacks_;
 };
 
 // A global worklist based on segments which allows for a thread-local
@@ -53,6 +66,12 @@ class V8_EXPORT_PRIVATE WorklistBase final {
 // All methods on the worklist itself are safe for concurrent usage but only
 // consider published segments. Unpublished work in views using `Local` is not
 // visible.
+//
+// Published segments are kept on one or more stacks, each with its own lock.
+// With a single stack all views share it. With more stacks (see
+// `WorklistBase::EnableWorkStealing()`), views are assigned stacks round-robin
+// and only touch other stacks to steal work, which avoids contention on a
+// single lock with many parallel threads.
 template <typename EntryType, uint16_t MinSegmentSize>
 class Worklist final {
  public:
@@ -63,7 +82,8 @@ class Worklist final {
 
   static constexpr int kMinSegmentSize = MinSegmentSize;
 
-  Worklist() = default;
+  Worklist() : Worklist(WorklistBase::NumStacks()) {}
+  explicit Worklist(size_t num_stacks);
   ~Worklist() { CHECK(IsEmpty()); }
 
   Worklist(const Worklist&) = delete;
@@ -93,35 +113,93 @@ class Worklist final {
   template <typename Callback>
   void Iterate(Callback callback) const;
 
+  size_t NumStacks() const { return num_stacks_; }
+
  private:
-  void Push(Segment* segment);
-  bool Pop(Segment** segment);
+  // A lock-protected stack of published segments. Stacks are padded to
+  // separate cache lines so that threads working on different stacks don't
+  // share lines.
+  struct alignas(64) Stack {
+    mutable v8::base::Mutex lock;
+    Segment* top = nullptr;
+    std::atomic<size_t> size{0};
+  };
+
+  // Returns the stack for a new local view.
+  size_t AssignStack() {
+    return next_stack_.fetch_add(1, std::memory_order_relaxed) % num_stacks_;
+  }
+
+  void Push(Segment* segment, size_t stack_index);
+  // Pops a segment from the stack at `stack_index`, or steals one from another
+  // stack. `steal_state` is the random state used to pick victims.
+  bool Pop(Segment** segment, size_t stack_index, uint32_t* steal_state);
+  bool PopFromStack(Segment** segment, size_t stack_index);
 
-  mutable v8::base::Mutex lock_;
-  Segment* top_ = nullptr;
+  const size_t num_stacks_;
+  std::unique_ptr<Stack[]> stacks_;
   std::atomic<size_t> size_{0};
+  std::atomic<size_t> next_stack_{0};
 };
 
 template <typename EntryType, uint16_t MinSegmentSize>
-void Worklist<EntryType, MinSegmentSize>::Push(Segment* segment) {
+Worklist<EntryType, MinSegmentSize>::Worklist(size_t num_stacks)
+    : num_stacks_(num_stacks), stacks_(std::make_unique<Stack[]>(num_stacks)) {
+  DCHECK_LT(0u, num_stacks);
+  DCHECK_LE(num_stacks, WorklistBase::kMaxStacks);
+}
+
+template <typename EntryType, uint16_t MinSegmentSize>
+void Worklist<EntryType, MinSegmentSize>::Push(Segment* segment,
+                                               size_t stack_index) {
   DCHECK(!segment->IsEmpty());
-  v8::base::MutexGuard guard(&lock_);
-  segment->set_next(top_);
-  top_ = segment;
+  Stack& stack = stacks_[stack_index];
+  v8::base::MutexGuard guard(&stack.lock);
+  segment->set_next(stack.top);
+  stack.top = segment;
+  stack.size.fetch_add(1, std::memory_order_relaxed);
   size_.fetch_add(1, std::memory_order_relaxed);
 }
 
 template <typename EntryType, uint16_t MinSegmentSize>
-bool Worklist<EntryType, MinSegmentSize>::Pop(Segment** segment) {
-  v8::base::MutexGuard guard(&lock_);
-  if (top_ == nullptr) return false;
+bool Worklist<EntryType, MinSegmentSize>::PopFromStack(Segment** segment,
+                                                       size_t stack_index) {
+  Stack& stack = stacks_[stack_index];
+  v8::base::MutexGuard guard(&stack.lock);
+  if (stack.top == nullptr) return false;
+  DCHECK_LT(0U, stack.size);
   DCHECK_LT(0U, size_);
+  stack.size.fetch_sub(1, std::memory_order_relaxed);
   size_.fetch_sub(1, std::memory_order_relaxed);
-  *segment = top_;
-  top_ = top_->next();
+  *segment = stack.top;
+  stack.top = stack.top->next();
   return true;
 }
 
+template <typename EntryType, uint16_t MinSegmentSize>
+bool Worklist<EntryType, MinSegmentSize>::Pop(Segment** segment,
+                                              size_t stack_index,
+                                              uint32_t* steal_state) {
+  if (PopFromStack(segment, stack_index)) return true;
+  if (num_stacks_ == 1) return false;
+  // Start at a random victim so that thieves spread over the stacks instead
+  // of all contending on the same one. Empty stacks are skipped without
+  // taking their locks.
+  uint32_t state = *steal_state;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  *steal_state = state;
+  const size_t start = state % num_stacks_;
+  for (size_t i = 0; i < num_stacks_; i++) {
+    const size_t victim = (start + i) % num_stacks_;
+    if (victim == stack_index) continue;
+    if (stacks_[victim].size.load(std::memory_order_relaxed) == 0) continue;
+    if (PopFromStack(segment, victim)) return true;
+  }
+  return false;
+}
+
 template <typename EntryType, uint16_t MinSegmentSize>
 bool Worklist<EntryType, MinSegmentSize>::IsEmpty() const {
   return Size() == 0;
@@ -137,77 +215,95 @@ size_t Worklist<EntryType, MinSegmentSize>::Size() const {
 
 template <typename EntryType, uint16_t MinSegmentSize>
 void Worklist<EntryType, MinSegmentSize>::Clear() {
-  v8::base::MutexGuard guard(&lock_);
-  size_.store(0, std::memory_order_relaxed);
-  Segment* current = top_;
-  while (current != nullptr) {
-    Segment* tmp = current;
-    current = current->next();
-    Segment::Delete(tmp);
+  for (size_t i = 0; i < num_stacks_; i++) {
+    Stack& stack = stacks_[i];
+    v8::base::MutexGuard guard(&stack.lock);
+    size_.fetch_sub(stack.size.exchange(0, std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    Segment* current = stack.top;
+    while (current != nullptr) {
+      Segment* tmp = current;
+      current = current->next();
+      Segment::Delete(tmp);
+    }
+    stack.top = nullptr;
   }
-  top_ = nullptr;
 }
 
 template <typename EntryType, uint16_t MinSegmentSize>
 template <typename Callback>
 void Worklist<EntryType, MinSegmentSize>::Update(Callback callback) {
-  v8::base::MutexGuard guard(&lock_);
-  Segment* prev = nullptr;
-  Segment* current = top_;
-  size_t num_deleted = 0;
-  while (current != nullptr) {
-    current->Update(callback);
-    if (current->IsEmpty()) {
-      DCHECK_LT(0U, size_);
-      ++num_deleted;
-      if (prev == nullptr) {
-        top_ = current->next();
+  for (size_t i = 0; i < num_stacks_; i++) {
+    Stack& stack = stacks_[i];
+    v8::base::MutexGuard guard(&stack.lock);
+    Segment* prev = nullptr;
+    Segment* current = stack.top;
+    size_t num_deleted = 0;
+    while (current != nullptr) {
+      current->Update(callback);
+      if (current->IsEmpty()) {
+        DCHECK_LT(num_deleted, stack.size);
+        ++num_deleted;
+        if (prev == nullptr) {
+          stack.top = current->next();
+        } else {
+          prev->set_next(current->next());
+        }
+        Segment* tmp = current;
+        current = current->next();
+        Segment::Delete(tmp);
       } else {
-        prev->set_next(current->next());
+        prev = current;
+        current = current->next();
       }
-      Segment* tmp = current;
-      current = current->next();
-      Segment::Delete(tmp);
-    } else {
-      prev = current;
-      current = current->next();
     }
+    stack.size.fetch_sub(num_deleted, std::memory_order_relaxed);
+    size_.fetch_sub(num_deleted, std::memory_order_relaxed);
   }
-  size_.fetch_sub(num_deleted, std::memory_order_relaxed);
 }
 
 template <typename EntryType, uint16_t MinSegmentSize>
 template <typename Callback>
 void Worklist<EntryType, MinSegmentSize>::Iterate(Callback callback) const {
-  v8::base::MutexGuard guard(&lock_);
-  for (Segment* current = top_; current != nullptr; current = current->next()) {
-    current->Iterate(callback);
+  for (size_t i = 0; i < num_stacks_; i++) {
+    const Stack& stack = stacks_[i];
+    v8::base::MutexGuard guard(&stack.lock);
+    for (Segment* current = stack.top; current != nullptr;
+         current = current->next()) {
+      current->Iterate(callback);
+    }
   }
 }
 
 template <typename EntryType, uint16_t MinSegmentSize>
 void Worklist<EntryType, MinSegmentSize>::Merge(
     Worklist<EntryType, MinSegmentSize>& other) {
-  Segment* other_top;
-  size_t other_size;
-  {
-    v8::base::MutexGuard guard(&other.lock_);
-    if (!other.top_) return;
-
-    other_top = std::exchange(other.top_, nullptr);
-    other_size = other.size_.exchange(0, std::memory_order_relaxed);
-  }
-
-  // It's safe to iterate through these segments because the top was
-  // extracted from `other`.
-  Segment* end = other_top;
-  while (end->next()) end = end->next();
+  for (size_t i = 0; i < other.num_stacks_; i++) {
+    Segment* other_top;
+    size_t other_size;
+    {
+      Stack& other_stack = other.stacks_[i];
+      v8::base::MutexGuard guard(&other_stack.lock);
+      if (!other_stack.top) continue;
+
+      other_top = std::exchange(other_stack.top, nullptr);
+      other_size = other_stack.size.exchange(0, std::memory_order_relaxed);
+      other.size_.fetch_sub(other_size, std::memory_order_relaxed);
+    }
 
-  {
-    v8::base::MutexGuard guard(&lock_);
-    size_.fetch_add(other_size, std::memory_order_relaxed);
-    end->set_next(top_);
-    top_ = other_top;
+    // It's safe to iterate through these segments because the top was
+    // extracted from `other`.
+    Segment* end = other_top;
+    while (end->next()) end = end->next();
+
+    {
+      Stack& stack = stacks_[i % num_stacks_];
+      v8::base::MutexGuard guard(&stack.lock);
+      stack.size.fetch_add(other_size, std::memory_order_relaxed);
+      size_.fetch_add(other_size, std::memory_order_relaxed);
+      end->set_next(stack.top);
+      stack.top = other_top;
+    }
   }
 }
 
@@ -366,6 +462,10 @@ class Worklist<EntryType, MinSegmentSize>::Local final {
   Worklist<EntryType, MinSegmentSize>& worklist_;
   internal::SegmentBase* push_segment_ = nullptr;
   internal::SegmentBase* pop_segment_ = nullptr;
+  // The stack of `worklist_` that this view publishes to.
+  const size_t stack_index_;
+  // Random state for picking stacks to steal from.
+  uint32_t steal_state_;
 };
 
 template <typename EntryType, uint16_t MinSegmentSize>
@@ -373,7 +473,9 @@ Worklist<EntryType, MinSegmentSize>::Local::Local(
     Worklist<EntryType, MinSegmentSize>& worklist)
     : worklist_(worklist),
       push_segment_(internal::SegmentBase::GetSentinelSegmentAddress()),
-      pop_segment_(internal::SegmentBase::GetSentinelSegmentAddress()) {}
+      pop_segment_(internal::SegmentBase::GetSentinelSegmentAddress()),
+      stack_index_(worklist.AssignStack()),
+      steal_state_(static_cast<uint32_t>(stack_index_) * 0x9E3779B1u + 1) {}
 
 template <typename EntryType, uint16_t MinSegmentSize>
 Worklist<EntryType, MinSegmentSize>::Local::~Local() {
@@ -441,20 +543,20 @@ void Worklist<EntryType, MinSegmentSize>::Local::Merge(
 template <typename EntryType, uint16_t MinSegmentSize>
 void Worklist<EntryType, MinSegmentSize>::Local::PublishPushSegment() {
   if (push_segment_ != internal::SegmentBase::GetSentinelSegmentAddress())
-    worklist_.Push(push_segment());
+    worklist_.Push(push_segment(), stack_index_);
 }
 
 template <typename EntryType, uint16_t MinSegmentSize>
 void Worklist<EntryType, MinSegmentSize>::Local::PublishPopSegment() {
   if (pop_segment_ != internal::SegmentBase::GetSentinelSegmentAddress())
-    worklist_.Push(pop_segment());
+    worklist_.Push(pop_segment(), stack_index_);
 }
 
 template <typename EntryType, uint16_t MinSegmentSize>
 bool Worklist<EntryType, MinSegmentSize>::Local::StealPopSegment() {
   if (worklist_.IsEmpty()) return false;
   Segment* new_segment = nullptr;
-  if (worklist_.Pop(&new_segment)) {
+  if (worklist_.Pop(&new_segment, stack_index_, &steal_state_)) {
     DeleteSegment(pop_segment_);
     pop_segment_ = new_segment;
     return true;
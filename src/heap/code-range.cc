@@ -112,10 +112,13 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
   // When V8_EXTERNAL_CODE_SPACE_BOOL is enabled the allocatable region must
   // not cross the 4Gb boundary and thus the default compression scheme of
   // truncating the InstructionStream pointers to 32-bits still works. It's
-  // achieved by specifying base_alignment parameter.
-  const size_t base_alignment = V8_EXTERNAL_CODE_SPACE_BOOL
-                                    ? base::bits::RoundUpToPowerOfTwo(requested)
-                                    : kPageSize;
+  // achieved by specifying base_alignment parameter. Transparent huge pages
+  // can only back the parts of the range that are aligned to kHugePageSize.
+  const size_t base_alignment =
+      V8_EXTERNAL_CODE_SPACE_BOOL
+          ? base::bits::RoundUpToPowerOfTwo(requested)
+          : (v8_flags.transparent_huge_pages ? size_t{kHugePageSize}
+                                             : kPageSize);
 
   DCHECK_IMPLIES(kPlatformRequiresCodeRange,
                  requested <= kMaximalCodeRangeSize);
@@ -202,6 +205,8 @@ bool CodeRange::InitReservation(v8::PageAllocator* page_allocator,
     FATAL("Failed to allocate code range close to the .text section");
   }
 
+  AdviseTransparentHugePages(region());
+
   // On some platforms, specifically Win64, we need to reserve some pages at
   // the beginning of an executable space. See
   //   https://cs.chromium.org/chromium/src/components/crash/content/
@@ -16,6 +16,7 @@
 #include "src/heap/ephemeron-remembered-set.h"
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-census.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
 #include "src/heap/mark-compact-inl.h"
@@ -129,6 +130,7 @@ struct ConcurrentMarking::TaskState {
   size_t marked_bytes = 0;
   MemoryChunkDataMap memory_chunk_data;
   NativeContextStats native_context_stats;
+  HeapCensusSampler heap_census_sampler;
   PretenuringHandler::PretenuringFeedbackMap local_pretenuring_feedback{
       PretenuringHandler::kInitialFeedbackCapacity};
 };
@@ -247,6 +249,7 @@ void ConcurrentMarking::RunMajor(JobDelegate* delegate,
       heap_->tracer()->CodeFlushingIncrease(), &task_state->memory_chunk_data);
   NativeContextInferrer native_context_inferrer;
   NativeContextStats& native_context_stats = task_state->native_context_stats;
+  HeapCensusSampler& heap_census_sampler = task_state->heap_census_sampler;
   double time_ms;
   size_t marked_bytes = 0;
   Isolate* isolate = heap_->isolate();
@@ -317,6 +320,7 @@ void ConcurrentMarking::RunMajor(JobDelegate* delegate,
           visitor.IncrementLiveBytesCached(
               MemoryChunk::cast(BasicMemoryChunk::FromHeapObject(object)),
               ALIGN_TO_ALLOCATION_ALIGNMENT(visited_size));
+          if (visited_size) heap_census_sampler.Sample(map, visited_size);
           if (is_per_context_mode) {
             native_context_stats.IncrementSize(
                 local_marking_worklists.Context(), map, object, visited_size);
@@ -601,6 +605,19 @@ void ConcurrentMarking::FlushNativeContexts(NativeContextStats* main_stats) {
   }
 }
 
+void ConcurrentMarking::StartHeapCensus(size_t sample_interval) {
+  for (size_t i = 1; i < task_state_.size(); i++) {
+    task_state_[i]->heap_census_sampler.Start(sample_interval);
+  }
+}
+
+void ConcurrentMarking::FlushHeapCensus(HeapCensusSampler* main_sampler) {
+  DCHECK(!job_handle_ || !job_handle_->IsValid());
+  for (size_t i = 1; i < task_state_.size(); i++) {
+    main_sampler->Merge(&task_state_[i]->heap_census_sampler);
+  }
+}
+
 void ConcurrentMarking::FlushMemoryChunkData() {
   DCHECK(!job_handle_ || !job_handle_->IsValid());
   for (size_t i = 1; i < task_state_.size(); i++) {
@@ -13,6 +13,7 @@
 #include "src/base/optional.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
+#include "src/heap/heap-census.h"
 #include "src/heap/marking-visitor.h"
 #include "src/heap/marking-worklist.h"
 #include "src/heap/memory-measurement.h"
@@ -136,6 +137,10 @@ class V8_EXPORT_PRIVATE ConcurrentMarking {
       TaskPriority priority = TaskPriority::kUserVisible);
   // Flushes native context sizes to the given table of the main thread.
   void FlushNativeContexts(NativeContextStats* main_stats);
+  // Resets the heap census samplers of all tasks for a new full GC.
+  void StartHeapCensus(size_t sample_interval);
+  // Flushes heap census samples to the sampler of the main thread.
+  void FlushHeapCensus(HeapCensusSampler* main_sampler);
   // Flushes memory chunk data.
   void FlushMemoryChunkData();
   // This function is called for a new space page that was cleared after
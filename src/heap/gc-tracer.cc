@@ -324,6 +324,7 @@ void GCTracer::StopObservablePause(GarbageCollector collector) {
   FetchBackgroundCounters();
 
   const base::TimeDelta duration = current_.end_time - current_.start_time;
+  RecordPauseForTarget(duration);
   auto* long_task_stats = heap_->isolate()->GetCurrentLongTaskStats();
   const bool is_young = Heap::IsYoungGenerationCollector(collector);
   if (is_young) {
@@ -675,9 +676,24 @@ void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
     incremental_marking_duration_ +=
         base::TimeDelta::FromMillisecondsD(duration);
   }
+  RecordPauseForTarget(base::TimeDelta::FromMillisecondsD(duration));
   ReportIncrementalMarkingStepToRecorder(duration);
 }
 
+void GCTracer::RecordPauseForTarget(base::TimeDelta duration) {
+  if (!heap_->HasGCPauseTarget()) return;
+  pauses_with_target_++;
+  if (duration > heap_->gc_pause_target()) {
+    pauses_exceeding_target_++;
+    if (V8_UNLIKELY(v8_flags.trace_gc_verbose)) {
+      heap_->isolate()->PrintWithTimestamp(
+          "GC pause of %.1fms exceeded the target of %.1fms\n",
+          duration.InMillisecondsF(),
+          heap_->gc_pause_target().InMillisecondsF());
+    }
+  }
+}
+
 void GCTracer::AddIncrementalSweepingStep(double duration) {
   ReportIncrementalSweepingStepToRecorder(duration);
 }
@@ -1036,7 +1052,9 @@ void GCTracer::PrintNVP() const {
           "new_space_survive_rate=%.1f%% "
           "new_space_allocation_throughput=%.1f "
           "unmapper_chunks=%d "
-          "compaction_speed=%.f\n",
+          "compaction_speed=%.f "
+          "pauses_with_target=%zu "
+          "pauses_exceeding_target=%zu\n",
           duration.InMillisecondsF(), spent_in_mutator.InMillisecondsF(),
           ToString(current_.type, true), current_.reduce_memory,
           current_scope(Scope::TIME_TO_SAFEPOINT),
@@ -1122,7 +1140,8 @@ void GCTracer::PrintNVP() const {
           heap_->new_space_surviving_rate_,
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           heap_->memory_allocator()->unmapper()->NumberOfChunks(),
-          CompactionSpeedInBytesPerMillisecond());
+          CompactionSpeedInBytesPerMillisecond(), pauses_with_target_,
+          pauses_exceeding_target_);
       break;
     case Event::Type::START:
       break;
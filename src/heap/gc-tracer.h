@@ -321,6 +321,12 @@ class V8_EXPORT_PRIVATE GCTracer {
   // Log an incremental marking step.
   void AddIncrementalSweepingStep(double duration);
 
+  // Returns the number of main-thread pauses recorded while a pause target
+  // was set (see Heap::SetGCPauseTarget()), and how many of them exceeded
+  // the target.
+  size_t pauses_with_target() const { return pauses_with_target_; }
+  size_t pauses_exceeding_target() const { return pauses_exceeding_target_; }
+
   // Compute the average incremental marking speed in bytes/millisecond.
   // Returns a conservative value if no events have been recorded.
   double IncrementalMarkingSpeedInBytesPerMillisecond() const;
@@ -440,6 +446,9 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   void StopCycle(GarbageCollector collector);
 
+  // Counts `duration` towards the pauses checked against the pause target.
+  void RecordPauseForTarget(base::TimeDelta duration);
+
   // Statistics for background scopes are kept out of the current event and only
   // copied there via FetchBackgroundCounters(). This method here is thread-safe
   // but may return out-of-date numbers as it only considers data from the
@@ -504,6 +513,10 @@ class V8_EXPORT_PRIVATE GCTracer {
   // mark-compact event.
   base::TimeDelta incremental_marking_duration_;
 
+  // Pauses observed with a pause target, and the ones above the target.
+  size_t pauses_with_target_ = 0;
+  size_t pauses_exceeding_target_ = 0;
+
   base::TimeTicks incremental_marking_start_time_;
 
   double recorded_incremental_marking_speed_ = 0.0;
@@ -0,0 +1,185 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-budget-coordinator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "src/base/lazy-instance.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/new-spaces.h"
+#include "src/tracing/trace-event.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(HeapBudgetCoordinator, GetCoordinator,
+                                size_t{v8_flags.heap_budget} * MB)
+
+}  // namespace
+
+// static
+HeapBudgetCoordinator* HeapBudgetCoordinator::Get() {
+  if (v8_flags.heap_budget == 0) return nullptr;
+  return GetCoordinator();
+}
+
+void HeapBudgetCoordinator::AddHeap(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  DCHECK_NULL(FindHeap(heap));
+  heaps_.push_back(HeapStats{heap});
+}
+
+void HeapBudgetCoordinator::RemoveHeap(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  auto it = std::find_if(
+      heaps_.begin(), heaps_.end(),
+      [heap](const HeapStats& stats) { return stats.heap == heap; });
+  if (it == heaps_.end()) return;
+  heaps_.erase(it);
+  // The memory of the removed heap is available to the others.
+  Rebalance();
+}
+
+HeapBudgetCoordinator::HeapStats* HeapBudgetCoordinator::FindHeap(Heap* heap) {
+  for (HeapStats& stats : heaps_) {
+    if (stats.heap == heap) return &stats;
+  }
+  return nullptr;
+}
+
+void HeapBudgetCoordinator::NotifyGC(Heap* heap, GarbageCollector collector) {
+  const bool is_full_gc = collector == GarbageCollector::MARK_COMPACTOR;
+  const size_t current_bytes = heap->OldGenerationSizeOfObjects();
+  double allocation_rate = 0;
+  double gc_speed = 0;
+  if (is_full_gc) {
+    allocation_rate = heap->tracer()
+                          ->OldGenerationAllocationThroughputInBytesPerMillisecond();
+    gc_speed = heap->tracer()->CombinedMarkCompactSpeedInBytesPerMillisecond();
+  }
+
+  size_t limit;
+  {
+    base::MutexGuard guard(&mutex_);
+    HeapStats* stats = FindHeap(heap);
+    if (!stats) return;
+    stats->current_bytes = current_bytes;
+    if (is_full_gc) {
+      stats->live_bytes = current_bytes;
+      stats->allocation_rate = allocation_rate;
+      stats->gc_speed = gc_speed;
+      stats->has_full_gc = true;
+      stats->gc_requested = false;
+      Rebalance();
+    }
+    limit = stats->limit;
+    RequestGCIfOverBudget();
+  }
+  if (limit == 0) return;
+
+  // The coordinator only lowers the limit that the heap computed itself.
+  limit += heap->new_space() ? heap->new_space()->Capacity() : 0;
+  const size_t old_generation_limit = heap->old_generation_allocation_limit();
+  if (limit >= old_generation_limit) return;
+  // Keep the part of the global limit that is reserved for external memory,
+  // as the MemoryBalancer does.
+  heap->SetOldGenerationAndGlobalAllocationLimit(
+      limit, heap->global_allocation_limit() - (old_generation_limit - limit));
+}
+
+size_t HeapBudgetCoordinator::LimitForTesting(Heap* heap) {
+  base::MutexGuard guard(&mutex_);
+  HeapStats* stats = FindHeap(heap);
+  return stats ? stats->limit : 0;
+}
+
+void HeapBudgetCoordinator::Rebalance() {
+  // Heap i gets extra memory proportional to sqrt(L_i * g_i / s_i), where L
+  // is the live memory, g the allocation rate and s the GC speed. This is the
+  // MemoryBalancer limit with the constant chosen such that the limits of all
+  // heaps add up to the budget.
+  auto weight = [](const HeapStats& stats) {
+    if (stats.allocation_rate <= 0 || stats.gc_speed <= 0) return 0.0;
+    return std::sqrt(stats.live_bytes * stats.allocation_rate /
+                     stats.gc_speed);
+  };
+
+  size_t total_live_bytes = 0;
+  double total_weight = 0;
+  int reported_heaps = 0;
+  for (const HeapStats& stats : heaps_) {
+    if (!stats.has_full_gc) continue;
+    total_live_bytes += stats.live_bytes;
+    total_weight += weight(stats);
+    reported_heaps++;
+  }
+  if (reported_heaps == 0) return;
+  const size_t extra_bytes =
+      budget_ > total_live_bytes ? budget_ - total_live_bytes : 0;
+
+  for (HeapStats& stats : heaps_) {
+    if (!stats.has_full_gc) continue;
+    const double share = total_weight > 0 ? weight(stats) / total_weight
+                                          : 1.0 / reported_heaps;
+    stats.limit = stats.live_bytes +
+                  std::max<size_t>(kMinHeapExtraSpace,
+                                   static_cast<size_t>(extra_bytes * share));
+    TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.heap_budget"),
+                         "V8.HeapBudgetLimit", TRACE_EVENT_SCOPE_THREAD,
+                         "isolate", stats.heap->isolate()->id(), "limit",
+                         stats.limit);
+  }
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.heap_budget"),
+                       "V8.HeapBudgetRebalance", TRACE_EVENT_SCOPE_THREAD,
+                       "live_bytes", total_live_bytes, "extra_bytes",
+                       extra_bytes);
+}
+
+void HeapBudgetCoordinator::RequestGCIfOverBudget() {
+  size_t total_bytes = 0;
+  for (const HeapStats& stats : heaps_) total_bytes += stats.current_bytes;
+  if (total_bytes <= budget_) return;
+
+  // Marking time is proportional to the live memory, so the heap with the
+  // most garbage per byte of live memory, weighted by its GC speed, is the
+  // cheapest one to collect.
+  HeapStats* victim = nullptr;
+  double best_efficiency = 0;
+  for (HeapStats& stats : heaps_) {
+    if (stats.gc_requested || stats.current_bytes <= stats.live_bytes) {
+      continue;
+    }
+    const double garbage_bytes = stats.current_bytes - stats.live_bytes;
+    const double gc_speed =
+        stats.gc_speed > 0 ? stats.gc_speed
+                           : GCTracer::kConservativeSpeedInBytesPerMillisecond;
+    const double efficiency =
+        garbage_bytes * gc_speed / std::max<size_t>(stats.live_bytes, 1);
+    if (efficiency > best_efficiency) {
+      best_efficiency = efficiency;
+      victim = &stats;
+    }
+  }
+  if (!victim) return;
+
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("v8.heap_budget"),
+                       "V8.HeapBudgetRequestGC", TRACE_EVENT_SCOPE_THREAD,
+                       "isolate", victim->heap->isolate()->id(), "total_bytes",
+                       total_bytes);
+  victim->gc_requested = true;
+  // Starts incremental marking on the isolate's thread. The heap cannot be
+  // removed while the lock is held.
+  victim->heap->MemoryPressureNotification(MemoryPressureLevel::kModerate,
+                                           false);
+}
+
+}  // namespace internal
+}  // namespace v8
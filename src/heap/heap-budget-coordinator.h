@@ -0,0 +1,82 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_BUDGET_COORDINATOR_H_
+#define V8_HEAP_HEAP_BUDGET_COORDINATOR_H_
+
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Divides a process-wide byte budget (--heap-budget) between the old
+// generations of all isolates in the process.
+//
+// Every heap reports its live memory, old generation allocation rate and
+// mark-compact speed after a full GC, and its current size after every GC.
+// The memory above the total live memory is split using the MemoryBalancer
+// formula with a single constant for all heaps, i.e. heap i gets extra memory
+// proportional to sqrt(live_i * allocation_rate_i / gc_speed_i). The result
+// caps the allocation limit that the heap computes for itself.
+//
+// If the heaps together exceed the budget, a memory-reducing GC is requested
+// on the heap that is expected to reclaim the most bytes per millisecond of
+// marking.
+class V8_EXPORT_PRIVATE HeapBudgetCoordinator final {
+ public:
+  // Returns the coordinator, or nullptr if --heap-budget is not set.
+  static HeapBudgetCoordinator* Get();
+
+  explicit HeapBudgetCoordinator(size_t budget) : budget_(budget) {}
+
+  HeapBudgetCoordinator(const HeapBudgetCoordinator&) = delete;
+  HeapBudgetCoordinator& operator=(const HeapBudgetCoordinator&) = delete;
+
+  void AddHeap(Heap* heap);
+  void RemoveHeap(Heap* heap);
+
+  // Must be called on the heap's thread after a GC.
+  void NotifyGC(Heap* heap, GarbageCollector collector);
+
+  // Returns the old generation limit assigned to the heap, or 0 if the heap
+  // has not completed a full GC yet.
+  size_t LimitForTesting(Heap* heap);
+
+ private:
+  struct HeapStats {
+    Heap* heap;
+    // Old generation size after the last full GC.
+    size_t live_bytes = 0;
+    // Old generation size after the last GC.
+    size_t current_bytes = 0;
+    // In bytes per millisecond, 0 if unknown.
+    double allocation_rate = 0;
+    double gc_speed = 0;
+    // The old generation limit assigned by the last rebalancing.
+    size_t limit = 0;
+    bool has_full_gc = false;
+    bool gc_requested = false;
+  };
+
+  // 2 MB of extra space, as in the MemoryBalancer.
+  static constexpr size_t kMinHeapExtraSpace = 2 * MB;
+
+  HeapStats* FindHeap(Heap* heap);
+  void Rebalance();
+  void RequestGCIfOverBudget();
+
+  const size_t budget_;
+  base::Mutex mutex_;
+  std::vector<HeapStats> heaps_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_BUDGET_COORDINATOR_H_
@@ -0,0 +1,125 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-census.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "src/heap/heap-inl.h"
+#include "src/heap/marking-state-inl.h"
+#include "src/objects/instance-type-inl.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/map-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+
+namespace v8 {
+namespace internal {
+
+void HeapCensusSampler::Start(size_t sample_interval) {
+  sample_interval_ = sample_interval;
+  bytes_until_sample_ = sample_interval > 0 ? sample_interval : kDisabled;
+  samples_.clear();
+}
+
+void HeapCensusSampler::RecordSample(Map map, size_t size) {
+  DCHECK(is_enabled());
+  DCHECK_LE(bytes_until_sample_, size);
+  // Large objects may cover several sample points.
+  const size_t overshoot = size - bytes_until_sample_;
+  const size_t hits = 1 + overshoot / sample_interval_;
+  bytes_until_sample_ = sample_interval_ - overshoot % sample_interval_;
+  const double sampled_bytes = static_cast<double>(hits * sample_interval_);
+  Estimate& estimate = samples_[map.ptr()];
+  estimate.size += sampled_bytes;
+  estimate.count += sampled_bytes / size;
+}
+
+void HeapCensusSampler::Merge(HeapCensusSampler* other) {
+  for (const auto& [map, estimate] : other->samples_) {
+    Estimate& merged = samples_[map];
+    merged.count += estimate.count;
+    merged.size += estimate.size;
+  }
+  other->samples_.clear();
+}
+
+void HeapCensusSampler::Clear() {
+  sample_interval_ = 0;
+  bytes_until_sample_ = kDisabled;
+  samples_.clear();
+}
+
+void HeapCensus::Start(size_t sample_interval) {
+  DCHECK_GT(sample_interval, 0);
+  entries_.clear();
+  sample_interval_.store(sample_interval, std::memory_order_relaxed);
+}
+
+void HeapCensus::Stop() {
+  sample_interval_.store(0, std::memory_order_relaxed);
+}
+
+void HeapCensus::Finalize(const HeapCensusSampler& sampler) {
+  // The census may have been started or stopped while marking.
+  if (!sampler.is_enabled() || !is_running()) return;
+
+  std::map<std::pair<InstanceType, std::string>, HeapCensusSampler::Estimate>
+      aggregated;
+  for (const auto& [address, estimate] : sampler.samples()) {
+    Map map = Map::cast(Object(address));
+    // An object may have changed its map after it was sampled, in which case
+    // the old map may be dead.
+    if (!map.InReadOnlySpace() && !map.InAnySharedSpace() &&
+        heap_->marking_state()->IsUnmarked(map)) {
+      continue;
+    }
+    const InstanceType instance_type = map->instance_type();
+    std::string constructor_name;
+    if (InstanceTypeChecker::IsJSReceiver(instance_type)) {
+      constructor_name = ConstructorName(map);
+    }
+    HeapCensusSampler::Estimate& entry =
+        aggregated[{instance_type, std::move(constructor_name)}];
+    entry.count += estimate.count;
+    entry.size += estimate.size;
+  }
+
+  entries_.clear();
+  entries_.reserve(aggregated.size());
+  for (auto& [key, estimate] : aggregated) {
+    entries_.push_back({key.first, std::move(key.second),
+                        static_cast<size_t>(estimate.count + 0.5),
+                        static_cast<size_t>(estimate.size)});
+  }
+  std::sort(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) { return a.size > b.size; });
+}
+
+std::string HeapCensus::ConstructorName(Map map) const {
+  Object constructor = map->GetConstructor();
+  if (!IsJSFunction(constructor)) return std::string();
+  std::unique_ptr<char[]> name =
+      JSFunction::cast(constructor)->shared()->DebugNameCStr();
+  return std::string(name.get());
+}
+
+// static
+const char* HeapCensus::InstanceTypeName(InstanceType instance_type) {
+  if (InstanceTypeChecker::IsJSApiObject(instance_type)) {
+    return "JS_API_OBJECT_TYPE";
+  }
+  switch (instance_type) {
+#define INSTANCE_TYPE_NAME(TYPE) \
+  case TYPE:                     \
+    return #TYPE;
+    INSTANCE_TYPE_LIST(INSTANCE_TYPE_NAME)
+#undef INSTANCE_TYPE_NAME
+  }
+  return "UNKNOWN_TYPE";
+}
+
+}  // namespace internal
+}  // namespace v8
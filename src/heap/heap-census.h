@@ -0,0 +1,117 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HEAP_CENSUS_H_
+#define V8_HEAP_HEAP_CENSUS_H_
+
+#include <atomic>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/common/globals.h"
+#include "src/objects/instance-type.h"
+#include "src/objects/map.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Samples the objects visited by one marker thread. Every `sample_interval`
+// marked bytes one object is sampled, so an object of size s is sampled with
+// probability s / sample_interval and stands for sample_interval bytes and
+// sample_interval / s objects of its map.
+class HeapCensusSampler final {
+ public:
+  struct Estimate {
+    double count = 0;
+    double size = 0;
+  };
+  using EstimateMap = std::unordered_map<Address, Estimate>;
+
+  HeapCensusSampler() = default;
+  HeapCensusSampler(const HeapCensusSampler&) = delete;
+  HeapCensusSampler& operator=(const HeapCensusSampler&) = delete;
+
+  // Discards all samples. A `sample_interval` of 0 disables sampling.
+  void Start(size_t sample_interval);
+
+  V8_INLINE void Sample(Map map, size_t size) {
+    if (V8_LIKELY(bytes_until_sample_ > size)) {
+      bytes_until_sample_ -= size;
+      return;
+    }
+    RecordSample(map, size);
+  }
+
+  // Moves the samples of `other` into this sampler.
+  void Merge(HeapCensusSampler* other);
+  void Clear();
+
+  bool is_enabled() const { return sample_interval_ > 0; }
+  const EstimateMap& samples() const { return samples_; }
+
+ private:
+  static constexpr size_t kDisabled = std::numeric_limits<size_t>::max();
+
+  void RecordSample(Map map, size_t size);
+
+  size_t sample_interval_ = 0;
+  size_t bytes_until_sample_ = kDisabled;
+  // Keyed by map address. The maps of sampled objects are live until the
+  // census is finalized in the atomic pause.
+  EstimateMap samples_;
+};
+
+// A census of the live heap by instance type and constructor name, estimated
+// from the objects sampled during full GCs.
+class V8_EXPORT_PRIVATE HeapCensus final {
+ public:
+  struct Entry {
+    InstanceType instance_type;
+    // Empty for objects that are not JSReceivers or have no named
+    // constructor.
+    std::string constructor_name;
+    size_t count;
+    size_t size;
+  };
+
+  explicit HeapCensus(Heap* heap) : heap_(heap) {}
+  HeapCensus(const HeapCensus&) = delete;
+  HeapCensus& operator=(const HeapCensus&) = delete;
+
+  // Starts sampling from the next full GC on. Entries of a previous census
+  // are discarded.
+  void Start(size_t sample_interval);
+  void Stop();
+
+  bool is_running() const { return sample_interval() > 0; }
+  // May be called from concurrent marker threads.
+  size_t sample_interval() const {
+    return sample_interval_.load(std::memory_order_relaxed);
+  }
+
+  // Replaces the entries with the census of the current full GC. Must be
+  // called in the atomic pause after marking and before evacuation.
+  void Finalize(const HeapCensusSampler& sampler);
+
+  // Entries of the last full GC since Start(), sorted by decreasing size.
+  const std::vector<Entry>& entries() const { return entries_; }
+
+  static const char* InstanceTypeName(InstanceType instance_type);
+
+ private:
+  std::string ConstructorName(Map map) const;
+
+  Heap* const heap_;
+  std::atomic<size_t> sample_interval_{0};
+  std::vector<Entry> entries_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HEAP_CENSUS_H_
@@ -22,7 +22,7 @@
 #include "src/heap/paged-spaces.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/read-only-spaces.h"
-#include "src/heap/remembered-set.h"
+#include "src/heap/remembered-set-inl.h"
 #include "src/heap/safepoint.h"
 #include "src/objects/code-inl.h"
 #include "src/objects/code.h"
@@ -638,6 +638,12 @@ void HeapVerification::VerifyRememberedSetFor(HeapObject object) {
   CollectSlots<OLD_TO_NEW>(chunk, start, end, &old_to_new, &typed_old_to_new);
   CollectSlots<OLD_TO_NEW_BACKGROUND>(chunk, start, end, &old_to_new,
                                       &typed_old_to_new);
+  // Every slot on a dirty card counts as recorded.
+  RememberedSet<OLD_TO_NEW>::IterateCards(
+      chunk, [&old_to_new](MaybeObjectSlot slot) {
+        old_to_new.insert(slot.address());
+        return KEEP_SLOT;
+      });
 
   OldToNewSlotVerifyingVisitor old_to_new_visitor(
       isolate(), &old_to_new, &typed_old_to_new,
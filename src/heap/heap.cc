@@ -21,6 +21,7 @@
 #include "src/base/optional.h"
 #include "src/base/platform/memory.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/sys-info.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/builtins/accessors.h"
 #include "src/codegen/assembler-inl.h"
@@ -58,6 +59,8 @@
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/heap-allocator.h"
+#include "src/heap/heap-budget-coordinator.h"
+#include "src/heap/heap-census.h"
 #include "src/heap/heap-controller.h"
 #include "src/heap/heap-layout-tracer.h"
 #include "src/heap/heap-write-barrier-inl.h"
@@ -88,6 +91,7 @@
 #include "src/heap/pretenuring-handler.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/remembered-set.h"
+#include "src/heap/request-scope-nursery.h"
 #include "src/heap/safepoint.h"
 #include "src/heap/scavenger-inl.h"
 #include "src/heap/stress-scavenge-observer.h"
@@ -99,6 +103,7 @@
 #include "src/logging/log.h"
 #include "src/logging/runtime-call-stats-scope.h"
 #include "src/numbers/conversions.h"
+#include "src/objects/backing-store-pool.h"
 #include "src/objects/data-handler.h"
 #include "src/objects/feedback-vector.h"
 #include "src/objects/free-space-inl.h"
@@ -1431,6 +1436,10 @@ void Heap::GarbageCollectionEpilogue(GarbageCollector collector) {
   isolate_->counters()->alive_after_last_gc()->Set(
       static_cast<int>(SizeOfObjects()));
 
+  if (HeapBudgetCoordinator* coordinator = HeapBudgetCoordinator::Get()) {
+    coordinator->NotifyGC(this, collector);
+  }
+
   if (CommittedMemory() > 0) {
     isolate_->counters()->external_fragmentation_total()->AddSample(
         static_cast<int>(100 - (SizeOfObjects() * 100.0) / CommittedMemory()));
@@ -1966,6 +1975,13 @@ void Heap::StartIncrementalMarking(GCFlags gc_flags,
   // This helps avoid large CompleteSweep blocks on the main thread when major
   // incremental marking should be scheduled following a minor GC.
   if (sweeper()->AreMinorSweeperTasksRunning()) return;
+  // With a pause target, also leave finishing major sweeping to the
+  // background threads. Marking is started again on a later allocation.
+  if (HasGCPauseTarget() && !IsYoungGenerationCollector(collector) &&
+      gc_reason != GarbageCollectionReason::kTesting &&
+      sweeper()->AreMajorSweeperTasksRunning()) {
+    return;
+  }
 
   if (IsYoungGenerationCollector(collector)) {
     CompleteSweepingYoung();
@@ -4272,9 +4288,11 @@ bool Heap::InvokeNearHeapLimitCallback() {
     void* data = near_heap_limit_callbacks_.back().second;
     size_t heap_limit = callback(data, max_old_generation_size(),
                                  initial_max_old_generation_size_);
+    // The limit cannot grow beyond the pointer compression cage. Once it is
+    // there, a larger limit from the callback does not count as an increase.
+    heap_limit = std::min(heap_limit, AllocatorLimitOnMaxOldGenerationSize());
     if (heap_limit > max_old_generation_size()) {
-      SetOldGenerationAndGlobalMaximumSize(
-          std::min(heap_limit, AllocatorLimitOnMaxOldGenerationSize()));
+      SetOldGenerationAndGlobalMaximumSize(heap_limit);
       return true;
     }
   }
@@ -5040,9 +5058,21 @@ void Heap::ConfigureHeap(const v8::ResourceConstraints& constraints) {
 
   code_range_size_ = constraints.code_range_size_in_bytes();
 
+  if (constraints.gc_pause_target_in_ms() > 0) {
+    SetGCPauseTarget(base::TimeDelta::FromMillisecondsD(
+        constraints.gc_pause_target_in_ms()));
+  } else if (v8_flags.gc_pause_target > 0) {
+    SetGCPauseTarget(
+        base::TimeDelta::FromMillisecondsD(v8_flags.gc_pause_target));
+  }
+
   configured_ = true;
 }
 
+void Heap::SetGCPauseTarget(base::TimeDelta target) {
+  gc_pause_target_ = std::max(target, base::TimeDelta());
+}
+
 void Heap::AddToRingBuffer(const char* string) {
   size_t first_part =
       std::min(strlen(string), kTraceRingBufferSize - ring_buffer_end_);
@@ -5493,6 +5523,9 @@ void Heap::SetUp(LocalHeap* main_thread_local_heap) {
   if (v8_flags.memory_balancer) {
     mb_.reset(new MemoryBalancer(this));
   }
+  if (HeapBudgetCoordinator* coordinator = HeapBudgetCoordinator::Get()) {
+    coordinator->AddHeap(this);
+  }
 }
 
 void Heap::SetUpFromReadOnlyHeap(ReadOnlyHeap* ro_heap) {
@@ -5594,9 +5627,14 @@ void Heap::SetUpSpaces(LinearAllocationArea& new_allocation_info,
 
   tracer_.reset(new GCTracer(this));
   array_buffer_sweeper_.reset(new ArrayBufferSweeper(this));
+  if (v8_flags.backing_store_pool && isolate()->array_buffer_allocator()) {
+    backing_store_pool_ = std::make_shared<BackingStorePool>(isolate());
+  }
   gc_idle_time_handler_.reset(new GCIdleTimeHandler());
   memory_measurement_.reset(new MemoryMeasurement(isolate()));
+  heap_census_.reset(new HeapCensus(this));
   if (v8_flags.memory_reducer) memory_reducer_.reset(new MemoryReducer(this));
+  request_scope_nursery_.reset(new RequestScopeNursery(this));
   if (V8_UNLIKELY(TracingFlags::is_gc_stats_enabled())) {
     live_object_stats_.reset(new ObjectStats(this));
     dead_object_stats_.reset(new ObjectStats(this));
@@ -5673,6 +5711,11 @@ void Heap::InitializeOncePerProcess() {
   MemoryAllocator::InitializeOncePerProcess();
   if (v8_flags.predictable) {
     ::heap::base::WorklistBase::EnforcePredictableOrder();
+  } else if (v8_flags.gc_worklist_stacks != 1) {
+    const int num_stacks = v8_flags.gc_worklist_stacks > 0
+                               ? v8_flags.gc_worklist_stacks
+                               : base::SysInfo::NumberOfProcessors();
+    ::heap::base::WorklistBase::EnableWorkStealing(num_stacks);
   }
 }
 
@@ -5812,6 +5855,10 @@ void Heap::SetStackStart(void* stack_start) {
 ::heap::base::Stack& Heap::stack() { return isolate_->stack(); }
 
 void Heap::StartTearDown() {
+  if (HeapBudgetCoordinator* coordinator = HeapBudgetCoordinator::Get()) {
+    coordinator->RemoveHeap(this);
+  }
+
   // Finish any ongoing sweeping to avoid stray background tasks still accessing
   // the heap during teardown.
   CompleteSweepingFull();
@@ -5910,13 +5957,19 @@ void Heap::TearDown() {
 
   scavenger_collector_.reset();
   array_buffer_sweeper_.reset();
+  if (backing_store_pool_) {
+    backing_store_pool_->TearDown();
+    backing_store_pool_.reset();
+  }
   incremental_marking_.reset();
   concurrent_marking_.reset();
 
   gc_idle_time_handler_.reset();
   memory_measurement_.reset();
+  heap_census_.reset();
   allocation_tracker_for_debugging_.reset();
   ephemeron_remembered_set_.reset();
+  request_scope_nursery_.reset();
 
   if (memory_reducer_ != nullptr) {
     memory_reducer_->TearDown();
@@ -6099,6 +6152,17 @@ void Heap::CompactRetainedMaps(Tagged<WeakArrayList> retained_maps) {
 }
 
 void Heap::FatalProcessOutOfMemory(const char* location) {
+#ifdef V8_COMPRESS_POINTERS
+  // Raising the heap limit does not help once the old generation fills the
+  // pointer compression cage, so tell embedders why the limit was capped.
+  // ConfigureHeap rounds the capped limit down to whole pages.
+  if (max_old_generation_size() >=
+      RoundDown<Page::kPageSize>(AllocatorLimitOnMaxOldGenerationSize())) {
+    V8::FatalProcessOutOfMemory(
+        isolate(), location,
+        {true, "heap limit is capped by the pointer compression cage"});
+  }
+#endif  // V8_COMPRESS_POINTERS
   V8::FatalProcessOutOfMemory(isolate(), location, V8::kHeapOOM);
 }
 
@@ -6170,6 +6234,10 @@ int Heap::InsertIntoRememberedSetFromCode(MemoryChunk* chunk, Address slot) {
   // This is called during runtime by a builtin, therefore it is run in the main
   // thread.
   DCHECK_NULL(LocalHeap::Current());
+  if (chunk->card_table()) {
+    chunk->MarkCard(slot);
+    return 0;
+  }
   RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(chunk, slot);
   return 0;
 }
@@ -6929,7 +6997,10 @@ void Heap::CombinedGenerationalAndSharedEphemeronBarrierSlow(
 void Heap::GenerationalBarrierSlow(Tagged<HeapObject> object, Address slot,
                                    Tagged<HeapObject> value) {
   MemoryChunk* chunk = MemoryChunk::FromHeapObject(object);
-  if (LocalHeap::Current() == nullptr) {
+  if (chunk->card_table()) {
+    // Dirtying a card is safe on background threads as well.
+    chunk->MarkCard(slot);
+  } else if (LocalHeap::Current() == nullptr) {
     RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(chunk, slot);
   } else {
     RememberedSet<OLD_TO_NEW_BACKGROUND>::Insert<AccessMode::ATOMIC>(chunk,
@@ -6989,8 +7060,12 @@ void Heap::WriteBarrierForRangeImpl(MemoryChunk* source_page,
 
     if (kModeMask & kDoGenerationalOrShared) {
       if (Heap::InYoungGeneration(value_heap_object)) {
-        RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(
-            source_page, slot.address());
+        if (source_page->card_table()) {
+          source_page->MarkCard(slot.address());
+        } else {
+          RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(
+              source_page, slot.address());
+        }
       } else if (value_heap_object.InWritableSharedSpace()) {
         RememberedSet<OLD_TO_SHARED>::Insert<AccessMode::ATOMIC>(
             source_page, slot.address());
@@ -78,6 +78,7 @@ class Impl;
 class ArrayBufferCollector;
 class ArrayBufferSweeper;
 class BackingStore;
+class BackingStorePool;
 class BasicMemoryChunk;
 class Boolean;
 class CodeLargeObjectSpace;
@@ -92,6 +93,7 @@ class GCIdleTimeHeapState;
 class GCTracer;
 class IncrementalMarking;
 class IsolateSafepoint;
+class HeapCensus;
 class HeapObjectAllocationTracker;
 class HeapObjectsFilter;
 class HeapStats;
@@ -116,6 +118,7 @@ class Page;
 class PagedSpace;
 class PagedNewSpace;
 class ReadOnlyHeap;
+class RequestScopeNursery;
 class RootVisitor;
 class RwxMemoryWriteScope;
 class SafepointScope;
@@ -703,6 +706,12 @@ class Heap final {
   void ConfigureHeap(const v8::ResourceConstraints& constraints);
   void ConfigureHeapDefault();
 
+  // Sets the target duration of main-thread GC pauses. A zero target removes
+  // the target. See v8::ResourceConstraints::gc_pause_target_in_ms().
+  void SetGCPauseTarget(base::TimeDelta target);
+  base::TimeDelta gc_pause_target() const { return gc_pause_target_; }
+  bool HasGCPauseTarget() const { return !gc_pause_target_.IsZero(); }
+
   // Prepares the heap, setting up for deserialization.
   void SetUp(LocalHeap* main_thread_local_heap);
 
@@ -814,6 +823,11 @@ class Heap final {
     return array_buffer_sweeper_.get();
   }
 
+  // Null unless --backing-store-pool is enabled.
+  const std::shared_ptr<BackingStorePool>& backing_store_pool() const {
+    return backing_store_pool_;
+  }
+
   // The potentially overreserved address space region reserved by the code
   // range if it exists or empty region otherwise.
   const base::AddressRegion& code_region();
@@ -1871,6 +1885,10 @@ class Heap final {
 
   MemoryReducer* memory_reducer() { return memory_reducer_.get(); }
 
+  RequestScopeNursery* request_scope_nursery() {
+    return request_scope_nursery_.get();
+  }
+
   // For some webpages RAIL mode does not switch from PERFORMANCE_LOAD.
   // This constant limits the effect of load RAIL mode on GC.
   // The value is arbitrary and chosen as the largest load time observed in
@@ -2015,6 +2033,7 @@ class Heap final {
   std::vector<Handle<NativeContext>> FindAllNativeContexts();
   std::vector<WeakArrayList> FindAllRetainedMaps();
   MemoryMeasurement* memory_measurement() { return memory_measurement_.get(); }
+  HeapCensus* heap_census() { return heap_census_.get(); }
 
   AllocationType allocation_type_for_in_place_internalizable_strings() const {
     return allocation_type_for_in_place_internalizable_strings_;
@@ -2204,13 +2223,17 @@ class Heap final {
   std::unique_ptr<MinorMarkSweepCollector> minor_mark_sweep_collector_;
   std::unique_ptr<ScavengerCollector> scavenger_collector_;
   std::unique_ptr<ArrayBufferSweeper> array_buffer_sweeper_;
+  // Shared with the pooled backing stores, which may outlive the heap.
+  std::shared_ptr<BackingStorePool> backing_store_pool_;
 
   std::unique_ptr<MemoryAllocator> memory_allocator_;
   std::unique_ptr<IncrementalMarking> incremental_marking_;
   std::unique_ptr<ConcurrentMarking> concurrent_marking_;
   std::unique_ptr<GCIdleTimeHandler> gc_idle_time_handler_;
   std::unique_ptr<MemoryMeasurement> memory_measurement_;
+  std::unique_ptr<HeapCensus> heap_census_;
   std::unique_ptr<MemoryReducer> memory_reducer_;
+  std::unique_ptr<RequestScopeNursery> request_scope_nursery_;
   std::unique_ptr<ObjectStats> live_object_stats_;
   std::unique_ptr<ObjectStats> dead_object_stats_;
   std::unique_ptr<MinorGCJob> minor_gc_job_;
@@ -2273,6 +2296,9 @@ class Heap final {
   // configured through the API until it is set up.
   bool configured_ = false;
 
+  // Target duration of main-thread GC pauses, zero if there is none.
+  base::TimeDelta gc_pause_target_;
+
   // Currently set GC flags that are respected by all GC components.
   GCFlags current_gc_flags_ = GCFlag::kNoFlags;
   // Currently set GC callback flags that are used to pass information between
@@ -2376,6 +2402,7 @@ class Heap final {
   friend class PauseAllocationObserversScope;
   friend class PretenuringHandler;
   friend class ReadOnlyRoots;
+  friend class RequestScopeNursery;
   friend class DisableConservativeStackScanningScopeForTesting;
   friend class Scavenger;
   friend class ScavengerCollector;
@@ -2401,6 +2428,7 @@ class Heap final {
   // Used in cctest.
   friend class heap::HeapTester;
 
+  friend class HeapBudgetCoordinator;
   friend class MemoryBalancer;
 };
 
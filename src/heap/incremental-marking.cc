@@ -6,6 +6,7 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "src/base/logging.h"
@@ -61,16 +62,24 @@ static constexpr size_t kV8ActivationThreshold = 0;
 static constexpr size_t kEmbedderActivationThreshold = 0;
 #endif  // DEBUG
 
-base::TimeDelta GetMaxDuration(StepOrigin step_origin) {
+base::TimeDelta GetMaxDuration(StepOrigin step_origin,
+                               base::TimeDelta pause_target) {
   if (v8_flags.predictable) {
     return base::TimeDelta::Max();
   }
+  base::TimeDelta max_duration;
   switch (step_origin) {
     case StepOrigin::kTask:
-      return kMaxStepSizeOnTask;
+      max_duration = kMaxStepSizeOnTask;
+      break;
     case StepOrigin::kV8:
-      return kMaxStepSizeOnAllocation;
+      max_duration = kMaxStepSizeOnAllocation;
+      break;
   }
+  if (!pause_target.IsZero()) {
+    max_duration = std::min(max_duration, pause_target);
+  }
+  return max_duration;
 }
 
 }  // namespace
@@ -661,6 +670,10 @@ size_t IncrementalMarking::OldGenerationSizeOfObjects() const {
 }
 
 bool IncrementalMarking::ShouldWaitForTask() {
+  // With a pause target, finalize right away instead of waiting for the task.
+  // Any delay gives the mutator time to create more work for the atomic
+  // pause.
+  if (heap_->HasGCPauseTarget()) return false;
   if (!completion_task_scheduled_) {
     if (!incremental_marking_job()) {
       return false;
@@ -737,10 +750,23 @@ bool IncrementalMarking::TryInitializeTaskTimeout() {
 
 size_t IncrementalMarking::GetScheduledBytes(StepOrigin step_origin) {
   FetchBytesMarkedConcurrently();
+  schedule_->SetPauseTarget(
+      heap_->gc_pause_target(),
+      heap_->tracer()->IncrementalMarkingSpeedInBytesPerMillisecond());
   // TODO(v8:14140): Consider the size including young generation here as well
   // as the full marker marks both the young and old generations.
   const size_t max_bytes_to_process =
       schedule_->GetNextIncrementalStepDuration(OldGenerationSizeOfObjects());
+  if (v8_flags.concurrent_marking) {
+    const auto step_info = schedule_->GetCurrentStepInfo();
+    if (step_info.limited_by_pause_target &&
+        step_info.is_behind_expectation()) {
+      // The step was cut short to meet the pause target although marking is
+      // behind. Make up for it with more concurrent marking.
+      heap_->concurrent_marking()->RescheduleJobIfNeeded(
+          GarbageCollector::MARK_COMPACTOR, TaskPriority::kUserBlocking);
+    }
+  }
   if (V8_UNLIKELY(v8_flags.trace_incremental_marking)) {
     const auto step_info = schedule_->GetCurrentStepInfo();
     isolate()->PrintWithTimestamp(
@@ -761,8 +787,8 @@ size_t IncrementalMarking::GetScheduledBytes(StepOrigin step_origin) {
 
 void IncrementalMarking::AdvanceAndFinalizeIfComplete() {
   const size_t max_bytes_to_process = GetScheduledBytes(StepOrigin::kTask);
-  Step(GetMaxDuration(StepOrigin::kTask), max_bytes_to_process,
-       StepOrigin::kTask);
+  Step(GetMaxDuration(StepOrigin::kTask, heap_->gc_pause_target()),
+       max_bytes_to_process, StepOrigin::kTask);
   if (IsMajorMarkingComplete()) {
     heap()->FinalizeIncrementalMarkingAtomically(
         GarbageCollectionReason::kFinalizeMarkingViaTask);
@@ -805,7 +831,8 @@ void IncrementalMarking::AdvanceOnAllocation() {
   DCHECK(IsMajorMarking());
 
   const size_t max_bytes_to_process = GetScheduledBytes(StepOrigin::kV8);
-  Step(GetMaxDuration(StepOrigin::kV8), max_bytes_to_process, StepOrigin::kV8);
+  Step(GetMaxDuration(StepOrigin::kV8, heap_->gc_pause_target()),
+       max_bytes_to_process, StepOrigin::kV8);
 
   // Bail out when an AlwaysAllocateScope is active as the assumption is that
   // there's no GC being triggered. Check this condition at last position to
@@ -33,6 +33,11 @@ LargePage::LargePage(Heap* heap, BaseSpace* space, size_t chunk_size,
 
   SetFlag(MemoryChunk::LARGE_PAGE);
   list_node().Initialize();
+
+  if (v8_flags.card_marking_remembered_set &&
+      space->identity() == LO_SPACE) {
+    AllocateCardTable();
+  }
 }
 
 LargePage* LargePage::Initialize(Heap* heap, MemoryChunk* chunk,
@@ -190,6 +190,9 @@ void OldLargeObjectSpace::PromoteNewLargeObject(LargePage* page) {
   static_cast<LargeObjectSpace*>(page->owner())->RemovePage(page);
   page->ClearFlag(MemoryChunk::FROM_PAGE);
   AddPage(page, static_cast<size_t>(page->GetObject()->Size(cage_base)));
+  if (v8_flags.card_marking_remembered_set && identity() == LO_SPACE) {
+    page->AllocateCardTable();
+  }
 }
 
 void LargeObjectSpace::AddPage(LargePage* page, size_t object_size) {
@@ -36,6 +36,7 @@
 #include "src/heap/evacuation-verifier-inl.h"
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/gc-tracer.h"
+#include "src/heap/heap-census.h"
 #include "src/heap/heap.h"
 #include "src/heap/incremental-marking-inl.h"
 #include "src/heap/index-generator.h"
@@ -366,6 +367,9 @@ void MarkCompactCollector::StartMarking() {
       code_flush_mode(), heap_->cpp_heap_,
       heap_->ShouldCurrentGCKeepAgesUnchanged(),
       heap_->tracer()->CodeFlushingIncrease());
+  const size_t census_interval = heap_->heap_census()->sample_interval();
+  heap_census_sampler_.Start(census_interval);
+  heap_->concurrent_marking()->StartHeapCensus(census_interval);
   // This method evicts SFIs with flushed bytecode from the cache before
   // iterating the compilation cache as part of the root set. SFIs that get
   // flushed in this GC cycle will get evicted out of the cache in the next GC
@@ -389,6 +393,7 @@ void MarkCompactCollector::CollectGarbage() {
   // This will walk dead object graphs and so requires that all references are
   // still intact.
   RecordObjectStats();
+  heap_->heap_census()->Finalize(heap_census_sampler_);
   ClearNonLiveReferences();
   VerifyMarking();
   heap_->memory_measurement()->FinishProcessing(native_context_stats_);
@@ -700,6 +705,7 @@ void MarkCompactCollector::FinishConcurrentMarking() {
     heap_->concurrent_marking()->Join();
     heap_->concurrent_marking()->FlushMemoryChunkData();
     heap_->concurrent_marking()->FlushNativeContexts(&native_context_stats_);
+    heap_->concurrent_marking()->FlushHeapCensus(&heap_census_sampler_);
   }
   if (auto* cpp_heap = CppHeap::From(heap_->cpp_heap_)) {
     cpp_heap->FinishConcurrentMarkingIfNeeded();
@@ -804,6 +810,7 @@ void MarkCompactCollector::Finish() {
   local_marking_worklists_.reset();
   marking_worklists_.ReleaseContextWorklists();
   native_context_stats_.Clear();
+  heap_census_sampler_.Clear();
 
   CHECK(weak_objects_.current_ephemerons.IsEmpty());
   CHECK(weak_objects_.discovered_ephemerons.IsEmpty());
@@ -2186,6 +2193,7 @@ std::pair<size_t, size_t> MarkCompactCollector::ProcessMarkingWorklist(
     if (visited_size) {
       MemoryChunk::FromHeapObject(object)->IncrementLiveBytesAtomically(
           ALIGN_TO_ALLOCATION_ALIGNMENT(visited_size));
+      heap_census_sampler_.Sample(map, visited_size);
     }
     if (is_per_context_mode) {
       native_context_stats_.IncrementSize(local_marking_worklists_->Context(),
@@ -4596,6 +4604,7 @@ class RememberedSetUpdatingItem : public UpdatingItem {
   void UpdateUntypedPointers() {
     UpdateUntypedOldToNewPointers<OLD_TO_NEW>();
     UpdateUntypedOldToNewPointers<OLD_TO_NEW_BACKGROUND>();
+    UpdateCardTableOldToNewPointers();
     UpdateUntypedOldToOldPointers();
     UpdateUntypedOldToCodePointers();
   }
@@ -4627,6 +4636,21 @@ class RememberedSetUpdatingItem : public UpdatingItem {
     chunk_->ReleaseSlotSet(old_to_new_type);
   }
 
+  void UpdateCardTableOldToNewPointers() {
+    const PtrComprCageBase cage_base = heap_->isolate();
+    RememberedSet<OLD_TO_NEW>::IterateCards(
+        chunk_, [this, cage_base](MaybeObjectSlot slot) {
+          CheckAndUpdateOldToNewSlot(slot);
+          // A new space string might have been promoted into the shared heap
+          // during GC.
+          if (record_old_to_shared_slots_) {
+            CheckSlotForOldToSharedUntyped(cage_base, chunk_, slot);
+          }
+          // Full GCs will empty new space, so all cards end up clean.
+          return REMOVE_SLOT;
+        });
+  }
+
   void UpdateUntypedOldToOldPointers() {
     if (chunk_->slot_set<OLD_TO_OLD, AccessMode::NON_ATOMIC>()) {
       const PtrComprCageBase cage_base = heap_->isolate();
@@ -9,6 +9,7 @@
 
 #include "include/v8-internal.h"
 #include "src/common/globals.h"
+#include "src/heap/heap-census.h"
 #include "src/heap/marking-state.h"
 #include "src/heap/marking-visitor.h"
 #include "src/heap/marking-worklist.h"
@@ -360,6 +361,7 @@ class MarkCompactCollector final {
   std::unique_ptr<WeakObjects::Local> local_weak_objects_;
   NativeContextInferrer native_context_inferrer_;
   NativeContextStats native_context_stats_;
+  HeapCensusSampler heap_census_sampler_;
 
   std::vector<GlobalHandleVector<DescriptorArray>> strong_descriptor_arrays_;
   base::Mutex strong_descriptor_arrays_mutex_;
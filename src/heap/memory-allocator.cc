@@ -214,14 +214,17 @@ size_t MemoryAllocator::Unmapper::CommittedBufferedMemory() {
   base::MutexGuard guard(&mutex_);
 
   size_t sum = 0;
-  // kPooled chunks are already uncommited. We only have to account for
-  // kRegular and kNonRegular chunks.
+  // kPooled chunks are already uncommited unless huge pages are kept. We only
+  // have to account for kRegular and kNonRegular chunks.
   for (auto& chunk : chunks_[ChunkQueueType::kRegular]) {
     sum += chunk->size();
   }
   for (auto& chunk : chunks_[ChunkQueueType::kNonRegular]) {
     sum += chunk->size();
   }
+  if (v8_flags.transparent_huge_pages) {
+    sum += chunks_[ChunkQueueType::kPooled].size() * MemoryChunk::kPageSize;
+  }
   return sum;
 }
 
@@ -545,7 +548,8 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
 
   VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
-    UncommitMemory(reservation);
+    // Uncommitting a pooled page would split the huge page backing it.
+    if (!v8_flags.transparent_huge_pages) UncommitMemory(reservation);
   } else {
     DCHECK(reservation->IsReserved());
     reservation->Free();
@@ -558,6 +562,12 @@ void MemoryAllocator::Free(MemoryAllocator::FreeMode mode, MemoryChunk* chunk) {
   } else {
     RecordNormalPageDestroyed(*Page::cast(chunk));
   }
+  if (v8_flags.transparent_huge_pages && mode == FreeMode::kConcurrently &&
+      !chunk->IsLargePage() && chunk->executable() == NOT_EXECUTABLE &&
+      chunk->size() == static_cast<size_t>(MemoryChunk::kPageSize)) {
+    // Freeing the page would split the huge page backing it.
+    mode = FreeMode::kConcurrentlyAndPool;
+  }
   switch (mode) {
     case FreeMode::kImmediately:
       PreFreeMemory(chunk);
@@ -588,12 +598,19 @@ Page* MemoryAllocator::AllocatePage(MemoryAllocator::AllocationMode alloc_mode,
   size_t size =
       MemoryChunkLayout::AllocatableMemoryInMemoryChunk(space->identity());
   base::Optional<MemoryChunkAllocationResult> chunk_info;
-  if (alloc_mode == AllocationMode::kUsePool) {
+  // With transparent huge pages, all data pages come from the pool, which is
+  // refilled with the pages of a whole huge page at a time.
+  if (alloc_mode == AllocationMode::kUsePool ||
+      (v8_flags.transparent_huge_pages && executable == NOT_EXECUTABLE)) {
     DCHECK_EQ(size, static_cast<size_t>(
                         MemoryChunkLayout::AllocatableMemoryInMemoryChunk(
                             space->identity())));
     DCHECK_EQ(executable, NOT_EXECUTABLE);
     chunk_info = AllocateUninitializedPageFromPool(space);
+    if (!chunk_info && v8_flags.transparent_huge_pages &&
+        PoolPagesOfNewHugePage()) {
+      chunk_info = AllocateUninitializedPageFromPool(space);
+    }
   }
 
   if (!chunk_info) {
@@ -672,6 +689,10 @@ MemoryAllocator::AllocateUninitializedPageFromPool(Space* space) {
   if (!CommitMemory(&reservation, NOT_EXECUTABLE)) return {};
   if (heap::ShouldZapGarbage()) {
     heap::ZapBlock(start, size, kZapValue);
+  } else if (v8_flags.transparent_huge_pages) {
+    // The page was not uncommitted when it was pooled, so the header still
+    // holds the state of its previous use.
+    memset(chunk, 0, area_start - start);
   }
 
   size_ += size;
@@ -680,6 +701,50 @@ MemoryAllocator::AllocateUninitializedPageFromPool(Space* space) {
   };
 }
 
+bool MemoryAllocator::PoolPagesOfNewHugePage() {
+  DCHECK(v8_flags.transparent_huge_pages);
+  constexpr size_t kPagesPerHugePage = kHugePageSize / MemoryChunk::kPageSize;
+  // With ENABLE_HUGEPAGE, every page is a huge page already.
+  if (kPagesPerHugePage <= 1) return false;
+
+  v8::PageAllocator* page_allocator = data_page_allocator();
+  void* hint = nullptr;
+#ifndef V8_COMPRESS_POINTERS
+  hint = AlignedAddress(isolate_->heap()->GetRandomMmapAddr(), kHugePageSize);
+#endif
+  // Pooled pages are freed one at a time, so they need reservations of their
+  // own. Find a free range that is aligned to a huge page first and then
+  // reserve its pages one by one.
+  Address base;
+  {
+    VirtualMemory range(page_allocator, kHugePageSize, hint, kHugePageSize);
+    if (!range.IsReserved()) return false;
+    base = range.address();
+  }
+
+  size_t pooled = 0;
+  for (size_t i = 0; i < kPagesPerHugePage; i++) {
+    const Address start = base + i * MemoryChunk::kPageSize;
+    VirtualMemory reservation(page_allocator, MemoryChunk::kPageSize,
+                              reinterpret_cast<void*>(start),
+                              MemoryChunk::kAlignment);
+    // Another allocation may have taken part of the range in the meantime.
+    if (!reservation.IsReserved() || reservation.address() != start) break;
+    // Commit the whole page up front, like a pooled page that was kept
+    // committed, so that the huge page is backed as soon as it is touched.
+    if (!reservation.SetPermissions(start, MemoryChunk::kPageSize,
+                                    PageAllocator::kReadWrite)) {
+      break;
+    }
+    // The pool owns the page from now on.
+    reservation.Reset();
+    unmapper()->AddMemoryChunkSafe(Unmapper::ChunkQueueType::kPooled,
+                                   reinterpret_cast<MemoryChunk*>(start));
+    pooled++;
+  }
+  return pooled > 0;
+}
+
 void MemoryAllocator::InitializeOncePerProcess() {
   commit_page_size_ = v8_flags.v8_os_page_size > 0
                           ? v8_flags.v8_os_page_size * KB
@@ -360,6 +360,11 @@ class MemoryAllocator {
   base::Optional<MemoryChunkAllocationResult> AllocateUninitializedPageFromPool(
       Space* space);
 
+  // Reserves and commits the regular pages that make up one huge page and
+  // adds them to the pool, so that the kernel can back them with a single
+  // transparent huge page. Returns false if no page could be added.
+  bool PoolPagesOfNewHugePage();
+
   // Frees a pooled page. Only used on tear-down and last-resort GCs.
   void FreePooledChunk(MemoryChunk* chunk);
 
@@ -4,6 +4,8 @@
 
 #include "src/heap/memory-chunk.h"
 
+#include <algorithm>
+
 #include "src/base/logging.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
@@ -207,6 +209,7 @@ void MemoryChunk::ReleaseAllocatedMemoryNeededForWritableChunk() {
   ReleaseTypedSlotSet(OLD_TO_NEW);
   ReleaseTypedSlotSet(OLD_TO_OLD);
   ReleaseTypedSlotSet(OLD_TO_SHARED);
+  ReleaseCardTable();
 
   if (!IsLargePage()) {
     Page* page = static_cast<Page*>(this);
@@ -258,13 +261,32 @@ void MemoryChunk::ReleaseTypedSlotSet(RememberedSetType type) {
   }
 }
 
+void MemoryChunk::AllocateCardTable() {
+  DCHECK(IsLargePage());
+  DCHECK_NULL(card_table_);
+  card_table_ = new uint8_t[cards()]();
+}
+
+void MemoryChunk::ReleaseCardTable() {
+  if (card_table_) {
+    delete[] card_table_;
+    card_table_ = nullptr;
+  }
+}
+
+bool MemoryChunk::HasDirtyCards() const {
+  if (!card_table_) return false;
+  return std::any_of(card_table_, card_table_ + cards(),
+                     [](uint8_t card) { return card != kCleanCard; });
+}
+
 bool MemoryChunk::ContainsAnySlots() const {
   for (int rs_type = 0; rs_type < NUMBER_OF_REMEMBERED_SET_TYPES; rs_type++) {
     if (slot_set_[rs_type] || typed_slot_set_[rs_type]) {
       return true;
     }
   }
-  return false;
+  return HasDirtyCards();
 }
 
 void MemoryChunk::ClearLiveness() {
@@ -285,6 +307,8 @@ void MemoryChunk::ValidateOffsets(MemoryChunk* chunk) {
   DCHECK_EQ(
       reinterpret_cast<Address>(&chunk->typed_slot_set_) - chunk->address(),
       MemoryChunkLayout::kTypedSlotSetOffset);
+  DCHECK_EQ(reinterpret_cast<Address>(&chunk->card_table_) - chunk->address(),
+            MemoryChunkLayout::kCardTableOffset);
   DCHECK_EQ(reinterpret_cast<Address>(&chunk->mutex_) - chunk->address(),
             MemoryChunkLayout::kMutexOffset);
   DCHECK_EQ(reinterpret_cast<Address>(&chunk->shared_mutex_) - chunk->address(),
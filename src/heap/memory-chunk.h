@@ -46,6 +46,12 @@ class MemoryChunk : public BasicMemoryChunk {
 
   static const intptr_t kOldToNewSlotSetOffset =
       MemoryChunkLayout::kSlotSetOffset;
+  static const intptr_t kCardTableOffset = MemoryChunkLayout::kCardTableOffset;
+
+  // A card of the card table covers 2^kCardSizeLog2 bytes of the chunk.
+  static constexpr int kCardSizeLog2 = 9;
+  static constexpr uint8_t kCleanCard = 0;
+  static constexpr uint8_t kDirtyCard = 1;
 
   // Page size in bytes.  This must be a multiple of the OS page size.
   static const int kPageSize = 1 << kPageSizeBits;
@@ -159,6 +165,27 @@ class MemoryChunk : public BasicMemoryChunk {
     return typed_slot_set;
   }
 
+  // Large old pages record old-to-new slots in a byte-per-card table instead
+  // of the OLD_TO_NEW slot set when --card-marking-remembered-set is enabled.
+  // The collectors scan the slots on dirty cards directly, see
+  // RememberedSet<OLD_TO_NEW>::IterateCards().
+  uint8_t* card_table() const { return card_table_; }
+  size_t cards() const {
+    return (size() + (size_t{1} << kCardSizeLog2) - 1) >> kCardSizeLog2;
+  }
+  bool HasDirtyCards() const;
+  void AllocateCardTable();
+  // Not safe to be called concurrently.
+  void ReleaseCardTable();
+
+  // Dirties the card of `slot`. May be called concurrently.
+  void MarkCard(Address slot) {
+    DCHECK_NOT_NULL(card_table_);
+    DCHECK(Contains(slot));
+    base::AsAtomic8::Relaxed_Store(
+        &card_table_[(slot - address()) >> kCardSizeLog2], kDirtyCard);
+  }
+
   int FreeListsLength();
 
   // Approximate amount of physical memory committed for this chunk.
@@ -308,6 +335,10 @@ class MemoryChunk : public BasicMemoryChunk {
   // is ceil(size() / kPageSize).
   TypedSlotSet* typed_slot_set_[NUMBER_OF_REMEMBERED_SET_TYPES] = {nullptr};
 
+  // One byte per card, non-zero for dirty cards. Only allocated for large
+  // old pages, see card_table().
+  uint8_t* card_table_ = nullptr;
+
   // Used by the marker to keep track of the scanning progress in large objects
   // that have a progress bar and are scanned in increments.
   class ProgressBar progress_bar_;
@@ -663,6 +663,34 @@ void SemiSpaceNewSpace::ResetParkedAllocationBuffers() {
   parked_allocation_buffers_.clear();
 }
 
+bool SemiSpaceNewSpace::StartAllocationOnFreshPage() {
+  if (top() != to_space_.page_low() && !AddFreshPage()) return false;
+  ResetParkedAllocationBuffers();
+  return true;
+}
+
+bool SemiSpaceNewSpace::RewindAllocationTo(Page* page, size_t capacity) {
+  size_t expected_capacity = capacity;
+  for (Page* p = page; p != to_space_.current_page(); p = p->next_page()) {
+    if (p->next_page() == nullptr) return false;
+    expected_capacity += Page::kPageSize;
+  }
+  if (expected_capacity != to_space_.current_capacity()) return false;
+
+  // Parked buffers may point into the dropped pages.
+  ResetParkedAllocationBuffers();
+  if (heap::ShouldZapGarbage()) {
+    for (Page* p = page; p != to_space_.current_page(); p = p->next_page()) {
+      heap::ZapBlock(p->area_start(), p->area_size(), heap::ZapValue());
+    }
+    heap::ZapBlock(to_space_.page_low(), top() - to_space_.page_low(),
+                   heap::ZapValue());
+  }
+  to_space_.RewindTo(page, capacity);
+  UpdateLinearAllocationArea();
+  return true;
+}
+
 void SemiSpaceNewSpace::FreeLinearAllocationArea() {
   AdvanceAllocationObservers();
   MakeLinearAllocationAreaIterable();
@@ -100,6 +100,13 @@ class SemiSpace final : public Space {
   // Resets the space to using the first page.
   void Reset();
 
+  // Makes `page` the current page again. `capacity` is the current capacity
+  // at the time `page` became the current page.
+  void RewindTo(Page* page, size_t capacity) {
+    current_page_ = page;
+    current_capacity_ = capacity;
+  }
+
   void RemovePage(Page* page);
   void PrependPage(Page* page);
   void MovePageToTheEnd(Page* page);
@@ -428,6 +435,18 @@ class V8_EXPORT_PRIVATE SemiSpaceNewSpace final : public NewSpace {
   bool AddParkedAllocationBuffer(int size_in_bytes,
                                  AllocationAlignment alignment);
 
+  // Continues allocation at the start of a fresh page unless the current page
+  // is still empty, and drops parked allocation buffers. Everything allocated
+  // afterwards lives on the current page and the pages following it. Returns
+  // false if there is no page left.
+  bool StartAllocationOnFreshPage();
+
+  // Drops everything allocated since StartAllocationOnFreshPage() left
+  // `page` as the current page with `capacity` as the current capacity, and
+  // continues allocation at the start of `page`. Returns false if the pages
+  // have been reordered in the meantime.
+  bool RewindAllocationTo(Page* page, size_t capacity);
+
   void ResetParkedAllocationBuffers();
 
   // Creates a filler object in the linear allocation area and closes it.
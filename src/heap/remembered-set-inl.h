@@ -5,14 +5,102 @@
 #ifndef V8_HEAP_REMEMBERED_SET_INL_H_
 #define V8_HEAP_REMEMBERED_SET_INL_H_
 
+#include <algorithm>
+
 #include "src/codegen/assembler-inl.h"
 #include "src/common/ptr-compr-inl.h"
+#include "src/heap/large-page.h"
 #include "src/heap/remembered-set.h"
 #include "src/objects/heap-object.h"
+#include "src/objects/objects-body-descriptors-inl.h"
+#include "src/objects/visitors-inl.h"
 
 namespace v8 {
 namespace internal {
 
+// Passes the slots on dirty cards to the callback of
+// RememberedSet<OLD_TO_NEW>::IterateCards() and re-dirties the cards on which
+// a slot is kept.
+template <typename Callback>
+class CardTableSlotVisitor final : public ObjectVisitorWithCageBases {
+ public:
+  // Marks a card that was dirty when the iteration started.
+  static constexpr uint8_t kScannedCard = 2;
+
+  CardTableSlotVisitor(MemoryChunk* chunk, Callback callback)
+      : ObjectVisitorWithCageBases(chunk->heap()),
+        chunk_(chunk),
+        cards_(chunk->card_table()),
+        callback_(callback) {}
+
+  void VisitPointers(HeapObject host, ObjectSlot start, ObjectSlot end) final {
+    VisitPointersImpl(start, end);
+  }
+
+  void VisitPointers(HeapObject host, MaybeObjectSlot start,
+                     MaybeObjectSlot end) final {
+    VisitPointersImpl(start, end);
+  }
+
+  void VisitInstructionStreamPointer(Code host,
+                                     InstructionStreamSlot slot) final {
+    // Only large old pages have card tables, code lives in its own spaces.
+    UNREACHABLE();
+  }
+
+  void VisitEphemeron(HeapObject host, int index, ObjectSlot key,
+                      ObjectSlot value) final {
+    // Young keys are recorded in the ephemeron remembered set.
+    VisitPointer(host, value);
+  }
+
+  void VisitMapPointer(HeapObject host) final {}
+
+ private:
+  template <typename TSlot>
+  void VisitPointersImpl(TSlot start, TSlot end) {
+    constexpr size_t kCardSize = size_t{1} << MemoryChunk::kCardSizeLog2;
+    const Address chunk_start = chunk_->address();
+    TSlot slot = start;
+    while (slot < end) {
+      const size_t card =
+          (slot.address() - chunk_start) >> MemoryChunk::kCardSizeLog2;
+      const TSlot card_end =
+          std::min(end, TSlot(chunk_start + (card + 1) * kCardSize));
+      if (cards_[card] != MemoryChunk::kCleanCard) {
+        for (; slot < card_end; ++slot) {
+          if (callback_(MaybeObjectSlot(slot.address())) == KEEP_SLOT) {
+            cards_[card] = MemoryChunk::kDirtyCard;
+          }
+        }
+      }
+      slot = card_end;
+    }
+  }
+
+  MemoryChunk* const chunk_;
+  uint8_t* const cards_;
+  Callback callback_;
+};
+
+template <RememberedSetType type>
+template <typename Callback>
+void RememberedSet<type>::IterateCards(MemoryChunk* chunk, Callback callback) {
+  static_assert(type == OLD_TO_NEW);
+  using Visitor = CardTableSlotVisitor<Callback>;
+  if (!chunk->HasDirtyCards()) return;
+  uint8_t* cards = chunk->card_table();
+  uint8_t* cards_end = cards + chunk->cards();
+  std::replace(cards, cards_end, MemoryChunk::kDirtyCard,
+               Visitor::kScannedCard);
+  Visitor visitor(chunk, callback);
+  LargePage::cast(chunk)->GetObject()->IterateBodyFast(visitor.cage_base(),
+                                                       &visitor);
+  // Cards without a slot to keep are clean now.
+  std::replace(cards, cards_end, Visitor::kScannedCard,
+               MemoryChunk::kCleanCard);
+}
+
 template <typename Callback>
 SlotCallbackResult UpdateTypedSlotHelper::UpdateTypedSlot(Heap* heap,
                                                           SlotType slot_type,
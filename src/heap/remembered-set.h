@@ -230,6 +230,13 @@ class RememberedSet : public AllStatic {
     return false;
   }
 
+  // Calls `callback` for every tagged slot on a dirty card of the large old
+  // page `chunk`, see MemoryChunk::card_table(). A card stays dirty only if
+  // the callback returns KEEP_SLOT for one of its slots. Must be called in a
+  // safepoint and not concurrently for the same page.
+  template <typename Callback>
+  static inline void IterateCards(MemoryChunk* chunk, Callback callback);
+
   // Given a page and a typed slot in that page, this function adds the slot
   // to the remembered set.
   static void InsertTyped(MemoryChunk* memory_chunk, SlotType slot_type,
@@ -0,0 +1,237 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/request-scope-nursery.h"
+
+#include <unordered_set>
+#include <utility>
+
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles.h"
+#include "src/handles/traced-handles.h"
+#include "src/heap/ephemeron-remembered-set.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/incremental-marking.h"
+#include "src/heap/large-spaces.h"
+#include "src/heap/new-spaces.h"
+#include "src/heap/paged-spaces.h"
+#include "src/heap/remembered-set-inl.h"
+#include "src/heap/safepoint.h"
+#include "src/objects/objects-body-descriptors-inl.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/visitors-inl.h"
+#include "src/objects/visitors.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Looks for pointers into the pages of a request scope, both from roots and
+// from the bodies of objects outside of these pages.
+class EscapeVisitor final : public ObjectVisitorWithCageBases,
+                            public RootVisitor {
+ public:
+  EscapeVisitor(Heap* heap, std::unordered_set<const MemoryChunk*> pages)
+      : ObjectVisitorWithCageBases(heap), pages_(std::move(pages)) {}
+
+  bool escaped() const { return escaped_; }
+
+  void CheckObject(Object object) {
+    HeapObject heap_object;
+    if (object.GetHeapObject(&heap_object)) CheckHeapObject(heap_object);
+  }
+
+  void CheckMaybeObject(MaybeObject object) {
+    HeapObject heap_object;
+    if (object.GetHeapObject(&heap_object)) CheckHeapObject(heap_object);
+  }
+
+  void CheckHeapObject(HeapObject object) {
+    if (Heap::InYoungGeneration(object) &&
+        pages_.count(MemoryChunk::FromHeapObject(object)) > 0) {
+      escaped_ = true;
+    }
+  }
+
+  void VisitRootPointers(Root root, const char* description,
+                         FullObjectSlot start, FullObjectSlot end) final {
+    for (FullObjectSlot p = start; p < end; ++p) CheckObject(*p);
+  }
+
+  void VisitPointers(HeapObject host, ObjectSlot start,
+                     ObjectSlot end) final {
+    for (ObjectSlot p = start; p < end; ++p) CheckObject(p.load(cage_base()));
+  }
+
+  void VisitPointers(HeapObject host, MaybeObjectSlot start,
+                     MaybeObjectSlot end) final {
+    for (MaybeObjectSlot p = start; p < end; ++p) {
+      CheckMaybeObject(p.load(cage_base()));
+    }
+  }
+
+  // InstructionStream objects and maps are never young.
+  void VisitInstructionStreamPointer(Code host,
+                                     InstructionStreamSlot slot) final {}
+  void VisitMapPointer(HeapObject host) final {}
+
+ private:
+  const std::unordered_set<const MemoryChunk*> pages_;
+  bool escaped_ = false;
+};
+
+}  // namespace
+
+void RequestScopeNursery::Enter() {
+  if (depth_++ > 0) return;
+  DCHECK(!IsActive());
+  if (!CanStart()) return;
+
+  SemiSpaceNewSpace* new_space = SemiSpaceNewSpace::From(heap_->new_space());
+  if (!new_space->StartAllocationOnFreshPage()) return;
+  first_page_ = new_space->to_space().current_page();
+  capacity_at_start_ = new_space->to_space().current_capacity();
+  gc_count_at_start_ = heap_->gc_count();
+}
+
+bool RequestScopeNursery::Exit() {
+  DCHECK_GT(depth_, 0);
+  if (--depth_ > 0 || !IsActive()) return false;
+
+  const bool discarded = TryDiscard();
+  if (discarded) {
+    discarded_scopes_++;
+  } else {
+    escaped_scopes_++;
+  }
+  first_page_ = nullptr;
+  return discarded;
+}
+
+bool RequestScopeNursery::CanStart() const {
+  if (!v8_flags.request_scope_nursery) return false;
+  // Only the semi-space new space allocates linearly across its pages.
+  if (v8_flags.minor_ms || !heap_->new_space()) return false;
+  // Pointers from the native stack can only be found conservatively.
+  if (v8_flags.conservative_stack_scanning) return false;
+  if (heap_->gc_state() != Heap::NOT_IN_GC ||
+      !heap_->deserialization_complete()) {
+    return false;
+  }
+  // Marking may push young objects onto its worklists.
+  if (!heap_->incremental_marking()->IsStopped()) return false;
+  // Young large objects would have to be scanned as well.
+  if (heap_->new_lo_space()->Size() > 0) return false;
+  // Object move and allocation trackers expect objects to die in a GC.
+  if (heap_->isolate()->log_object_relocation() ||
+      heap_->has_heap_object_allocation_tracker()) {
+    return false;
+  }
+  return heap_->new_space()->Size() <= kMaxScannedYoungBytes;
+}
+
+bool RequestScopeNursery::HasEscapes() const {
+  SemiSpaceNewSpace* new_space = SemiSpaceNewSpace::From(heap_->new_space());
+  std::unordered_set<const MemoryChunk*> pages;
+  for (Page* page = first_page_;; page = page->next_page()) {
+    if (page == nullptr) return true;
+    pages.insert(page);
+    if (page == new_space->to_space().current_page()) break;
+  }
+  EscapeVisitor visitor(heap_, std::move(pages));
+
+  // Roots, including weak global and traced handles. Weak references from
+  // the string table only point to old internalized strings.
+  heap_->IterateRoots(
+      &visitor,
+      {SkipRoot::kExternalStringTable, SkipRoot::kGlobalHandles,
+       SkipRoot::kTracedHandles, SkipRoot::kOldGeneration,
+       SkipRoot::kConservativeStack, SkipRoot::kReadOnlyBuiltins,
+       SkipRoot::kWeak});
+  Isolate* isolate = heap_->isolate();
+  isolate->global_handles()->IterateAllYoungRoots(&visitor);
+  isolate->traced_handles()->IterateYoung(&visitor);
+  // External strings need to be finalized by a GC.
+  heap_->external_string_table_.IterateYoung(&visitor);
+  visitor.CheckObject(heap_->allocation_sites_list());
+  visitor.CheckObject(heap_->dirty_js_finalization_registries_list());
+  visitor.CheckObject(heap_->dirty_js_finalization_registries_list_tail());
+  if (visitor.escaped()) return true;
+
+  // Old objects pointing into the scope are found through the remembered
+  // sets and card tables that the write barrier maintains.
+  OldGenerationMemoryChunkIterator::ForAll(
+      heap_, [this, &visitor](MemoryChunk* chunk) {
+        auto check_slot = [&visitor](MaybeObjectSlot slot) {
+          visitor.CheckMaybeObject(*slot);
+          return KEEP_SLOT;
+        };
+        RememberedSet<OLD_TO_NEW>::Iterate(chunk, check_slot,
+                                           SlotSet::KEEP_EMPTY_BUCKETS);
+        RememberedSet<OLD_TO_NEW_BACKGROUND>::Iterate(
+            chunk, check_slot, SlotSet::KEEP_EMPTY_BUCKETS);
+        RememberedSet<OLD_TO_NEW>::IterateCards(chunk, check_slot);
+        RememberedSet<OLD_TO_NEW>::IterateTyped(
+            chunk, [this, &visitor](SlotType slot_type, Address slot) {
+              visitor.CheckHeapObject(UpdateTypedSlotHelper::GetTargetObject(
+                  heap_, slot_type, slot));
+              return KEEP_SLOT;
+            });
+      });
+  for (auto& entry : *heap_->ephemeron_remembered_set()->tables()) {
+    EphemeronHashTable table = entry.first;
+    for (int index : entry.second) {
+      visitor.CheckObject(*table->RawFieldOfElementAt(
+          EphemeronHashTable::EntryToIndex(InternalIndex(index))));
+    }
+  }
+  if (visitor.escaped()) return true;
+
+  // Young-to-young pointers are not recorded, so the young objects allocated
+  // before the scope are scanned instead. These pages end in a filler and
+  // are iterable.
+  PtrComprCageBase cage_base(isolate);
+  for (Page* page = new_space->to_space().first_page(); page != first_page_;
+       page = page->next_page()) {
+    Address current = page->area_start();
+    while (current < page->area_end()) {
+      HeapObject object = HeapObject::FromAddress(current);
+      const int size = object->Size(cage_base);
+      object->Iterate(cage_base, &visitor);
+      current += ALIGN_TO_ALLOCATION_ALIGNMENT(size);
+    }
+  }
+  return visitor.escaped();
+}
+
+bool RequestScopeNursery::TryDiscard() {
+  // A GC moved the objects of the scope, or marking may have visited them.
+  if (heap_->gc_count() != gc_count_at_start_ ||
+      !heap_->incremental_marking()->IsStopped() ||
+      heap_->new_lo_space()->Size() > 0) {
+    return false;
+  }
+
+  IsolateSafepointScope safepoint_scope(heap_);
+  if (HasEscapes()) return false;
+
+  SemiSpaceNewSpace* new_space = SemiSpaceNewSpace::From(heap_->new_space());
+  const size_t size_before = new_space->Size();
+  if (!new_space->RewindAllocationTo(first_page_, capacity_at_start_)) {
+    return false;
+  }
+  const size_t discarded_bytes = size_before - new_space->Size();
+  // The allocation counter must not go backwards.
+  heap_->new_space_allocation_counter_ += discarded_bytes;
+  if (V8_UNLIKELY(v8_flags.trace_gc_verbose)) {
+    heap_->isolate()->PrintWithTimestamp(
+        "Request scope dropped %zuKB of young objects\n",
+        discarded_bytes / KB);
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,62 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_REQUEST_SCOPE_NURSERY_H_
+#define V8_HEAP_REQUEST_SCOPE_NURSERY_H_
+
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class Page;
+
+// Backs v8::Isolate::RequestScope. Young objects allocated in the outermost
+// scope start on a fresh page of the semi-space new space. When the scope
+// ends and nothing outside of these pages points into them, the pages are
+// handed back to the allocator without a GC. "Outside" covers the roots, the
+// old-to-new and ephemeron remembered sets, and the young objects allocated
+// before the scope. Otherwise the objects are left to the next regular minor
+// GC.
+class RequestScopeNursery final {
+ public:
+  explicit RequestScopeNursery(Heap* heap) : heap_(heap) {}
+
+  RequestScopeNursery(const RequestScopeNursery&) = delete;
+  RequestScopeNursery& operator=(const RequestScopeNursery&) = delete;
+
+  void Enter();
+  // Returns true if the young objects of the scope were dropped.
+  bool Exit();
+
+  bool IsActive() const { return first_page_ != nullptr; }
+
+  size_t discarded_scopes() const { return discarded_scopes_; }
+  size_t escaped_scopes() const { return escaped_scopes_; }
+
+ private:
+  // Checking for escapes scans the young objects allocated before the scope.
+  // Above this size, leaving the objects to a scavenge is likely cheaper.
+  static constexpr size_t kMaxScannedYoungBytes = 1 * MB;
+
+  bool CanStart() const;
+  bool HasEscapes() const;
+  bool TryDiscard();
+
+  Heap* const heap_;
+  int depth_ = 0;
+  // The first page of the outermost scope, or nullptr if the scope does not
+  // use the nursery.
+  Page* first_page_ = nullptr;
+  size_t capacity_at_start_ = 0;
+  int gc_count_at_start_ = 0;
+  size_t discarded_scopes_ = 0;
+  size_t escaped_scopes_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_REQUEST_SCOPE_NURSERY_H_
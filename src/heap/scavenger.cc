@@ -338,7 +338,8 @@ void ScavengerCollector::CollectGarbage() {
         heap_, [&memory_chunks](MemoryChunk* chunk) {
           if (chunk->slot_set<OLD_TO_NEW>() ||
               chunk->typed_slot_set<OLD_TO_NEW>() ||
-              chunk->slot_set<OLD_TO_NEW_BACKGROUND>()) {
+              chunk->slot_set<OLD_TO_NEW_BACKGROUND>() ||
+              chunk->HasDirtyCards()) {
             memory_chunks.emplace_back(ParallelWorkItem{}, chunk);
           }
         });
@@ -714,6 +715,19 @@ void Scavenger::ScavengePage(MemoryChunk* page) {
         },
         &empty_chunks_local_);
   }
+
+  // Large old pages with a card table are scanned card by card. Cards without
+  // young pointers left are cleaned.
+  RememberedSet<OLD_TO_NEW>::IterateCards(
+      page, [this, page, record_old_to_shared_slots](MaybeObjectSlot slot) {
+        SlotCallbackResult result = CheckAndScavengeObject(heap_, slot);
+        // A new space string might have been promoted into the shared heap
+        // during GC.
+        if (result == REMOVE_SLOT && record_old_to_shared_slots) {
+          CheckOldToNewSlotForSharedUntyped(page, slot);
+        }
+        return result;
+      });
 }
 
 void Scavenger::Process(JobDelegate* delegate) {
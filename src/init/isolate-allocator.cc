@@ -81,6 +81,7 @@ void IsolateAllocator::InitializeOncePerProcess() {
         "Failed to reserve virtual memory for process-wide V8 "
         "pointer compression cage");
   }
+  AdviseTransparentHugePages(GetProcessWidePtrComprCage()->region());
   V8HeapCompressionScheme::InitBase(GetProcessWidePtrComprCage()->base());
 #ifdef V8_EXTERNAL_CODE_SPACE
   // Speculatively set the code cage base to the same value in case jitless
@@ -99,6 +100,7 @@ IsolateAllocator::IsolateAllocator() {
         nullptr,
         "Failed to reserve memory for Isolate V8 pointer compression cage");
   }
+  AdviseTransparentHugePages(isolate_ptr_compr_cage_.region());
   page_allocator_ = isolate_ptr_compr_cage_.page_allocator();
 #elif defined(V8_COMPRESS_POINTERS_IN_SHARED_CAGE)
   CHECK(GetProcessWidePtrComprCage()->IsReserved());
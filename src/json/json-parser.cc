@@ -4,6 +4,7 @@
 
 #include "src/json/json-parser.h"
 
+#include "src/base/bits.h"
 #include "src/base/strings.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
@@ -11,6 +12,7 @@
 #include "src/debug/debug.h"
 #include "src/execution/frames-inl.h"
 #include "src/heap/factory.h"
+#include "src/json/json-simd.h"
 #include "src/numbers/conversions.h"
 #include "src/numbers/hash-seed-inl.h"
 #include "src/objects/field-type.h"
@@ -20,7 +22,7 @@
 #include "src/objects/property-descriptor.h"
 #include "src/roots/roots.h"
 #include "src/strings/char-predicates-inl.h"
-#include "src/strings/string-hasher.h"
+#include "src/strings/string-hasher-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -122,6 +124,197 @@ static const constexpr uint8_t character_json_scan_flags[256] = {
 #undef CALL_GET_SCAN_FLAGS
 };
 
+bool IsJsonWhitespace(base::uc32 c) {
+  return V8_LIKELY(c <= unibrow::Latin1::kMaxChar) &&
+         one_char_json_tokens[c] == JsonToken::WHITESPACE;
+}
+
+#if defined(V8_JSON_USE_SSE2) || defined(V8_JSON_USE_NEON)
+// Vectorized scanning. The helpers below classify 16 bytes of input (16
+// one-byte or 8 two-byte characters) at a time, and produce a mask with
+// kJsonScanMaskBitsPerByte bits set for every byte of a matching character.
+constexpr size_t kJsonScanVectorSize = 16;
+
+#ifdef V8_JSON_USE_SSE2
+using JsonScanVector = __m128i;
+constexpr int kJsonScanMaskBitsPerByte = 1;
+constexpr uint64_t kJsonScanFullMask = 0xFFFF;
+
+V8_INLINE JsonScanVector LoadJsonScanVector(const void* chars) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+}
+
+V8_INLINE JsonScanVector ZeroJsonScanVector() { return _mm_setzero_si128(); }
+
+V8_INLINE JsonScanVector OrJsonScanVector(JsonScanVector a, JsonScanVector b) {
+  return _mm_or_si128(a, b);
+}
+
+V8_INLINE uint64_t JsonScanMask(JsonScanVector matches) {
+  return static_cast<uint64_t>(_mm_movemask_epi8(matches));
+}
+
+// Returns true if any of the two-byte characters or'ed into |chars| is outside
+// of Latin1.
+V8_INLINE bool HasNonLatin1TwoByteChars(JsonScanVector chars) {
+  __m128i high_bytes = _mm_srli_epi16(chars, 8);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(high_bytes, _mm_setzero_si128())) !=
+         0xFFFF;
+}
+
+template <typename Char>
+V8_INLINE JsonScanVector MatchJsonScanChar(JsonScanVector chars, Char c) {
+  if constexpr (sizeof(Char) == 1) {
+    return _mm_cmpeq_epi8(chars, _mm_set1_epi8(static_cast<char>(c)));
+  } else {
+    return _mm_cmpeq_epi16(chars, _mm_set1_epi16(static_cast<int16_t>(c)));
+  }
+}
+
+// Matches the characters below 0x20. SSE2 has no unsigned comparison, so this
+// uses the fact that the saturating difference c - 0x1F is zero iff c < 0x20.
+template <typename Char>
+V8_INLINE JsonScanVector MatchJsonControlChars(JsonScanVector chars) {
+  if constexpr (sizeof(Char) == 1) {
+    return _mm_cmpeq_epi8(_mm_subs_epu8(chars, _mm_set1_epi8(0x1F)),
+                          _mm_setzero_si128());
+  } else {
+    return _mm_cmpeq_epi16(_mm_subs_epu16(chars, _mm_set1_epi16(0x1F)),
+                           _mm_setzero_si128());
+  }
+}
+#else
+using JsonScanVector = uint8x16_t;
+// There is no movemask on Neon; narrowing every byte of a comparison result to
+// a nibble yields an equivalent 64-bit mask.
+constexpr int kJsonScanMaskBitsPerByte = 4;
+constexpr uint64_t kJsonScanFullMask = ~uint64_t{0};
+
+V8_INLINE JsonScanVector LoadJsonScanVector(const void* chars) {
+  return vld1q_u8(reinterpret_cast<const uint8_t*>(chars));
+}
+
+V8_INLINE JsonScanVector ZeroJsonScanVector() { return vdupq_n_u8(0); }
+
+V8_INLINE JsonScanVector OrJsonScanVector(JsonScanVector a, JsonScanVector b) {
+  return vorrq_u8(a, b);
+}
+
+V8_INLINE uint64_t JsonScanMask(JsonScanVector matches) {
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+V8_INLINE bool HasNonLatin1TwoByteChars(JsonScanVector chars) {
+  return vmaxvq_u16(vreinterpretq_u16_u8(chars)) > unibrow::Latin1::kMaxChar;
+}
+
+template <typename Char>
+V8_INLINE JsonScanVector MatchJsonScanChar(JsonScanVector chars, Char c) {
+  if constexpr (sizeof(Char) == 1) {
+    return vceqq_u8(chars, vdupq_n_u8(c));
+  } else {
+    return vreinterpretq_u8_u16(
+        vceqq_u16(vreinterpretq_u16_u8(chars), vdupq_n_u16(c)));
+  }
+}
+
+template <typename Char>
+V8_INLINE JsonScanVector MatchJsonControlChars(JsonScanVector chars) {
+  if constexpr (sizeof(Char) == 1) {
+    return vcltq_u8(chars, vdupq_n_u8(0x20));
+  } else {
+    return vreinterpretq_u8_u16(
+        vcltq_u16(vreinterpretq_u16_u8(chars), vdupq_n_u16(0x20)));
+  }
+}
+#endif  // V8_JSON_USE_SSE2
+
+// Returns the index of the first character selected by a non-zero |mask|.
+template <typename Char>
+V8_INLINE size_t FirstJsonScanMatch(uint64_t mask) {
+  DCHECK_NE(mask, 0);
+  return base::bits::CountTrailingZeros(mask) /
+         (kJsonScanMaskBitsPerByte * sizeof(Char));
+}
+
+template <typename Char>
+V8_INLINE JsonScanVector MatchJsonStringTerminators(JsonScanVector chars) {
+  return OrJsonScanVector(
+      OrJsonScanVector(MatchJsonScanChar<Char>(chars, '"'),
+                       MatchJsonScanChar<Char>(chars, '\\')),
+      MatchJsonControlChars<Char>(chars));
+}
+
+template <typename Char>
+V8_INLINE JsonScanVector MatchJsonWhitespace(JsonScanVector chars) {
+  return OrJsonScanVector(
+      OrJsonScanVector(MatchJsonScanChar<Char>(chars, ' '),
+                       MatchJsonScanChar<Char>(chars, '\n')),
+      OrJsonScanVector(MatchJsonScanChar<Char>(chars, '\r'),
+                       MatchJsonScanChar<Char>(chars, '\t')));
+}
+#endif  // V8_JSON_USE_SSE2 || V8_JSON_USE_NEON
+
+// Returns the first character in [cursor, end) that may terminate a JSON
+// string, i.e. a quote, a backslash or a control character, or |end| if there
+// is none. For two-byte input, |bits| is or'ed with a value above
+// unibrow::Latin1::kMaxChar if any of the skipped characters is outside of
+// Latin1; callers only compare |bits| against that bound.
+template <typename Char>
+V8_INLINE const Char* ScanToJsonStringTerminator(const Char* cursor,
+                                                 const Char* end,
+                                                 base::uc32* bits) {
+#if defined(V8_JSON_USE_SSE2) || defined(V8_JSON_USE_NEON)
+  constexpr size_t kCharsPerVector = kJsonScanVectorSize / sizeof(Char);
+  JsonScanVector seen = ZeroJsonScanVector();
+  while (static_cast<size_t>(end - cursor) >= kCharsPerVector) {
+    JsonScanVector chars = LoadJsonScanVector(cursor);
+    uint64_t mask = JsonScanMask(MatchJsonStringTerminators<Char>(chars));
+    if (mask != 0) {
+      if constexpr (sizeof(Char) == 1) {
+        return cursor + FirstJsonScanMatch<Char>(mask);
+      }
+      // Characters following the terminator must not be accounted for in
+      // |bits|, so let the scalar loop below handle this last vector.
+      break;
+    }
+    if constexpr (sizeof(Char) == 2) seen = OrJsonScanVector(seen, chars);
+    cursor += kCharsPerVector;
+  }
+  if (sizeof(Char) == 2 && HasNonLatin1TwoByteChars(seen)) {
+    *bits |= unibrow::Latin1::kMaxChar + 1;
+  }
+#endif
+  return std::find_if(cursor, end, [bits](Char c) {
+    if (sizeof(Char) == 2 && V8_UNLIKELY(c > unibrow::Latin1::kMaxChar)) {
+      *bits |= c;
+      return false;
+    }
+    return MayTerminateJsonString(character_json_scan_flags[c]);
+  });
+}
+
+// Returns the first non-whitespace character in [cursor, end), or |end|.
+template <typename Char>
+V8_INLINE const Char* SkipJsonWhitespace(const Char* cursor, const Char* end) {
+#if defined(V8_JSON_USE_SSE2) || defined(V8_JSON_USE_NEON)
+  // Most tokens are not preceded by whitespace at all; don't pay for a vector
+  // load in that case.
+  if (cursor == end || !IsJsonWhitespace(*cursor)) return cursor;
+  constexpr size_t kCharsPerVector = kJsonScanVectorSize / sizeof(Char);
+  while (static_cast<size_t>(end - cursor) >= kCharsPerVector) {
+    JsonScanVector chars = LoadJsonScanVector(cursor);
+    uint64_t mask =
+        JsonScanMask(MatchJsonWhitespace<Char>(chars)) ^ kJsonScanFullMask;
+    if (mask != 0) return cursor + FirstJsonScanMatch<Char>(mask);
+    cursor += kCharsPerVector;
+  }
+#endif
+  return std::find_if_not(cursor, end,
+                          [](Char c) { return IsJsonWhitespace(c); });
+}
+
 }  // namespace
 
 MaybeHandle<Object> JsonParseInternalizer::Internalize(
@@ -564,22 +757,22 @@ MaybeHandle<Object> JsonParser<Char>::ParseJson(Handle<Object> reviver) {
 MaybeHandle<Object> InternalizeJsonProperty(Handle<JSObject> holder,
                                             Handle<String> key);
 
+template <typename Char, typename Delegate>
+JsonToken JsonScanner<Char, Delegate>::SkipWhitespaceAndPeek() {
+  cursor_ = SkipJsonWhitespace(cursor_, end_);
+  if (V8_UNLIKELY(is_at_end())) return JsonToken::EOS;
+  Char c = *cursor_;
+  return V8_LIKELY(c <= unibrow::Latin1::kMaxChar) ? one_char_json_tokens[c]
+                                                    : JsonToken::ILLEGAL;
+}
+
 template <typename Char>
 void JsonParser<Char>::SkipWhitespace() {
-  next_ = JsonToken::EOS;
-
-  cursor_ = std::find_if(cursor_, end_, [this](Char c) {
-    JsonToken current = V8_LIKELY(c <= unibrow::Latin1::kMaxChar)
-                            ? one_char_json_tokens[c]
-                            : JsonToken::ILLEGAL;
-    bool result = current != JsonToken::WHITESPACE;
-    if (result) next_ = current;
-    return result;
-  });
+  next_ = this->SkipWhitespaceAndPeek();
 }
 
-template <typename Char>
-base::uc32 JsonParser<Char>::ScanUnicodeCharacter() {
+template <typename Char, typename Delegate>
+base::uc32 JsonScanner<Char, Delegate>::ScanUnicodeCharacter() {
   base::uc32 value = 0;
   for (int i = 0; i < 4; i++) {
     int digit = base::HexValue(NextCharacter());
@@ -589,9 +782,8 @@ base::uc32 JsonParser<Char>::ScanUnicodeCharacter() {
   return value;
 }
 
-// Parse any JSON value.
-template <typename Char>
-JsonString JsonParser<Char>::ScanJsonPropertyKey(JsonContinuation* cont) {
+template <typename Char, typename Delegate>
+JsonString JsonScanner<Char, Delegate>::ScanJsonPropertyKey() {
   {
     DisallowGarbageCollection no_gc;
     const Char* start = cursor_;
@@ -601,9 +793,6 @@ JsonString JsonParser<Char>::ScanJsonPropertyKey(JsonContinuation* cont) {
       if (first == '0') {
         if (NextCharacter() == '"') {
           advance();
-          // Record element information.
-          cont->elements++;
-          DCHECK_LE(0, cont->max_index);
           return JsonString(0);
         }
       } else {
@@ -615,9 +804,6 @@ JsonString JsonParser<Char>::ScanJsonPropertyKey(JsonContinuation* cont) {
 
           if (CurrentCharacter() == '"') {
             advance();
-            // Record element information.
-            cont->elements++;
-            cont->max_index = std::max(cont->max_index, index);
             return JsonString(index);
           }
 
@@ -635,6 +821,17 @@ JsonString JsonParser<Char>::ScanJsonPropertyKey(JsonContinuation* cont) {
   return ScanJsonString(true);
 }
 
+template <typename Char>
+JsonString JsonParser<Char>::ScanJsonPropertyKey(JsonContinuation* cont) {
+  JsonString key = Scanner::ScanJsonPropertyKey();
+  if (key.is_index()) {
+    // Record element information.
+    cont->elements++;
+    cont->max_index = std::max(cont->max_index, key.index());
+  }
+  return key;
+}
+
 namespace {
 Handle<Map> ParentOfDescriptorOwner(Isolate* isolate, Handle<Map> maybe_root,
                                     Handle<Map> source, int descriptor) {
@@ -890,12 +1087,23 @@ Handle<Object> JsonParser<Char>::BuildJsonObject(
     }
   }
 
-  // Slow path: define remaining named properties.
+  // Slow path: define remaining named properties. The keys are hashed in one
+  // batch up front, which overlaps the hash computations of short keys.
+  const int first_slow = i;
+  std::vector<uint32_t> raw_hash_fields(length - first_slow);
+  HashPropertyKeys(&property_stack[start + first_slow], length - first_slow,
+                   raw_hash_fields.data());
   for (; i < length; i++) {
     HandleScope scope(isolate_);
     const JsonProperty& property = property_stack[start + i];
     if (property.string.is_index()) continue;
-    Handle<String> key = MakeString(property.string);
+    uint32_t raw_hash_field = raw_hash_fields[i - first_slow];
+    Handle<String> key;
+    if (raw_hash_field != 0) {
+      key = MakeStringWithHash(property.string, raw_hash_field);
+    } else {
+      key = MakeString(property.string);
+    }
 #ifdef DEBUG
     uint32_t index;
     DCHECK(!key->AsArrayIndex(&index));
@@ -1218,21 +1426,7 @@ MaybeHandle<Object> JsonParser<Char>::ParseJsonValue(Handle<Object> reviver) {
             break;
           }
 
-          Handle<Map> feedback;
-          if (cont_stack.size() > 0 &&
-              cont_stack.back().type() == JsonContinuation::kArrayElement &&
-              cont_stack.back().index < element_stack.size() &&
-              IsJSObject(*element_stack.back())) {
-            Map maybe_feedback = JSObject::cast(*element_stack.back())->map();
-            // Don't consume feedback from objects with a map that's detached
-            // from the transition tree.
-            if (!maybe_feedback->IsDetached(isolate_)) {
-              feedback = handle(maybe_feedback, isolate_);
-              if (maybe_feedback->is_deprecated()) {
-                feedback = Map::Update(isolate_, feedback);
-              }
-            }
-          }
+          Handle<Map> feedback = ObjectFeedback(cont_stack, element_stack);
           value = BuildJsonObject(cont, property_stack, feedback);
           Expect(JsonToken::RBRACE,
                  MessageTemplate::kJsonParseExpectedCommaOrRBrace);
@@ -1325,105 +1519,267 @@ MaybeHandle<Object> JsonParser<Char>::ParseJsonValue(Handle<Object> reviver) {
 }
 
 template <typename Char>
-void JsonParser<Char>::AdvanceToNonDecimal() {
-  cursor_ =
-      std::find_if(cursor_, end_, [](Char c) { return !IsDecimalDigit(c); });
+Handle<Map> JsonParser<Char>::ObjectFeedback(
+    const std::vector<JsonContinuation>& cont_stack,
+    const SmallVector<Handle<Object>>& element_stack) {
+  Handle<Map> feedback;
+  if (cont_stack.size() > 0 &&
+      cont_stack.back().type() == JsonContinuation::kArrayElement &&
+      cont_stack.back().index < element_stack.size() &&
+      IsJSObject(*element_stack.back())) {
+    Map maybe_feedback = JSObject::cast(*element_stack.back())->map();
+    // Don't consume feedback from objects with a map that's detached
+    // from the transition tree.
+    if (!maybe_feedback->IsDetached(isolate_)) {
+      feedback = handle(maybe_feedback, isolate_);
+      if (maybe_feedback->is_deprecated()) {
+        feedback = Map::Update(isolate_, feedback);
+      }
+    }
+  }
+  return feedback;
 }
 
 template <typename Char>
-Handle<Object> JsonParser<Char>::ParseJsonNumber() {
-  double number;
-  int sign = 1;
+JsonString JsonParser<Char>::MakeTapeKey(const JsonTape::Entry& entry,
+                                         int offset, JsonContinuation* cont) {
+  if (entry.kind == JsonTape::Kind::kIndexKey) {
+    // Record element information, like ScanJsonPropertyKey.
+    cont->elements++;
+    cont->max_index = std::max(cont->max_index, entry.index);
+    return JsonString(entry.index);
+  }
+  DCHECK_EQ(entry.kind, JsonTape::Kind::kStringKey);
+  return JsonString(offset + entry.start, entry.length,
+                    entry.needs_conversion, true, entry.has_escape);
+}
 
-  {
-    const Char* start = cursor_;
-    DisallowGarbageCollection no_gc;
+template <typename Char>
+MaybeHandle<Object> JsonParser<Char>::ParseJsonTape(const JsonTape& tape) {
+  std::vector<JsonContinuation> cont_stack;
+  SmallVector<JsonProperty> property_stack;
+  SmallVector<Handle<Object>> element_stack;
+
+  cont_stack.reserve(16);
+
+  JsonContinuation cont(isolate_, JsonContinuation::kReturn, 0);
+
+  Handle<Object> value;
+
+  // Tape positions are relative to the start of the source, which may not be
+  // the start of chars_ for sliced strings.
+  const int offset = position();
+  auto entry = tape.entries().begin();
+  while (true) {
+    // Produce a json value.
+    while (true) {
+      DCHECK(entry != tape.entries().end());
+      const JsonTape::Entry& current = *entry++;
+      switch (current.kind) {
+        case JsonTape::Kind::kNumber:
+          value = factory()->NewNumber(current.number);
+          break;
+
+        case JsonTape::Kind::kString:
+          value = MakeString(JsonString(offset + current.start, current.length,
+                                        current.needs_conversion, false,
+                                        current.has_escape));
+          break;
 
-    base::uc32 c = *cursor_;
-    if (c == '-') {
-      sign = -1;
-      c = NextCharacter();
+        case JsonTape::Kind::kTrue:
+          value = factory()->true_value();
+          break;
+
+        case JsonTape::Kind::kFalse:
+          value = factory()->false_value();
+          break;
+
+        case JsonTape::Kind::kNull:
+          value = factory()->null_value();
+          break;
+
+        case JsonTape::Kind::kEmptyObject:
+          value = factory()->NewJSObject(object_constructor_);
+          break;
+
+        case JsonTape::Kind::kEmptyArray:
+          value = factory()->NewJSArray(0, PACKED_SMI_ELEMENTS);
+          break;
+
+        case JsonTape::Kind::kObjectStart:
+          // Start building an object with properties.
+          cont_stack.emplace_back(std::move(cont));
+          cont = JsonContinuation(isolate_, JsonContinuation::kObjectProperty,
+                                  property_stack.size());
+          property_stack.emplace_back(MakeTapeKey(*entry++, offset, &cont));
+          // Continue to start producing the first property value.
+          continue;
+
+        case JsonTape::Kind::kArrayStart:
+          // Start building an array with elements.
+          cont_stack.emplace_back(std::move(cont));
+          cont = JsonContinuation(isolate_, JsonContinuation::kArrayElement,
+                                  element_stack.size());
+          // Continue to start producing the first array element.
+          continue;
+
+        case JsonTape::Kind::kObjectEnd:
+        case JsonTape::Kind::kArrayEnd:
+        case JsonTape::Kind::kStringKey:
+        case JsonTape::Kind::kIndexKey:
+          UNREACHABLE();
+      }
+      // Done producing a value, consume it.
+      break;
     }
 
-    if (c == '0') {
-      // Prefix zero is only allowed if it's the only digit before
-      // a decimal point or exponent.
-      c = NextCharacter();
-      if (base::IsInRange(c, 0,
-                          static_cast<int32_t>(unibrow::Latin1::kMaxChar)) &&
-          IsNumberPart(character_json_scan_flags[c])) {
-        if (V8_UNLIKELY(IsDecimalDigit(c))) {
-          AllowGarbageCollection allow_before_exception;
-          ReportUnexpectedToken(JsonToken::NUMBER);
-          return handle(Smi::FromInt(0), isolate_);
+    // Consume a produced json value.
+    while (true) {
+      switch (cont.type()) {
+        case JsonContinuation::kReturn:
+          DCHECK(entry == tape.entries().end());
+          return cont.scope.CloseAndEscape(value);
+
+        case JsonContinuation::kObjectProperty: {
+          // Store the previous property value into its property info.
+          property_stack.back().value = value;
+
+          if (entry->kind != JsonTape::Kind::kObjectEnd) {
+            property_stack.emplace_back(MakeTapeKey(*entry++, offset, &cont));
+            // Break to start producing the subsequent property value.
+            break;
+          }
+          entry++;
+
+          Handle<Map> feedback = ObjectFeedback(cont_stack, element_stack);
+          value = BuildJsonObject(cont, property_stack, feedback);
+          value = cont.scope.CloseAndEscape(value);
+          property_stack.resize_no_init(cont.index);
+
+          // Pop the continuation.
+          cont = std::move(cont_stack.back());
+          cont_stack.pop_back();
+          // Consume to produced object.
+          continue;
         }
-      } else if (sign > 0) {
-        return handle(Smi::FromInt(0), isolate_);
-      }
-    } else {
-      const Char* smi_start = cursor_;
-      AdvanceToNonDecimal();
-      if (V8_UNLIKELY(smi_start == cursor_)) {
-        AllowGarbageCollection allow_before_exception;
-        ReportUnexpectedToken(
-            JsonToken::ILLEGAL,
-            MessageTemplate::kJsonParseNoNumberAfterMinusSign);
-        return handle(Smi::FromInt(0), isolate_);
-      }
-      c = CurrentCharacter();
-      static_assert(Smi::IsValid(-999999999));
-      static_assert(Smi::IsValid(999999999));
-      const int kMaxSmiLength = 9;
-      if ((cursor_ - smi_start) <= kMaxSmiLength &&
-          (!base::IsInRange(c, 0,
-                            static_cast<int32_t>(unibrow::Latin1::kMaxChar)) ||
-           !IsNumberPart(character_json_scan_flags[c]))) {
-        // Smi.
-        int32_t i = 0;
-        for (; smi_start != cursor_; smi_start++) {
-          DCHECK(IsDecimalDigit(*smi_start));
-          i = (i * 10) + ((*smi_start) - '0');
+
+        case JsonContinuation::kArrayElement: {
+          // Store the previous element on the stack.
+          element_stack.emplace_back(value);
+          // Break to start producing the subsequent element value.
+          if (entry->kind != JsonTape::Kind::kArrayEnd) break;
+          entry++;
+
+          value = BuildJsonArray(cont, element_stack);
+          value = cont.scope.CloseAndEscape(value);
+          element_stack.resize_no_init(cont.index);
+          // Pop the continuation.
+          cont = std::move(cont_stack.back());
+          cont_stack.pop_back();
+          // Consume the produced array.
+          continue;
         }
-        // TODO(verwaest): Cache?
-        return handle(Smi::FromInt(i * sign), isolate_);
       }
+
+      // Done consuming a value. Produce next value.
+      break;
     }
+  }
+}
+
+template <typename Char, typename Delegate>
+void JsonScanner<Char, Delegate>::AdvanceToNonDecimal() {
+  cursor_ =
+      std::find_if(cursor_, end_, [](Char c) { return !IsDecimalDigit(c); });
+}
+
+template <typename Char, typename Delegate>
+double JsonScanner<Char, Delegate>::ScanJsonNumber() {
+  DisallowGarbageCollection no_gc;
+  const Char* start = cursor_;
+  int sign = 1;
 
-    if (CurrentCharacter() == '.') {
-      c = NextCharacter();
-      if (!IsDecimalDigit(c)) {
-        AllowGarbageCollection allow_before_exception;
-        ReportUnexpectedToken(
-            JsonToken::ILLEGAL,
-            MessageTemplate::kJsonParseUnterminatedFractionalNumber);
-        return handle(Smi::FromInt(0), isolate_);
+  base::uc32 c = *cursor_;
+  if (c == '-') {
+    sign = -1;
+    c = NextCharacter();
+  }
+
+  if (c == '0') {
+    // Prefix zero is only allowed if it's the only digit before
+    // a decimal point or exponent.
+    c = NextCharacter();
+    if (base::IsInRange(c, 0,
+                        static_cast<int32_t>(unibrow::Latin1::kMaxChar)) &&
+        IsNumberPart(character_json_scan_flags[c])) {
+      if (V8_UNLIKELY(IsDecimalDigit(c))) {
+        ReportScanError(JsonToken::NUMBER);
+        return 0;
       }
-      AdvanceToNonDecimal();
+    } else if (sign > 0) {
+      return 0;
     }
-
-    if (AsciiAlphaToLower(CurrentCharacter()) == 'e') {
-      c = NextCharacter();
-      if (c == '-' || c == '+') c = NextCharacter();
-      if (!IsDecimalDigit(c)) {
-        AllowGarbageCollection allow_before_exception;
-        ReportUnexpectedToken(
-            JsonToken::ILLEGAL,
-            MessageTemplate::kJsonParseExponentPartMissingNumber);
-        return handle(Smi::FromInt(0), isolate_);
+  } else {
+    const Char* smi_start = cursor_;
+    AdvanceToNonDecimal();
+    if (V8_UNLIKELY(smi_start == cursor_)) {
+      ReportScanError(JsonToken::ILLEGAL,
+                      MessageTemplate::kJsonParseNoNumberAfterMinusSign);
+      return 0;
+    }
+    c = CurrentCharacter();
+    static_assert(Smi::IsValid(-999999999));
+    static_assert(Smi::IsValid(999999999));
+    const int kMaxSmiLength = 9;
+    if ((cursor_ - smi_start) <= kMaxSmiLength &&
+        (!base::IsInRange(c, 0,
+                          static_cast<int32_t>(unibrow::Latin1::kMaxChar)) ||
+         !IsNumberPart(character_json_scan_flags[c]))) {
+      // Smi.
+      int32_t i = 0;
+      for (; smi_start != cursor_; smi_start++) {
+        DCHECK(IsDecimalDigit(*smi_start));
+        i = (i * 10) + ((*smi_start) - '0');
       }
-      AdvanceToNonDecimal();
+      return i * sign;
     }
+  }
 
-    base::Vector<const Char> chars(start, cursor_ - start);
-    number =
-        StringToDouble(chars,
-                       NO_CONVERSION_FLAGS,  // Hex, octal or trailing junk.
-                       std::numeric_limits<double>::quiet_NaN());
+  if (CurrentCharacter() == '.') {
+    c = NextCharacter();
+    if (!IsDecimalDigit(c)) {
+      ReportScanError(JsonToken::ILLEGAL,
+                      MessageTemplate::kJsonParseUnterminatedFractionalNumber);
+      return 0;
+    }
+    AdvanceToNonDecimal();
+  }
 
-    DCHECK(!std::isnan(number));
+  if (AsciiAlphaToLower(CurrentCharacter()) == 'e') {
+    c = NextCharacter();
+    if (c == '-' || c == '+') c = NextCharacter();
+    if (!IsDecimalDigit(c)) {
+      ReportScanError(JsonToken::ILLEGAL,
+                      MessageTemplate::kJsonParseExponentPartMissingNumber);
+      return 0;
+    }
+    AdvanceToNonDecimal();
   }
 
-  return factory()->NewNumber(number);
+  base::Vector<const Char> chars(start, cursor_ - start);
+  double number =
+      StringToDouble(chars,
+                     NO_CONVERSION_FLAGS,  // Hex, octal or trailing junk.
+                     std::numeric_limits<double>::quiet_NaN());
+
+  DCHECK(!std::isnan(number));
+  return number;
+}
+
+template <typename Char>
+Handle<Object> JsonParser<Char>::ParseJsonNumber() {
+  // Numbers that fit in a Smi, and 0 after an error, are returned as Smis.
+  return factory()->NewNumber(this->ScanJsonNumber());
 }
 
 namespace {
@@ -1492,6 +1848,49 @@ Handle<String> JsonParser<Char>::MakeString(const JsonString& string,
   return DecodeString(string, intermediate, hint);
 }
 
+template <typename Char>
+void JsonParser<Char>::HashPropertyKeys(const JsonProperty* properties,
+                                        int count, uint32_t* raw_hash_fields) {
+  std::fill_n(raw_hash_fields, count, 0);
+  // Keys of a relocatable source are internalized from the source string
+  // itself; they are hashed on insertion instead.
+  if (chars_may_relocate_ || count == 0) return;
+  DisallowGarbageCollection no_gc;
+  SmallVector<const Char*> chars;
+  SmallVector<int> lengths;
+  SmallVector<int> indices;
+  for (int i = 0; i < count; i++) {
+    const JsonString& string = properties[i].string;
+    if (string.is_index() || string.length() == 0 || !string.internalize() ||
+        string.has_escape()) {
+      continue;
+    }
+    chars.push_back(chars_ + string.start());
+    lengths.push_back(string.length());
+    indices.push_back(i);
+  }
+  SmallVector<uint32_t> hashes(chars.size());
+  StringHasher::HashSequentialStrings(chars.data(), lengths.data(),
+                                      static_cast<int>(chars.size()),
+                                      HashSeed(isolate_), hashes.data());
+  for (size_t i = 0; i < indices.size(); i++) {
+    raw_hash_fields[indices[i]] = hashes[i];
+  }
+}
+
+template <typename Char>
+Handle<String> JsonParser<Char>::MakeStringWithHash(const JsonString& string,
+                                                    uint32_t raw_hash_field) {
+  DCHECK(!chars_may_relocate_);
+  DCHECK(string.internalize());
+  DCHECK(!string.has_escape());
+  SequentialStringKey<Char> key(
+      raw_hash_field,
+      base::Vector<const Char>(chars_ + string.start(), string.length()),
+      string.needs_conversion());
+  return factory()->InternalizeStringWithKey(&key);
+}
+
 template <typename Char>
 template <typename SinkChar>
 void JsonParser<Char>::DecodeString(SinkChar* sink, int start, int length) {
@@ -1556,8 +1955,9 @@ void JsonParser<Char>::DecodeString(SinkChar* sink, int start, int length) {
   }
 }
 
-template <typename Char>
-JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
+template <typename Char, typename Delegate>
+JsonString JsonScanner<Char, Delegate>::ScanJsonString(
+    bool needs_internalization) {
   DisallowGarbageCollection no_gc;
   int start = position();
   int offset = start;
@@ -1565,18 +1965,11 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
   base::uc32 bits = 0;
 
   while (true) {
-    cursor_ = std::find_if(cursor_, end_, [&bits](Char c) {
-      if (sizeof(Char) == 2 && V8_UNLIKELY(c > unibrow::Latin1::kMaxChar)) {
-        bits |= c;
-        return false;
-      }
-      return MayTerminateJsonString(character_json_scan_flags[c]);
-    });
+    cursor_ = ScanToJsonStringTerminator(cursor_, end_, &bits);
 
     if (V8_UNLIKELY(is_at_end())) {
-      AllowGarbageCollection allow_before_exception;
-      ReportUnexpectedToken(JsonToken::ILLEGAL,
-                            MessageTemplate::kJsonParseUnterminatedString);
+      ReportScanError(JsonToken::ILLEGAL,
+                      MessageTemplate::kJsonParseUnterminatedString);
       break;
     }
 
@@ -1595,8 +1988,8 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
       base::uc32 c = NextCharacter();
       if (V8_UNLIKELY(!base::IsInRange(
               c, 0, static_cast<int32_t>(unibrow::Latin1::kMaxChar)))) {
-        AllowGarbageCollection allow_before_exception;
-        ReportUnexpectedCharacter(c);
+        ReportScanError(c == kEndOfString ? JsonToken::EOS
+                                          : JsonToken::ILLEGAL);
         break;
       }
 
@@ -1613,9 +2006,8 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
         case EscapeKind::kUnicode: {
           base::uc32 value = ScanUnicodeCharacter();
           if (value == kInvalidUnicodeCharacter) {
-            AllowGarbageCollection allow_before_exception;
-            ReportUnexpectedToken(JsonToken::ILLEGAL,
-                                  MessageTemplate::kJsonParseBadUnicodeEscape);
+            ReportScanError(JsonToken::ILLEGAL,
+                            MessageTemplate::kJsonParseBadUnicodeEscape);
             return JsonString();
           }
           bits |= value;
@@ -1627,9 +2019,8 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
         }
 
         case EscapeKind::kIllegal:
-          AllowGarbageCollection allow_before_exception;
-          ReportUnexpectedToken(JsonToken::ILLEGAL,
-                                MessageTemplate::kJsonParseBadEscapedCharacter);
+          ReportScanError(JsonToken::ILLEGAL,
+                          MessageTemplate::kJsonParseBadEscapedCharacter);
           return JsonString();
       }
 
@@ -1638,9 +2029,8 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
     }
 
     DCHECK_LT(*cursor_, 0x20);
-    AllowGarbageCollection allow_before_exception;
-    ReportUnexpectedToken(JsonToken::ILLEGAL,
-                          MessageTemplate::kJsonParseBadControlCharacter);
+    ReportScanError(JsonToken::ILLEGAL,
+                    MessageTemplate::kJsonParseBadControlCharacter);
     break;
   }
 
@@ -1648,8 +2038,223 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
 }
 
 // Explicit instantiation.
+template class JsonScanner<uint8_t, JsonParser<uint8_t>>;
+template class JsonScanner<uint16_t, JsonParser<uint16_t>>;
 template class JsonParser<uint8_t>;
 template class JsonParser<uint16_t>;
 
+namespace {
+
+// Builds a JsonTape from raw characters without accessing the heap, so that it
+// can run on a background thread. It shares JsonScanner with JsonParser and
+// thus accepts exactly the inputs JsonParser accepts, but only reports whether
+// the input was valid; the exception for invalid input is created by
+// re-parsing it with JsonParser.
+template <typename Char>
+class JsonTapeBuilder final
+    : public JsonScanner<Char, JsonTapeBuilder<Char>> {
+ public:
+  JsonTapeBuilder(const Char* chars, int length, JsonTape* tape)
+      : Scanner(chars, length), tape_(tape) {}
+
+  bool Build();
+
+ private:
+  using Scanner = JsonScanner<Char, JsonTapeBuilder<Char>>;
+  friend Scanner;
+
+  using Scanner::advance;
+  using Scanner::ScanJsonNumber;
+  using Scanner::ScanJsonPropertyKey;
+  using Scanner::ScanJsonString;
+  using Scanner::SkipWhitespaceAndPeek;
+  using Scanner::TryScanLiteral;
+
+  void ReportScanError(JsonToken token,
+                       base::Optional<MessageTemplate> errorMessage) {
+    failed_ = true;
+  }
+
+  // Records a string or property key returned by the scanner. Returns false if
+  // the scanner rejected the input.
+  bool AddString(JsonTape::Kind kind, const JsonString& string) {
+    if (failed_) return false;
+    if (string.is_index()) {
+      tape_->AddIndexKey(string.index());
+    } else {
+      tape_->AddString(kind, string.start(), string.length(),
+                       string.needs_conversion(), string.has_escape());
+    }
+    return true;
+  }
+
+  bool ScanPropertyKeyAndColon();
+
+  JsonTape* const tape_;
+  bool failed_ = false;
+};
+
+template <typename Char>
+bool JsonTapeBuilder<Char>::ScanPropertyKeyAndColon() {
+  if (SkipWhitespaceAndPeek() != JsonToken::STRING) return false;
+  advance();
+  if (!AddString(JsonTape::Kind::kStringKey, ScanJsonPropertyKey())) {
+    return false;
+  }
+  if (SkipWhitespaceAndPeek() != JsonToken::COLON) return false;
+  advance();
+  return true;
+}
+
+// Follows JsonParser::ParseJsonValue, with an explicit stack of the open
+// objects and arrays instead of continuations.
+template <typename Char>
+bool JsonTapeBuilder<Char>::Build() {
+  enum class Container : uint8_t { kObject, kArray };
+  std::vector<Container> containers;
+
+  while (true) {
+    // Produce a json value.
+    while (true) {
+      switch (SkipWhitespaceAndPeek()) {
+        case JsonToken::STRING:
+          advance();
+          if (!AddString(JsonTape::Kind::kString, ScanJsonString(false))) {
+            return false;
+          }
+          break;
+
+        case JsonToken::NUMBER: {
+          double number = ScanJsonNumber();
+          if (failed_) return false;
+          tape_->AddNumber(number);
+          break;
+        }
+
+        case JsonToken::LBRACE:
+          advance();
+          if (SkipWhitespaceAndPeek() == JsonToken::RBRACE) {
+            advance();
+            tape_->Add(JsonTape::Kind::kEmptyObject);
+            break;
+          }
+          tape_->Add(JsonTape::Kind::kObjectStart);
+          containers.push_back(Container::kObject);
+          if (!ScanPropertyKeyAndColon()) return false;
+          continue;
+
+        case JsonToken::LBRACK:
+          advance();
+          if (SkipWhitespaceAndPeek() == JsonToken::RBRACK) {
+            advance();
+            tape_->Add(JsonTape::Kind::kEmptyArray);
+            break;
+          }
+          tape_->Add(JsonTape::Kind::kArrayStart);
+          containers.push_back(Container::kArray);
+          continue;
+
+        case JsonToken::TRUE_LITERAL:
+          if (!TryScanLiteral("true")) return false;
+          tape_->Add(JsonTape::Kind::kTrue);
+          break;
+
+        case JsonToken::FALSE_LITERAL:
+          if (!TryScanLiteral("false")) return false;
+          tape_->Add(JsonTape::Kind::kFalse);
+          break;
+
+        case JsonToken::NULL_LITERAL:
+          if (!TryScanLiteral("null")) return false;
+          tape_->Add(JsonTape::Kind::kNull);
+          break;
+
+        default:
+          return false;
+      }
+      // Done producing a value, consume it.
+      break;
+    }
+
+    // Consume a produced json value.
+    while (true) {
+      JsonToken token = SkipWhitespaceAndPeek();
+      if (containers.empty()) return token == JsonToken::EOS;
+
+      if (V8_LIKELY(token == JsonToken::COMMA)) {
+        advance();
+        if (containers.back() == Container::kObject &&
+            !ScanPropertyKeyAndColon()) {
+          return false;
+        }
+        // Break to start producing the subsequent value.
+        break;
+      }
+
+      if (containers.back() == Container::kObject) {
+        if (token != JsonToken::RBRACE) return false;
+        tape_->Add(JsonTape::Kind::kObjectEnd);
+      } else {
+        if (token != JsonToken::RBRACK) return false;
+        tape_->Add(JsonTape::Kind::kArrayEnd);
+      }
+      advance();
+      containers.pop_back();
+    }
+  }
+}
+
+}  // namespace
+
+BackgroundJsonParseTask::BackgroundJsonParseTask(Isolate* isolate,
+                                                 Handle<String> source) {
+  source = String::Flatten(isolate, source);
+  is_one_byte_ = source->IsOneByteRepresentation();
+  length_ = source->length();
+  // Copy the characters, since the source may move or be externalized while
+  // Run() executes on another thread.
+  DisallowGarbageCollection no_gc;
+  if (is_one_byte_) {
+    one_byte_chars_.resize(length_);
+    String::WriteToFlat(*source, one_byte_chars_.data(), 0, length_);
+  } else {
+    two_byte_chars_.resize(length_);
+    String::WriteToFlat(*source, two_byte_chars_.data(), 0, length_);
+  }
+}
+
+void BackgroundJsonParseTask::Run() {
+  CHECK(!has_run_);
+  has_run_ = true;
+  tape_is_valid_ =
+      is_one_byte_
+          ? JsonTapeBuilder<uint8_t>(one_byte_chars_.data(), length_, &tape_)
+                .Build()
+          : JsonTapeBuilder<uint16_t>(two_byte_chars_.data(), length_, &tape_)
+                .Build();
+  // The copy is no longer needed, Finish() reads from the source string.
+  one_byte_chars_ = {};
+  two_byte_chars_ = {};
+}
+
+MaybeHandle<Object> BackgroundJsonParseTask::Finish(Isolate* isolate,
+                                                    Handle<String> source) {
+  DCHECK_EQ(source->length(), length_);
+  source = String::Flatten(isolate, source);
+  bool is_one_byte = source->IsOneByteRepresentation();
+  // The tape is only usable if it was built for the same character width,
+  // since the string conversion flags depend on it.
+  if (V8_LIKELY(tape_is_valid_ && is_one_byte == is_one_byte_)) {
+    return is_one_byte
+               ? JsonParser<uint8_t>::ParseTape(isolate, source, tape_)
+               : JsonParser<uint16_t>::ParseTape(isolate, source, tape_);
+  }
+  // Either Run() hasn't been called or the source is invalid. Parse on this
+  // thread, which also takes care of throwing the right exception.
+  Handle<Object> undefined = isolate->factory()->undefined_value();
+  return is_one_byte ? JsonParser<uint8_t>::Parse(isolate, source, undefined)
+                     : JsonParser<uint16_t>::Parse(isolate, source, undefined);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -5,6 +5,8 @@
 #ifndef V8_JSON_JSON_PARSER_H_
 #define V8_JSON_JSON_PARSER_H_
 
+#include <vector>
+
 #include "include/v8-callbacks.h"
 #include "src/base/small-vector.h"
 #include "src/base/strings.h"
@@ -149,9 +151,197 @@ enum class JsonToken : uint8_t {
   EOS
 };
 
+// A flat, off-heap record of the values in a JSON text, in source order.
+// Objects and arrays are delimited by start and end entries, and strings and
+// property keys refer to their characters by position in the source. A tape is
+// built without touching the heap, so JsonParser can later materialize the
+// value from the tape and the source string without scanning the source again.
+class JsonTape final {
+ public:
+  enum class Kind : uint8_t {
+    kNumber,
+    kString,
+    kTrue,
+    kFalse,
+    kNull,
+    kEmptyObject,
+    kEmptyArray,
+    kObjectStart,
+    kObjectEnd,
+    kArrayStart,
+    kArrayEnd,
+    // Property keys, only directly following kObjectStart or the value of the
+    // previous property.
+    kStringKey,
+    kIndexKey
+  };
+
+  struct Entry {
+    explicit Entry(Kind kind) : kind(kind) {}
+
+    Kind kind;
+    // kString and kStringKey only, see JsonString.
+    bool needs_conversion = false;
+    bool has_escape = false;
+    int start = 0;
+    int length = 0;
+    union {
+      // kIndexKey only.
+      uint32_t index;
+      // kNumber only.
+      double number = 0;
+    };
+  };
+
+  void Add(Kind kind) { entries_.emplace_back(kind); }
+
+  void AddNumber(double number) {
+    entries_.emplace_back(Kind::kNumber).number = number;
+  }
+
+  void AddString(Kind kind, int start, int length, bool needs_conversion,
+                 bool has_escape) {
+    DCHECK(kind == Kind::kString || kind == Kind::kStringKey);
+    Entry& entry = entries_.emplace_back(kind);
+    entry.start = start;
+    entry.length = length;
+    entry.needs_conversion = needs_conversion;
+    entry.has_escape = has_escape;
+  }
+
+  void AddIndexKey(uint32_t index) {
+    entries_.emplace_back(Kind::kIndexKey).index = index;
+  }
+
+  void Clear() { entries_.clear(); }
+
+  const std::vector<Entry>& entries() const { return entries_; }
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+// The heap-free part of JSON parsing: tokens, literals, strings, property
+// keys and numbers. JsonParser and the background JsonTape builder both scan
+// through it, so that they accept exactly the same inputs. Invalid input is
+// passed to Delegate::ReportScanError() with the cursor at the offending
+// character, after which the scan functions return a dummy value.
+template <typename Char, typename Delegate>
+class JsonScanner {
+ public:
+  static constexpr base::uc32 kEndOfString = static_cast<base::uc32>(-1);
+  static constexpr base::uc32 kInvalidUnicodeCharacter =
+      static_cast<base::uc32>(-1);
+
+ protected:
+  JsonScanner() = default;
+  JsonScanner(const Char* chars, int length)
+      : cursor_(chars), end_(chars + length), chars_(chars) {}
+
+  bool is_at_end() const {
+    DCHECK_LE(cursor_, end_);
+    return cursor_ == end_;
+  }
+
+  int position() const { return static_cast<int>(cursor_ - chars_); }
+
+  void advance() { ++cursor_; }
+
+  base::uc32 CurrentCharacter() {
+    if (V8_UNLIKELY(is_at_end())) return kEndOfString;
+    return *cursor_;
+  }
+
+  base::uc32 NextCharacter() {
+    advance();
+    return CurrentCharacter();
+  }
+
+  void AdvanceToNonDecimal();
+
+  // The JSON lexical grammar is specified in the ECMAScript 5 standard,
+  // section 15.12.1.1. The only allowed whitespace characters between tokens
+  // are tab, carriage-return, newline and space. Returns the token starting at
+  // the next non-whitespace character without consuming it.
+  JsonToken SkipWhitespaceAndPeek();
+
+  // Consumes the literal |s| if the input matches it. The first character was
+  // compared before, so it is skipped.
+  template <size_t N>
+  bool TryScanLiteral(const char (&s)[N]) {
+    DCHECK(!is_at_end());
+    static_assert(N > 2);
+    size_t remaining = static_cast<size_t>(end_ - cursor_);
+    if (V8_LIKELY(remaining >= N - 1 &&
+                  CompareCharsEqual(s + 1, cursor_ + 1, N - 2))) {
+      cursor_ += N - 1;
+      return true;
+    }
+    return false;
+  }
+
+  // A JSON string (production JSONString) is subset of valid JavaScript string
+  // literals. The string must only be double-quoted (not single-quoted), and
+  // the only allowed backslash-escapes are ", /, \, b, f, n, r, t and
+  // four-digit hex escapes (uXXXX). Any other use of backslashes is invalid.
+  JsonString ScanJsonString(bool needs_internalization);
+  // Scans a property key, which is either an array index or a string that
+  // needs internalization.
+  JsonString ScanJsonPropertyKey();
+  base::uc32 ScanUnicodeCharacter();
+
+  // A JSON number (production JSONNumber) is a subset of the valid JavaScript
+  // decimal number literals.
+  // It includes an optional minus sign, must have at least one
+  // digit before and after a decimal point, may not have prefixed zeros (unless
+  // the integer part is zero), and may include an exponent part (e.g., "e-10").
+  // Hexadecimal and octal numbers are not allowed.
+  double ScanJsonNumber();
+
+  // Cached pointer to the raw chars in source. In case source is on-heap,
+  // JsonParser registers an UpdatePointers callback. For this reason, chars_,
+  // cursor_ and end_ should never be locally cached across a possible
+  // allocation. The scope in which we cache chars has to be guarded by a
+  // DisallowGarbageCollection scope.
+  const Char* cursor_ = nullptr;
+  const Char* end_ = nullptr;
+  const Char* chars_ = nullptr;
+
+ private:
+  void ReportScanError(
+      JsonToken token,
+      base::Optional<MessageTemplate> errorMessage = base::nullopt) {
+    static_cast<Delegate*>(this)->ReportScanError(token, errorMessage);
+  }
+};
+
+// Splits JSON.parse between a background thread and the isolate's thread.
+// Run() tokenizes and validates a copy of the source into a JsonTape and may
+// execute on any thread; Finish() then only has to allocate the resulting
+// objects. Invalid input is re-parsed on Finish() so that the thrown exception
+// is exactly the one JSON.parse would throw.
+class V8_EXPORT_PRIVATE BackgroundJsonParseTask final {
+ public:
+  BackgroundJsonParseTask(Isolate* isolate, Handle<String> source);
+
+  // Must be called at most once, since it releases the copy of the source.
+  void Run();
+
+  MaybeHandle<Object> Finish(Isolate* isolate, Handle<String> source);
+
+ private:
+  bool is_one_byte_;
+  bool has_run_ = false;
+  int length_;
+  std::vector<uint8_t> one_byte_chars_;
+  std::vector<base::uc16> two_byte_chars_;
+  JsonTape tape_;
+  bool tape_is_valid_ = false;
+};
+
 // A simple json parser.
 template <typename Char>
-class JsonParser final {
+class JsonParser final : public JsonScanner<Char, JsonParser<Char>> {
  public:
   using SeqString = typename CharTraits<Char>::String;
   using SeqExternalString = typename CharTraits<Char>::ExternalString;
@@ -180,11 +370,36 @@ class JsonParser final {
     return result;
   }
 
-  static constexpr base::uc32 kEndOfString = static_cast<base::uc32>(-1);
-  static constexpr base::uc32 kInvalidUnicodeCharacter =
-      static_cast<base::uc32>(-1);
+  // Materializes the value recorded in |tape|, which must have been built
+  // successfully from the characters of |source|.
+  V8_WARN_UNUSED_RESULT static MaybeHandle<Object> ParseTape(
+      Isolate* isolate, Handle<String> source, const JsonTape& tape) {
+    HighAllocationThroughputScope high_throughput_scope(
+        V8::GetCurrentPlatform());
+    JsonParser parser(isolate, source);
+    return parser.ParseJsonTape(tape);
+  }
 
  private:
+  using Scanner = JsonScanner<Char, JsonParser<Char>>;
+  friend Scanner;
+
+  using Scanner::kEndOfString;
+  using Scanner::kInvalidUnicodeCharacter;
+
+  using Scanner::advance;
+  using Scanner::AdvanceToNonDecimal;
+  using Scanner::CurrentCharacter;
+  using Scanner::is_at_end;
+  using Scanner::NextCharacter;
+  using Scanner::position;
+  using Scanner::ScanJsonString;
+  using Scanner::ScanUnicodeCharacter;
+
+  using Scanner::chars_;
+  using Scanner::cursor_;
+  using Scanner::end_;
+
   template <typename T>
   using SmallVector = base::SmallVector<T, 16>;
   struct JsonContinuation {
@@ -215,20 +430,6 @@ class JsonParser final {
 
   bool ParseRawJson();
 
-  void advance() { ++cursor_; }
-
-  base::uc32 CurrentCharacter() {
-    if (V8_UNLIKELY(is_at_end())) return kEndOfString;
-    return *cursor_;
-  }
-
-  base::uc32 NextCharacter() {
-    advance();
-    return CurrentCharacter();
-  }
-
-  void AdvanceToNonDecimal();
-
   V8_INLINE JsonToken peek() const { return next_; }
 
   void Consume(JsonToken token) {
@@ -262,18 +463,12 @@ class JsonParser final {
 
   template <size_t N>
   void ScanLiteral(const char (&s)[N]) {
-    DCHECK(!is_at_end());
     // There's at least 1 character, we always consume a character and compare
     // the next character. The first character was compared before we jumped
     // to ScanLiteral.
-    static_assert(N > 2);
-    size_t remaining = static_cast<size_t>(end_ - cursor_);
-    if (V8_LIKELY(remaining >= N - 1 &&
-                  CompareCharsEqual(s + 1, cursor_ + 1, N - 2))) {
-      cursor_ += N - 1;
-      return;
-    }
+    if (V8_LIKELY(this->TryScanLiteral(s))) return;
 
+    size_t remaining = static_cast<size_t>(end_ - cursor_);
     cursor_++;
     for (size_t i = 0; i < std::min(N - 2, remaining - 1); i++) {
       if (*(s + 1 + i) != *cursor_) {
@@ -287,21 +482,25 @@ class JsonParser final {
     ReportUnexpectedToken(JsonToken::EOS);
   }
 
-  // The JSON lexical grammar is specified in the ECMAScript 5 standard,
-  // section 15.12.1.1. The only allowed whitespace characters between tokens
-  // are tab, carriage-return, newline and space.
+  // Skips whitespace and looks up the next token, see
+  // JsonScanner::SkipWhitespaceAndPeek.
   void SkipWhitespace();
 
-  // A JSON string (production JSONString) is subset of valid JavaScript string
-  // literals. The string must only be double-quoted (not single-quoted), and
-  // the only allowed backslash-escapes are ", /, \, b, f, n, r, t and
-  // four-digit hex escapes (uXXXX). Any other use of backslashes is invalid.
-  JsonString ScanJsonString(bool needs_internalization);
+  // Like JsonScanner::ScanJsonPropertyKey, and records element information in
+  // |cont| if the key is an index.
   JsonString ScanJsonPropertyKey(JsonContinuation* cont);
-  base::uc32 ScanUnicodeCharacter();
   Handle<String> MakeString(const JsonString& string,
                             Handle<String> hint = Handle<String>());
 
+  // Computes the raw hash fields of all property keys in {properties} that
+  // are internalized directly from the source in one batch, and 0 for the
+  // other keys.
+  void HashPropertyKeys(const JsonProperty* properties, int count,
+                        uint32_t* raw_hash_fields);
+  // Like MakeString for keys with a hash computed by HashPropertyKeys.
+  Handle<String> MakeStringWithHash(const JsonString& string,
+                                    uint32_t raw_hash_field);
+
   template <typename SinkChar>
   void DecodeString(SinkChar* sink, int start, int length);
 
@@ -310,12 +509,7 @@ class JsonParser final {
                               Handle<SinkSeqString> intermediate,
                               Handle<String> hint);
 
-  // A JSON number (production JSONNumber) is a subset of the valid JavaScript
-  // decimal number literals.
-  // It includes an optional minus sign, must have at least one
-  // digit before and after a decimal point, may not have prefixed zeros (unless
-  // the integer part is zero), and may include an exponent part (e.g., "e-10").
-  // Hexadecimal and octal numbers are not allowed.
+  // See JsonScanner::ScanJsonNumber.
   Handle<Object> ParseJsonNumber();
 
   // Parse a single JSON value from input (grammar production JSONValue).
@@ -324,6 +518,17 @@ class JsonParser final {
   template <bool should_track_json_source>
   MaybeHandle<Object> ParseJsonValue(Handle<Object> reviver);
 
+  // Like ParseJsonValue, but driven by a JsonTape instead of the source.
+  MaybeHandle<Object> ParseJsonTape(const JsonTape& tape);
+  JsonString MakeTapeKey(const JsonTape::Entry& entry, int offset,
+                         JsonContinuation* cont);
+
+  // Returns the map of the previous element if the object that is about to be
+  // built is an element of an array, to speed up building objects of the same
+  // shape.
+  Handle<Map> ObjectFeedback(const std::vector<JsonContinuation>& cont_stack,
+                             const SmallVector<Handle<Object>>& element_stack);
+
   Handle<Object> BuildJsonObject(
       const JsonContinuation& cont,
       const SmallVector<JsonProperty>& property_stack, Handle<Map> feedback);
@@ -351,6 +556,12 @@ class JsonParser final {
   void ReportUnexpectedToken(
       JsonToken token,
       base::Optional<MessageTemplate> errorMessage = base::nullopt);
+  // Called by JsonScanner for invalid input.
+  void ReportScanError(JsonToken token,
+                       base::Optional<MessageTemplate> errorMessage) {
+    AllowGarbageCollection allow_before_exception;
+    ReportUnexpectedToken(token, errorMessage);
+  }
 
   inline Isolate* isolate() { return isolate_; }
   inline Factory* factory() { return isolate_->factory(); }
@@ -378,13 +589,6 @@ class JsonParser final {
  private:
   static const bool kIsOneByte = sizeof(Char) == 1;
 
-  bool is_at_end() const {
-    DCHECK_LE(cursor_, end_);
-    return cursor_ == end_;
-  }
-
-  int position() const { return static_cast<int>(cursor_ - chars_); }
-
   Isolate* isolate_;
   const uint64_t hash_seed_;
   JsonToken next_;
@@ -396,18 +600,11 @@ class JsonParser final {
   // The parsed value's source to be passed to the reviver, if the reviver is
   // callable.
   MaybeHandle<Object> parsed_val_node_;
-
-  // Cached pointer to the raw chars in source. In case source is on-heap, we
-  // register an UpdatePointers callback. For this reason, chars_, cursor_ and
-  // end_ should never be locally cached across a possible allocation. The scope
-  // in which we cache chars has to be guarded by a DisallowGarbageCollection
-  // scope.
-  const Char* cursor_;
-  const Char* end_;
-  const Char* chars_;
 };
 
 // Explicit instantiation declarations.
+extern template class JsonScanner<uint8_t, JsonParser<uint8_t>>;
+extern template class JsonScanner<uint16_t, JsonParser<uint16_t>>;
 extern template class JsonParser<uint8_t>;
 extern template class JsonParser<uint16_t>;
 
@@ -0,0 +1,25 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_JSON_JSON_SIMD_H_
+#define V8_JSON_JSON_SIMD_H_
+
+#include "src/base/build_config.h"
+
+// Selects the vector instructions that the JSON parser and stringifier use to
+// scan strings 16 bytes at a time. Defines V8_JSON_USE_SSE2 or
+// V8_JSON_USE_NEON if they are available on the host, and neither otherwise.
+#if (defined(__SSE2__) ||  \
+     (defined(_MSC_VER) && \
+      (defined(_M_X64) || (defined(_M_IX86) && _M_IX86_FP >= 2))))
+#define V8_JSON_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+// Like src/objects/simd.cc, we only use Neon on 64-bit ARM, where it is
+// guaranteed to be available.
+#define V8_JSON_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#endif  // V8_JSON_JSON_SIMD_H_
@@ -4,8 +4,11 @@
 
 #include "src/json/json-stringifier.h"
 
+#include "include/v8-profiler.h"
+#include "src/base/bits.h"
 #include "src/base/strings.h"
 #include "src/common/message-template.h"
+#include "src/json/json-simd.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/heap-number-inl.h"
 #include "src/objects/js-array-inl.h"
@@ -16,10 +19,91 @@
 #include "src/objects/ordered-hash-table.h"
 #include "src/objects/smi.h"
 #include "src/strings/string-builder-inl.h"
+#include "src/strings/unicode-inl.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+// Characters that can be copied to the output as they are. Everything else
+// goes through the escape table or, for surrogates, the surrogate pair check.
+// Note that this includes characters that DoNotEscape() rejects but that the
+// escape table maps to themselves, like 0x7F.
+template <typename Char>
+V8_INLINE bool IsUnescapedJsonChar(Char c) {
+  return c >= 0x20 && c != '"' && c != '\\' &&
+         (sizeof(Char) == 1 ||
+          !base::IsInRange(c, static_cast<Char>(0xD800),
+                           static_cast<Char>(0xDFFF)));
+}
+
+// Returns the number of leading characters of |chars| that can be copied to
+// the output unchanged. Uses SIMD to classify 16 bytes at a time, since most
+// strings contain long runs of such characters or need no escaping at all.
+template <typename Char>
+V8_INLINE int CountUnescapedJsonChars(const Char* chars, int length) {
+  int i = 0;
+#if defined(V8_JSON_USE_SSE2) || defined(V8_JSON_USE_NEON)
+  constexpr int kCharsPerVector = 16 / sizeof(Char);
+  for (; i + kCharsPerVector <= length; i += kCharsPerVector) {
+#ifdef V8_JSON_USE_SSE2
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    __m128i escape;
+    if constexpr (sizeof(Char) == 1) {
+      // c < 0x20 iff the saturating difference c - 0x1F is zero.
+      escape = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                       _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+          _mm_cmpeq_epi8(_mm_subs_epu8(v, _mm_set1_epi8(0x1F)),
+                         _mm_setzero_si128()));
+    } else {
+      __m128i surrogate = _mm_cmpeq_epi16(
+          _mm_and_si128(v, _mm_set1_epi16(static_cast<int16_t>(0xF800))),
+          _mm_set1_epi16(static_cast<int16_t>(0xD800)));
+      escape = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi16(v, _mm_set1_epi16('"')),
+                       _mm_cmpeq_epi16(v, _mm_set1_epi16('\\'))),
+          _mm_or_si128(_mm_cmpeq_epi16(_mm_subs_epu16(v, _mm_set1_epi16(0x1F)),
+                                       _mm_setzero_si128()),
+                       surrogate));
+    }
+    int mask = _mm_movemask_epi8(escape);
+    if (mask != 0) {
+      return i + base::bits::CountTrailingZeros32(mask) / sizeof(Char);
+    }
+#else
+    uint8x16_t escape;
+    if constexpr (sizeof(Char) == 1) {
+      uint8x16_t v = vld1q_u8(chars + i);
+      escape = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')),
+                                 vceqq_u8(v, vdupq_n_u8('\\'))),
+                        vcltq_u8(v, vdupq_n_u8(0x20)));
+    } else {
+      uint16x8_t v = vld1q_u16(chars + i);
+      uint16x8_t surrogate =
+          vceqq_u16(vandq_u16(v, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800));
+      escape = vreinterpretq_u8_u16(
+          vorrq_u16(vorrq_u16(vceqq_u16(v, vdupq_n_u16('"')),
+                              vceqq_u16(v, vdupq_n_u16('\\'))),
+                    vorrq_u16(vcltq_u16(v, vdupq_n_u16(0x20)), surrogate)));
+    }
+    // Narrow every byte of the comparison result to a nibble to get a
+    // movemask equivalent.
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(escape), 4)), 0);
+    if (mask != 0) {
+      return i + base::bits::CountTrailingZeros64(mask) / (4 * sizeof(Char));
+    }
+#endif  // V8_JSON_USE_SSE2
+  }
+#endif  // V8_JSON_USE_SSE2 || V8_JSON_USE_NEON
+  while (i < length && IsUnescapedJsonChar(chars[i])) i++;
+  return i;
+}
+
+}  // namespace
+
 class JsonStringifier {
  public:
   explicit JsonStringifier(Isolate* isolate);
@@ -34,8 +118,14 @@ class JsonStringifier {
                                                       Handle<Object> replacer,
                                                       Handle<Object> gap);
 
+  V8_WARN_UNUSED_RESULT Maybe<bool> StringifyToStream(Handle<Object> object,
+                                                      Handle<Object> gap,
+                                                      OutputStream* stream);
+
  private:
-  enum Result { UNCHANGED, SUCCESS, EXCEPTION };
+  // ABORTED is only returned in stream mode, once the stream has asked to
+  // abort; serialization then stops without running any more user code.
+  enum Result { UNCHANGED, SUCCESS, EXCEPTION, ABORTED };
 
   bool InitializeReplacer(Handle<Object> replacer);
   bool InitializeGap(Handle<Object> gap);
@@ -221,6 +311,11 @@ class JsonStringifier {
     }
 
     V8_INLINE void Append(DestChar c) { *(cursor_++) = c; }
+    template <typename SrcChar>
+    V8_INLINE void AppendChars(const SrcChar* chars, int length) {
+      CopyChars(cursor_, chars, length);
+      cursor_ += length;
+    }
     V8_INLINE void AppendCString(const char* s) {
       const uint8_t* u = reinterpret_cast<const uint8_t*>(s);
       while (*u != '\0') Append(*(u++));
@@ -265,6 +360,8 @@ class JsonStringifier {
 
   static const int kInitialPartLength = 2048;
   static const int kMaxPartLength = 16 * 1024;
+  // Long strings are serialized in segments of at least this many characters.
+  static const int kMinStringSegmentLength = 16;
   static const int kPartLengthGrowthFactor = 2;
 
   Factory* factory() { return isolate_->factory(); }
@@ -272,6 +369,12 @@ class JsonStringifier {
   V8_NOINLINE void Extend();
   V8_NOINLINE void ChangeEncoding();
 
+  // Converts the buffered characters to UTF-8 and hands them to stream_. Unless
+  // |final| is set, a trailing lead surrogate stays in the buffer, since its
+  // trail surrogate has not been appended yet.
+  void FlushToStream(bool final);
+  void WriteStreamChunk();
+
   Isolate* isolate_;
   String::Encoding encoding_;
   Handle<FixedArray> property_list_;
@@ -286,6 +389,16 @@ class JsonStringifier {
   int current_index_;
   bool overflowed_;
 
+  // When set, the result is written to the stream in chunks instead of being
+  // accumulated into a string; the buffer above is flushed whenever it fills
+  // up, which keeps memory use bounded by the chunk size and the longest
+  // string that is serialized.
+  OutputStream* stream_ = nullptr;
+  bool stream_aborted_ = false;
+  std::unique_ptr<char[]> stream_chunk_;
+  int stream_chunk_size_ = 0;
+  int stream_chunk_position_ = 0;
+
   using KeyObject = std::pair<Handle<Object>, Handle<Object>>;
   std::vector<KeyObject> stack_;
 
@@ -299,6 +412,12 @@ MaybeHandle<Object> JsonStringify(Isolate* isolate, Handle<Object> object,
   return stringifier.Stringify(object, replacer, gap);
 }
 
+Maybe<bool> JsonStringifyToStream(Isolate* isolate, Handle<Object> object,
+                                  Handle<Object> gap, OutputStream* stream) {
+  JsonStringifier stringifier(isolate);
+  return stringifier.StringifyToStream(object, gap, stream);
+}
+
 // Translation table to escape Latin1 characters.
 // Table entries start at a multiple of 8 and are null-terminated.
 const char* const JsonStringifier::JsonEscapeTable =
@@ -412,6 +531,31 @@ MaybeHandle<Object> JsonStringifier::Stringify(Handle<Object> object,
   return MaybeHandle<Object>();
 }
 
+Maybe<bool> JsonStringifier::StringifyToStream(Handle<Object> object,
+                                               Handle<Object> gap,
+                                               OutputStream* stream) {
+  if (!IsUndefined(*gap, isolate_) && !InitializeGap(gap)) {
+    CHECK(isolate_->has_pending_exception());
+    return Nothing<bool>();
+  }
+  stream_ = stream;
+  stream_chunk_size_ =
+      std::max(stream->GetChunkSize(),
+               static_cast<int>(unibrow::Utf8::kMaxEncodedSize));
+  stream_chunk_.reset(new char[stream_chunk_size_]);
+  Result result = SerializeObject(object);
+  if (result == UNCHANGED) return Just(false);
+  if (result == SUCCESS || result == ABORTED) {
+    FlushToStream(true);
+    if (!stream_aborted_ && stream_chunk_position_ > 0) WriteStreamChunk();
+    if (!stream_aborted_) stream_->EndOfStream();
+    return Just(true);
+  }
+  DCHECK(result == EXCEPTION);
+  CHECK(isolate_->has_pending_exception());
+  return Nothing<bool>();
+}
+
 bool JsonStringifier::InitializeReplacer(Handle<Object> replacer) {
   DCHECK(property_list_.is_null());
   DCHECK(replacer_function_.is_null());
@@ -710,6 +854,7 @@ JsonStringifier::Result JsonStringifier::Serialize_(Handle<Object> object,
       IsException(isolate_->stack_guard()->HandleInterrupts(), isolate_)) {
     return EXCEPTION;
   }
+  if (V8_UNLIKELY(stream_aborted_)) return ABORTED;
 
   Handle<Object> initial_value = object;
   PtrComprCageBase cage_base(isolate_);
@@ -906,6 +1051,7 @@ JsonStringifier::Result JsonStringifier::SerializeJSArray(
             SerializeSmi(Smi::cast(elements->get(cage_base, i)));
           }
           if (i >= length) break;
+          if (V8_UNLIKELY(stream_aborted_)) return ABORTED;
           DCHECK_LT(limit, kMaxAllowedFastPackedLength);
           limit = std::min(length, limit + kInterruptLength);
           if (interrupt_check.InterruptRequested() &&
@@ -925,6 +1071,7 @@ JsonStringifier::Result JsonStringifier::SerializeJSArray(
             SerializeDouble(elements->get_scalar(i));
           }
           if (i >= length) break;
+          if (V8_UNLIKELY(stream_aborted_)) return ABORTED;
           DCHECK_LT(limit, kMaxAllowedFastPackedLength);
           limit = std::min(length, limit + kInterruptLength);
           if (interrupt_check.InterruptRequested() &&
@@ -984,6 +1131,7 @@ JsonStringifier::Result JsonStringifier::SerializeArrayLikeSlow(
   }
   HandleScope handle_scope(isolate_);
   for (uint32_t i = start; i < length; i++) {
+    if (V8_UNLIKELY(stream_aborted_)) return ABORTED;
     Separator(i == 0);
     Handle<Object> element;
     ASSIGN_RETURN_ON_EXCEPTION_VALUE(
@@ -1049,6 +1197,7 @@ JsonStringifier::Result JsonStringifier::SerializeJSObject(
   Indent();
   bool comma = false;
   for (InternalIndex i : map->IterateOwnDescriptors()) {
+    if (V8_UNLIKELY(stream_aborted_)) return ABORTED;
     Handle<String> key_name;
     PropertyDetails details = PropertyDetails::Empty();
     {
@@ -1099,6 +1248,7 @@ JsonStringifier::Result JsonStringifier::SerializeJSReceiverSlow(
   Indent();
   bool comma = false;
   for (int i = 0; i < contents->length(); i++) {
+    if (V8_UNLIKELY(stream_aborted_)) return ABORTED;
     Handle<String> key(String::cast(contents->get(i)), isolate_);
     Handle<Object> property;
     ASSIGN_RETURN_ON_EXCEPTION_VALUE(
@@ -1158,6 +1308,12 @@ void JsonStringifier::SerializeStringUnchecked_(
   // The <base::uc16, char> version of this method must not be called.
   DCHECK(sizeof(DestChar) >= sizeof(SrcChar));
   for (int i = 0; i < src.length(); i++) {
+    // Copy the run of characters that need no escaping in bulk.
+    int unescaped =
+        CountUnescapedJsonChars(src.begin() + i, src.length() - i);
+    dest->AppendChars(src.begin() + i, unescaped);
+    i += unescaped;
+    if (i == src.length()) break;
     SrcChar c = src[i];
     if (DoNotEscape(c)) {
       dest->Append(c);
@@ -1223,56 +1379,31 @@ void JsonStringifier::SerializeString_(Handle<String> string) {
         &current_index_);
     SerializeStringUnchecked_(vector, &no_extend);
   } else {
-    FlatStringReader reader(isolate_, string);
-    for (int i = 0; i < reader.length(); i++) {
-      SrcChar c = reader.Get<SrcChar>(i);
-      if (DoNotEscape(c)) {
-        Append<SrcChar, DestChar>(c);
-      } else if (sizeof(SrcChar) != 1 &&
-                 base::IsInRange(c, static_cast<SrcChar>(0xD800),
-                                 static_cast<SrcChar>(0xDFFF))) {
-        // The current character is a surrogate.
-        if (c <= 0xDBFF) {
-          // The current character is a leading surrogate.
-          if (i + 1 < reader.length()) {
-            // There is a next character.
-            SrcChar next = reader.Get<SrcChar>(i + 1);
-            if (base::IsInRange(next, static_cast<SrcChar>(0xDC00),
-                                static_cast<SrcChar>(0xDFFF))) {
-              // The next character is a trailing surrogate, meaning this is a
-              // surrogate pair.
-              Append<SrcChar, DestChar>(c);
-              Append<SrcChar, DestChar>(next);
-              i++;
-            } else {
-              // The next character is not a trailing surrogate. Thus, the
-              // current character is a lone leading surrogate.
-              AppendCStringLiteral("\\u");
-              char* const hex = DoubleToRadixCString(c, 16);
-              AppendCString(hex);
-              DeleteArray(hex);
-            }
-          } else {
-            // There is no next character. Thus, the current character is a
-            // lone leading surrogate.
-            AppendCStringLiteral("\\u");
-            char* const hex = DoubleToRadixCString(c, 16);
-            AppendCString(hex);
-            DeleteArray(hex);
-          }
-        } else {
-          // The current character is a lone trailing surrogate. (If it had
-          // been preceded by a leading surrogate, we would've ended up in the
-          // other branch earlier on, and the current character would've been
-          // handled as part of the surrogate pair already.)
-          AppendCStringLiteral("\\u");
-          char* const hex = DoubleToRadixCString(c, 16);
-          AppendCString(hex);
-          DeleteArray(hex);
-        }
-      } else {
-        AppendCString(&JsonEscapeTable[c * kJsonEscapeTableEntrySize]);
+    // Serialize the string in segments whose escaped form is guaranteed to
+    // fit into the current part, so that every segment takes the same bulk
+    // copying path as short strings.
+    int start = 0;
+    while (start < length) {
+      int capacity = (part_length_ - current_index_ - 1) >> 3;
+      if (capacity < kMinStringSegmentLength) {
+        Extend();
+        continue;
+      }
+      DisallowGarbageCollection no_gc;
+      base::Vector<const SrcChar> vector =
+          string->GetCharVector<SrcChar>(no_gc);
+      int end = start + std::min(length - start, capacity);
+      // Don't split a surrogate pair across segments, otherwise both halves
+      // would be escaped as lone surrogates.
+      if (sizeof(SrcChar) != 1 && end < length &&
+          unibrow::Utf16::IsLeadSurrogate(vector[end - 1])) {
+        end--;
       }
+      NoExtendBuilder<DestChar> no_extend(
+          reinterpret_cast<DestChar*>(part_ptr_) + current_index_,
+          &current_index_);
+      SerializeStringUnchecked_(vector.SubVector(start, end), &no_extend);
+      start = end;
     }
   }
   Append<uint8_t, DestChar>('"');
@@ -1333,6 +1464,13 @@ void JsonStringifier::SerializeString(Handle<String> object) {
 }
 
 void JsonStringifier::Extend() {
+  if (stream_ != nullptr) {
+    int buffered = current_index_;
+    FlushToStream(false);
+    // Only grow the buffer if flushing didn't make room, e.g. for a string
+    // that doesn't fit into an empty buffer.
+    if (current_index_ < buffered) return;
+  }
   if (part_length_ >= String::kMaxLength) overflowed_ = true;
   part_length_ *= kPartLengthGrowthFactor;
   if (encoding_ == String::ONE_BYTE_ENCODING) {
@@ -1352,6 +1490,54 @@ void JsonStringifier::Extend() {
   }
 }
 
+void JsonStringifier::FlushToStream(bool final) {
+  DCHECK_NOT_NULL(stream_);
+  int length = current_index_;
+  bool keep_lead_surrogate =
+      !final && encoding_ == String::TWO_BYTE_ENCODING && length > 0 &&
+      unibrow::Utf16::IsLeadSurrogate(two_byte_ptr_[length - 1]);
+  if (keep_lead_surrogate) length--;
+  if (!stream_aborted_) {
+    for (int i = 0; i < length; i++) {
+      char encoded[unibrow::Utf8::kMaxEncodedSize];
+      int encoded_length;
+      if (encoding_ == String::ONE_BYTE_ENCODING) {
+        encoded_length =
+            unibrow::Utf8::EncodeOneByte(encoded, one_byte_ptr_[i]);
+      } else {
+        unibrow::uchar c = two_byte_ptr_[i];
+        if (i + 1 < length &&
+            unibrow::Utf16::IsSurrogatePair(c, two_byte_ptr_[i + 1])) {
+          c = unibrow::Utf16::CombineSurrogatePair(c, two_byte_ptr_[++i]);
+        }
+        // Lone surrogates can only come from the gap or raw JSON; they are
+        // replaced since they cannot be represented in UTF-8.
+        encoded_length = unibrow::Utf8::Encode(
+            encoded, c, unibrow::Utf16::kNoPreviousCharacter, true);
+      }
+      if (stream_chunk_size_ - stream_chunk_position_ < encoded_length) {
+        WriteStreamChunk();
+        if (stream_aborted_) break;
+      }
+      memcpy(stream_chunk_.get() + stream_chunk_position_, encoded,
+             encoded_length);
+      stream_chunk_position_ += encoded_length;
+    }
+  }
+  // Once the stream has been aborted, the output is simply discarded.
+  if (keep_lead_surrogate) two_byte_ptr_[0] = two_byte_ptr_[length];
+  current_index_ = keep_lead_surrogate ? 1 : 0;
+}
+
+void JsonStringifier::WriteStreamChunk() {
+  DCHECK(!stream_aborted_);
+  if (stream_->WriteAsciiChunk(stream_chunk_.get(), stream_chunk_position_) ==
+      OutputStream::kAbort) {
+    stream_aborted_ = true;
+  }
+  stream_chunk_position_ = 0;
+}
+
 void JsonStringifier::ChangeEncoding() {
   encoding_ = String::TWO_BYTE_ENCODING;
   two_byte_ptr_ = new base::uc16[part_length_];
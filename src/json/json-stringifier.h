@@ -8,12 +8,23 @@
 #include "src/objects/objects.h"
 
 namespace v8 {
+
+class OutputStream;
+
 namespace internal {
 
 V8_WARN_UNUSED_RESULT MaybeHandle<Object> JsonStringify(Isolate* isolate,
                                                         Handle<Object> object,
                                                         Handle<Object> replacer,
                                                         Handle<Object> gap);
+
+// Like JsonStringify, but writes the result to |stream| as UTF-8 while
+// serializing. Returns false if |object| is not serializable, in which case
+// nothing is written.
+V8_WARN_UNUSED_RESULT Maybe<bool> JsonStringifyToStream(Isolate* isolate,
+                                                        Handle<Object> object,
+                                                        Handle<Object> gap,
+                                                        OutputStream* stream);
 }  // namespace internal
 }  // namespace v8
 
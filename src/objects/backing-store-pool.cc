@@ -0,0 +1,136 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/objects/backing-store-pool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/base/bits.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+
+namespace v8 {
+namespace internal {
+
+BackingStorePool::BackingStorePool(Isolate* isolate)
+    : allocator_(isolate->array_buffer_allocator()),
+      allocator_shared_(isolate->array_buffer_allocator_shared()) {
+  DCHECK_NOT_NULL(allocator_);
+}
+
+BackingStorePool::~BackingStorePool() {
+  // No backing store refers to the pool anymore, so there are no concurrent
+  // frees.
+  Trim();
+}
+
+// static
+size_t BackingStorePool::MaxBlockSize() {
+  const size_t max_block_size =
+      std::min<size_t>(size_t{v8_flags.backing_store_pool_max_block_size} * KB,
+                       kMinBlockSize << (kNumSizeClasses - 1));
+  // Lengths between the largest power of two and the flag value would need
+  // the next size class.
+  return base::bits::RoundDownToPowerOfTwo32(
+      static_cast<uint32_t>(max_block_size));
+}
+
+// static
+int BackingStorePool::SizeClass(size_t byte_length) {
+  DCHECK(IsPoolable(byte_length));
+  const size_t block_size = std::max(
+      kMinBlockSize, base::bits::RoundUpToPowerOfTwo(byte_length));
+  const int size_class = base::bits::WhichPowerOfTwo(block_size) -
+                         base::bits::WhichPowerOfTwo(kMinBlockSize);
+  DCHECK_LT(size_class, kNumSizeClasses);
+  return size_class;
+}
+
+// static
+size_t BackingStorePool::BlockSize(size_t byte_length) {
+  return kMinBlockSize << SizeClass(byte_length);
+}
+
+void* BackingStorePool::Allocate(size_t byte_length,
+                                 InitializedFlag initialized) {
+  const int size_class = SizeClass(byte_length);
+  const size_t block_size = kMinBlockSize << size_class;
+  LocalCache& cache = local_[size_class];
+  if (cache.count == 0) Refill(size_class);
+  if (cache.count > 0) {
+    void* block = cache.blocks[--cache.count];
+    cached_bytes_.fetch_sub(block_size, std::memory_order_relaxed);
+    // Only the bytes that are visible to JavaScript need to be cleared.
+    if (initialized == InitializedFlag::kZeroInitialized) {
+      memset(block, 0, byte_length);
+    }
+    return block;
+  }
+  return initialized == InitializedFlag::kUninitialized
+             ? allocator_->AllocateUninitialized(block_size)
+             : allocator_->Allocate(block_size);
+}
+
+void BackingStorePool::Free(void* block, size_t block_size) {
+  DCHECK_EQ(block_size, BlockSize(block_size));
+  if (!TryCache(block_size)) {
+    allocator_->Free(block, block_size);
+    return;
+  }
+  SharedFreeList& list = shared_[SizeClass(block_size)];
+  base::MutexGuard guard(&list.mutex);
+  list.blocks.push_back(block);
+}
+
+bool BackingStorePool::TryCache(size_t block_size) {
+  if (torn_down_.load(std::memory_order_relaxed)) return false;
+  const size_t limit = size_t{v8_flags.backing_store_pool_size} * KB;
+  size_t cached_bytes = cached_bytes_.load(std::memory_order_relaxed);
+  do {
+    if (cached_bytes + block_size > limit) return false;
+  } while (!cached_bytes_.compare_exchange_weak(cached_bytes,
+                                                cached_bytes + block_size,
+                                                std::memory_order_relaxed));
+  return true;
+}
+
+void BackingStorePool::Refill(int size_class) {
+  LocalCache& cache = local_[size_class];
+  SharedFreeList& list = shared_[size_class];
+  DCHECK_EQ(0, cache.count);
+  base::MutexGuard guard(&list.mutex);
+  // Move a batch of blocks so that the lock is taken once per batch.
+  const size_t count =
+      std::min<size_t>(list.blocks.size(), kLocalCacheSize);
+  std::copy(list.blocks.end() - count, list.blocks.end(), cache.blocks.begin());
+  list.blocks.resize(list.blocks.size() - count);
+  cache.count = static_cast<int>(count);
+}
+
+void BackingStorePool::Trim() {
+  for (int size_class = 0; size_class < kNumSizeClasses; size_class++) {
+    const size_t block_size = kMinBlockSize << size_class;
+    LocalCache& cache = local_[size_class];
+    std::vector<void*> blocks;
+    {
+      base::MutexGuard guard(&shared_[size_class].mutex);
+      blocks.swap(shared_[size_class].blocks);
+    }
+    blocks.insert(blocks.end(), cache.blocks.begin(),
+                  cache.blocks.begin() + cache.count);
+    cache.count = 0;
+    for (void* block : blocks) allocator_->Free(block, block_size);
+    cached_bytes_.fetch_sub(blocks.size() * block_size,
+                            std::memory_order_relaxed);
+  }
+}
+
+void BackingStorePool::TearDown() {
+  torn_down_.store(true, std::memory_order_relaxed);
+  Trim();
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,100 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_OBJECTS_BACKING_STORE_POOL_H_
+#define V8_OBJECTS_BACKING_STORE_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/v8-array-buffer.h"
+#include "src/base/platform/mutex.h"
+#include "src/common/globals.h"
+#include "src/objects/backing-store.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+
+// Caches the memory of small array buffer backing stores per isolate, so that
+// short-lived array buffers do not go through the embedder's
+// ArrayBuffer::Allocator for every allocation. Blocks are obtained from the
+// embedder's allocator in power-of-two size classes and kept in the pool when
+// their backing store dies, up to --backing-store-pool-size.
+//
+// Blocks are allocated on the isolate's thread, which refills an unsynchronized
+// local cache from the shared per-class free lists in batches. Blocks are
+// usually freed by the ArrayBufferSweeper on a background thread and go
+// straight to the shared free lists.
+class V8_EXPORT_PRIVATE BackingStorePool final {
+ public:
+  static constexpr size_t kMinBlockSize = 16;
+
+  explicit BackingStorePool(Isolate* isolate);
+  ~BackingStorePool();
+
+  BackingStorePool(const BackingStorePool&) = delete;
+  BackingStorePool& operator=(const BackingStorePool&) = delete;
+
+  // Returns whether backing stores of the given size are served by the pool.
+  static bool IsPoolable(size_t byte_length) {
+    return byte_length > 0 && byte_length <= MaxBlockSize();
+  }
+  // The size of the block that holds `byte_length` bytes.
+  static size_t BlockSize(size_t byte_length);
+
+  // Must be called on the isolate's thread. Returns nullptr if the embedder's
+  // allocator fails.
+  void* Allocate(size_t byte_length, InitializedFlag initialized);
+  // May be called on any thread. `block_size` is the size returned by
+  // BlockSize().
+  void Free(void* block, size_t block_size);
+
+  // Returns all cached blocks to the embedder's allocator. Must be called on
+  // the isolate's thread.
+  void Trim();
+  // Trims the pool and stops caching blocks. Backing stores may outlive their
+  // isolate, so the pool stays alive until the last of them is freed.
+  void TearDown();
+
+  v8::ArrayBuffer::Allocator* allocator() const { return allocator_; }
+  size_t CachedBytes() const {
+    return cached_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr int kNumSizeClasses = 17;  // 16 bytes to 1 MB.
+  static constexpr int kLocalCacheSize = 16;
+
+  struct LocalCache {
+    int count = 0;
+    std::array<void*, kLocalCacheSize> blocks;
+  };
+
+  struct SharedFreeList {
+    base::Mutex mutex;
+    std::vector<void*> blocks;
+  };
+
+  static size_t MaxBlockSize();
+  static int SizeClass(size_t byte_length);
+
+  bool TryCache(size_t block_size);
+  void Refill(int size_class);
+
+  v8::ArrayBuffer::Allocator* const allocator_;
+  const std::shared_ptr<v8::ArrayBuffer::Allocator> allocator_shared_;
+  std::array<LocalCache, kNumSizeClasses> local_;
+  std::array<SharedFreeList, kNumSizeClasses> shared_;
+  std::atomic<size_t> cached_bytes_{0};
+  std::atomic<bool> torn_down_{false};
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_OBJECTS_BACKING_STORE_POOL_H_
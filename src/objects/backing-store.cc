@@ -4,11 +4,13 @@
 
 #include "src/objects/backing-store.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "src/execution/isolate.h"
 #include "src/handles/global-handles.h"
 #include "src/logging/counters.h"
+#include "src/objects/backing-store-pool.h"
 #include "src/sandbox/sandbox.h"
 
 #if V8_ENABLE_WEBASSEMBLY
@@ -142,6 +144,7 @@ BackingStore::BackingStore(void* buffer_start, size_t byte_length,
       is_resizable_by_js_(resizable == ResizableFlag::kResizable),
       is_wasm_memory_(is_wasm_memory),
       holds_shared_ptr_to_allocator_(false),
+      is_pooled_(false),
       free_on_destruct_(free_on_destruct),
       has_guard_regions_(has_guard_regions),
       globally_registered_(false),
@@ -170,6 +173,11 @@ BackingStore::~BackingStore() {
     BackingStore* const bs;
 
     ~ClearSharedAllocator() {
+      if (bs->is_pooled_) {
+        bs->type_specific_data_.backing_store_pool
+            .std::shared_ptr<BackingStorePool>::~shared_ptr();
+        return;
+      }
       if (!bs->holds_shared_ptr_to_allocator_) return;
       bs->type_specific_data_.v8_api_array_buffer_allocator_shared
           .std::shared_ptr<v8::ArrayBuffer::Allocator>::~shared_ptr();
@@ -226,6 +234,15 @@ BackingStore::~BackingStore() {
     return;
   }
 
+  if (is_pooled_) {
+    DCHECK(free_on_destruct_);
+    TRACE_BS("BS:pool   bs=%p mem=%p (length=%zu, capacity=%zu)\n", this,
+             buffer_start_, byte_length(), byte_capacity_);
+    type_specific_data_.backing_store_pool->Free(buffer_start_,
+                                                 byte_capacity_);
+    return;
+  }
+
   if (free_on_destruct_) {
     // JSArrayBuffer backing store. Deallocate through the embedder's allocator.
     auto allocator = get_v8_api_array_buffer_allocator();
@@ -242,6 +259,13 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
   void* buffer_start = nullptr;
   auto allocator = isolate->array_buffer_allocator();
   CHECK_NOT_NULL(allocator);
+  std::shared_ptr<BackingStorePool> pool;
+  if (shared == SharedFlag::kNotShared &&
+      BackingStorePool::IsPoolable(byte_length)) {
+    pool = isolate->heap()->backing_store_pool();
+  }
+  const size_t byte_capacity =
+      pool ? BackingStorePool::BlockSize(byte_length) : byte_length;
   if (byte_length != 0) {
     auto counters = isolate->counters();
     int mb_length = static_cast<int>(byte_length / MB);
@@ -251,7 +275,9 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
     if (shared == SharedFlag::kShared) {
       counters->shared_array_allocations()->AddSample(mb_length);
     }
-    auto allocate_buffer = [allocator, initialized](size_t byte_length) {
+    auto allocate_buffer = [allocator, initialized,
+                            pool = pool.get()](size_t byte_length) {
+      if (pool) return pool->Allocate(byte_length, initialized);
       if (initialized == InitializedFlag::kUninitialized) {
         return allocator->AllocateUninitialized(byte_length);
       }
@@ -290,7 +316,7 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
   auto result = new BackingStore(buffer_start,                  // start
                                  byte_length,                   // length
                                  byte_length,                   // max length
-                                 byte_length,                   // capacity
+                                 byte_capacity,                 // capacity
                                  shared,                        // shared
                                  ResizableFlag::kNotResizable,  // resizable
                                  false,   // is_wasm_memory
@@ -301,7 +327,11 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
 
   TRACE_BS("BS:alloc  bs=%p mem=%p (length=%zu)\n", result,
            result->buffer_start(), byte_length);
-  result->SetAllocatorFromIsolate(isolate);
+  if (pool) {
+    result->SetPool(std::move(pool));
+  } else {
+    result->SetAllocatorFromIsolate(isolate);
+  }
   return std::unique_ptr<BackingStore>(result);
 }
 
@@ -317,6 +347,21 @@ void BackingStore::SetAllocatorFromIsolate(Isolate* isolate) {
   }
 }
 
+void BackingStore::SetPool(std::shared_ptr<BackingStorePool> pool) {
+  DCHECK(!holds_shared_ptr_to_allocator_);
+  is_pooled_ = true;
+  new (&type_specific_data_.backing_store_pool)
+      std::shared_ptr<BackingStorePool>(std::move(pool));
+}
+
+void BackingStore::ReleaseToPool() {
+  DCHECK(is_pooled_);
+  type_specific_data_.backing_store_pool->Free(buffer_start_, byte_capacity_);
+  type_specific_data_.backing_store_pool
+      .std::shared_ptr<BackingStorePool>::~shared_ptr();
+  is_pooled_ = false;
+}
+
 std::unique_ptr<BackingStore> BackingStore::TryAllocateAndPartiallyCommitMemory(
     Isolate* isolate, size_t byte_length, size_t max_byte_length,
     size_t page_size, size_t initial_pages, size_t maximum_pages,
@@ -782,10 +827,24 @@ bool BackingStore::Reallocate(Isolate* isolate, size_t new_byte_length) {
   CHECK(CanReallocate());
   auto allocator = get_v8_api_array_buffer_allocator();
   CHECK_EQ(isolate->array_buffer_allocator(), allocator);
-  CHECK_EQ(byte_length_, byte_capacity_);
-  void* new_start =
-      allocator->Reallocate(buffer_start_, byte_length_, new_byte_length);
-  if (!new_start) return false;
+  void* new_start;
+  if (is_pooled_) {
+    // The pool only hands out blocks of fixed sizes, so move the contents to
+    // memory of the embedder's allocator.
+    new_start = allocator->AllocateUninitialized(new_byte_length);
+    if (!new_start) return false;
+    size_t bytes_to_copy = std::min(byte_length(), new_byte_length);
+    memcpy(new_start, buffer_start_, bytes_to_copy);
+    memset(reinterpret_cast<uint8_t*>(new_start) + bytes_to_copy, 0,
+           new_byte_length - bytes_to_copy);
+    ReleaseToPool();
+    SetAllocatorFromIsolate(isolate);
+  } else {
+    CHECK_EQ(byte_length_, byte_capacity_);
+    new_start =
+        allocator->Reallocate(buffer_start_, byte_length_, new_byte_length);
+    if (!new_start) return false;
+  }
   buffer_start_ = new_start;
   byte_capacity_ = new_byte_length;
   byte_length_ = new_byte_length;
@@ -795,6 +854,7 @@ bool BackingStore::Reallocate(Isolate* isolate, size_t new_byte_length) {
 
 v8::ArrayBuffer::Allocator* BackingStore::get_v8_api_array_buffer_allocator() {
   CHECK(!is_wasm_memory_);
+  if (is_pooled_) return type_specific_data_.backing_store_pool->allocator();
   auto array_buffer_allocator =
       holds_shared_ptr_to_allocator_
           ? type_specific_data_.v8_api_array_buffer_allocator_shared.get()
@@ -15,6 +15,7 @@
 namespace v8 {
 namespace internal {
 
+class BackingStorePool;
 class Isolate;
 class WasmMemoryObject;
 
@@ -48,7 +49,9 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
   ~BackingStore();
 
   // Allocate an array buffer backing store using the default method,
-  // which currently is the embedder-provided array buffer allocator.
+  // which currently is the embedder-provided array buffer allocator. With
+  // --backing-store-pool, small non-shared backing stores are served by the
+  // isolate's BackingStorePool instead.
   static std::unique_ptr<BackingStore> Allocate(Isolate* isolate,
                                                 size_t byte_length,
                                                 SharedFlag shared,
@@ -103,6 +106,7 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
   bool is_wasm_memory() const { return is_wasm_memory_; }
   bool has_guard_regions() const { return has_guard_regions_; }
   bool free_on_destruct() const { return free_on_destruct_; }
+  bool is_pooled() const { return is_pooled_; }
 
   bool IsEmpty() const {
     DCHECK_GE(byte_capacity_, byte_length_);
@@ -120,7 +124,8 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
            buffer_start_ != nullptr;
   }
 
-  // Wrapper around ArrayBuffer::Allocator::Reallocate.
+  // Wrapper around ArrayBuffer::Allocator::Reallocate. Pooled backing stores
+  // are moved to memory of the embedder's allocator.
   bool Reallocate(Isolate* isolate, size_t new_byte_length);
 
 #if V8_ENABLE_WEBASSEMBLY
@@ -170,6 +175,10 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
       // freed after GC, it would not free the memory block.
       return 0;
     }
+    if (is_pooled_) {
+      // The whole block is unavailable while the backing store is alive.
+      return byte_capacity_;
+    }
     return byte_length();
   }
 
@@ -185,6 +194,9 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
   BackingStore(const BackingStore&) = delete;
   BackingStore& operator=(const BackingStore&) = delete;
   void SetAllocatorFromIsolate(Isolate* isolate);
+  void SetPool(std::shared_ptr<BackingStorePool> pool);
+  // Returns the memory to the pool and releases the reference to it.
+  void ReleaseToPool();
 
   // Accessors for type-specific data.
   v8::ArrayBuffer::Allocator* get_v8_api_array_buffer_allocator();
@@ -216,6 +228,10 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
     std::shared_ptr<v8::ArrayBuffer::Allocator>
         v8_api_array_buffer_allocator_shared;
 
+    // The pool that the memory of a pooled backing store is returned to. The
+    // pool keeps the ArrayBuffer::Allocator that its blocks come from.
+    std::shared_ptr<BackingStorePool> backing_store_pool;
+
     // For shared Wasm memories, this is a list of all the attached memory
     // objects, which is needed to grow shared backing stores.
     SharedWasmMemoryData* shared_wasm_memory_data;
@@ -233,6 +249,7 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
   const bool is_resizable_by_js_ : 1;
   const bool is_wasm_memory_ : 1;
   bool holds_shared_ptr_to_allocator_ : 1;
+  bool is_pooled_ : 1;
   const bool free_on_destruct_ : 1;
   const bool has_guard_regions_ : 1;
   bool globally_registered_ : 1;
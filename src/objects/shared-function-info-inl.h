@@ -284,6 +284,11 @@ BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, maglev_compilation_failed,
 BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, sparkplug_compiled,
                     SharedFunctionInfo::SparkplugCompiledBit)
 
+BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, cached_tiering_decision,
+                    SharedFunctionInfo::CachedTieringDecisionBits)
+BIT_FIELD_ACCESSORS(SharedFunctionInfo, flags2, cached_feedback_unstable,
+                    SharedFunctionInfo::CachedFeedbackUnstableBit)
+
 BIT_FIELD_ACCESSORS(SharedFunctionInfo, relaxed_flags, syntax_kind,
                     SharedFunctionInfo::FunctionSyntaxKindBits)
 
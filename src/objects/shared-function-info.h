@@ -461,6 +461,14 @@ class SharedFunctionInfo
 
   DECL_BOOLEAN_ACCESSORS(sparkplug_compiled)
 
+  // The highest tier closures of this function reached so far. Only recorded
+  // with --profile-guided-optimization.
+  DECL_PRIMITIVE_ACCESSORS(cached_tiering_decision, CachedTieringDecision)
+  // Whether optimized code of this function was thrown away by a deopt, i.e.
+  // its feedback did not settle. Only recorded with
+  // --profile-guided-optimization.
+  DECL_BOOLEAN_ACCESSORS(cached_feedback_unstable)
+
   // Is this function a top-level function (scripts, evals).
   DECL_BOOLEAN_ACCESSORS(is_toplevel)
 
@@ -8,6 +8,7 @@
 
 #include "src/base/atomicops.h"
 #include "src/base/macros.h"
+#include "src/base/platform/yield-processor.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
 #include "src/common/ptr-compr-inl.h"
@@ -69,6 +70,29 @@ int ComputeStringTableCapacityWithShrink(int current_capacity,
   return new_capacity;
 }
 
+// Returns the capacity the table should be resized to before adding
+// {additional_elements}, or -1 if no resize is needed.
+int ComputeStringTableResizeCapacity(int current_capacity, int current_nof,
+                                     int current_deleted,
+                                     int additional_elements) {
+  // Grow or shrink table if needed. We first try to shrink the table, if it
+  // is sufficiently empty; otherwise we make sure to grow it so that it has
+  // enough space.
+  int capacity_after_shrinking = ComputeStringTableCapacityWithShrink(
+      current_capacity, current_nof + additional_elements);
+
+  if (capacity_after_shrinking < current_capacity) {
+    DCHECK(StringTableHasSufficientCapacityToAdd(
+        capacity_after_shrinking, current_nof, 0, additional_elements));
+    return capacity_after_shrinking;
+  } else if (!StringTableHasSufficientCapacityToAdd(
+                 current_capacity, current_nof, current_deleted,
+                 additional_elements)) {
+    return ComputeStringTableCapacity(current_nof + additional_elements);
+  }
+  return -1;
+}
+
 template <typename IsolateT, typename StringTableKey>
 bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, String string) {
   if (string->hash() != key->hash()) return false;
@@ -88,6 +112,12 @@ bool KeyIsMatch(IsolateT* isolate, StringTableKey* key, String string) {
 // The elements themselves are stored as an open-addressed hash table, with
 // quadratic probing and Smi 0 and Smi 1 as the empty and deleted sentinels,
 // respectively.
+//
+// Strings are inserted without locking: an empty slot is first reserved with a
+// compare-and-swap, and then the string is published into it. Deleted slots
+// are never reused by insertions, since another thread could concurrently
+// insert the same string further down the probe sequence; they are dropped
+// when the table is rehashed instead.
 class StringTable::Data {
  public:
   static std::unique_ptr<Data> New(int capacity);
@@ -106,24 +136,27 @@ class StringTable::Data {
     slot(index).Release_Store(entry);
   }
 
-  void ElementAdded() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
-    DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity(), number_of_elements(), number_of_deleted_elements(), 1));
-
-    number_of_elements_++;
+  // Atomically replaces the sentinel {expected} with the sentinel {target}.
+  // Returns whether the replacement happened.
+  bool ReplaceSentinel(InternalIndex index, Smi expected, Smi target) {
+    // Smis are compressed by truncation, regardless of the compression scheme.
+    Tagged_t expected_value = static_cast<Tagged_t>(expected.ptr());
+    Tagged_t target_value = static_cast<Tagged_t>(target.ptr());
+    return AsAtomicTagged::AcquireRelease_CompareAndSwap(
+               &elements_[index.as_uint32()], expected_value, target_value) ==
+           expected_value;
   }
-  void DeletedElementOverwritten() {
-    DCHECK_LT(number_of_elements_ + 1, capacity());
-    DCHECK(StringTableHasSufficientCapacityToAdd(
-        capacity(), number_of_elements(), number_of_deleted_elements() - 1, 1));
 
-    number_of_elements_++;
-    number_of_deleted_elements_--;
+  void ElementAdded() {
+    // Concurrent insertions only check for sufficient capacity before adding,
+    // so the element count may overshoot the limit by the number of inserting
+    // threads. This is fine as long as the table is never full.
+    DCHECK_LT(number_of_elements() + 1, capacity());
+    number_of_elements_.fetch_add(1, std::memory_order_relaxed);
   }
   void ElementsRemoved(int count) {
-    DCHECK_LE(count, number_of_elements_);
-    number_of_elements_ -= count;
+    DCHECK_LE(count, number_of_elements());
+    number_of_elements_.fetch_sub(count, std::memory_order_relaxed);
     number_of_deleted_elements_ += count;
   }
 
@@ -132,7 +165,9 @@ class StringTable::Data {
   void operator delete(void* description);
 
   int capacity() const { return capacity_; }
-  int number_of_elements() const { return number_of_elements_; }
+  int number_of_elements() const {
+    return number_of_elements_.load(std::memory_order_relaxed);
+  }
   int number_of_deleted_elements() const { return number_of_deleted_elements_; }
 
   template <typename IsolateT, typename StringTableKey>
@@ -142,10 +177,12 @@ class StringTable::Data {
   InternalIndex FindInsertionEntry(PtrComprCageBase cage_base,
                                    uint32_t hash) const;
 
+  // Finds the string matching {key}, or inserts a new one. Returns the
+  // string, or moved_element() if the table is being resized and the lookup
+  // has to be retried in the new table.
   template <typename IsolateT, typename StringTableKey>
-  InternalIndex FindEntryOrInsertionEntry(IsolateT* isolate,
-                                          StringTableKey* key,
-                                          uint32_t hash) const;
+  Object FindOrInsertEntry(IsolateT* isolate, StringTableKey* key,
+                           uint32_t hash);
 
   // Helper method for StringTable::TryStringToIndexOrLookupExisting.
   template <typename Char>
@@ -176,7 +213,8 @@ class StringTable::Data {
 
  private:
   std::unique_ptr<Data> previous_data_;
-  int number_of_elements_;
+  std::atomic<int> number_of_elements_;
+  // Only modified during GC or before the table is published.
   int number_of_deleted_elements_;
   const int capacity_;
   Tagged_t elements_[1];
@@ -233,17 +271,35 @@ std::unique_ptr<StringTable::Data> StringTable::Data::Resize(
       new_data->capacity(), new_data->number_of_elements(),
       new_data->number_of_deleted_elements(), data->number_of_elements()));
 
-  // Rehash the elements.
+  // Rehash the elements. Other threads may still be inserting into the old
+  // table, so every empty slot is marked as moved before we pass it. This
+  // redirects later insertions to the new table, while strings inserted ahead
+  // of us are picked up when we reach them. Readers are not affected; they
+  // at worst see a false miss and retry through the insertion path.
+  int number_of_elements = 0;
   for (InternalIndex i : InternalIndex::Range(data->capacity())) {
     Object element = data->Get(cage_base, i);
-    if (element == empty_element() || element == deleted_element()) continue;
+    while (true) {
+      if (element == empty_element()) {
+        if (data->ReplaceSentinel(i, empty_element(), moved_element())) break;
+      } else if (element != reserved_element()) {
+        break;
+      } else {
+        // Another thread is about to publish a string in this slot.
+        YIELD_PROCESSOR;
+      }
+      element = data->Get(cage_base, i);
+    }
+    if (element == moved_element() || element == deleted_element()) continue;
     String string = String::cast(element);
     uint32_t hash = string->hash();
     InternalIndex insertion_index =
         new_data->FindInsertionEntry(cage_base, hash);
     new_data->Set(insertion_index, string);
+    number_of_elements++;
   }
-  new_data->number_of_elements_ = data->number_of_elements();
+  new_data->number_of_elements_.store(number_of_elements,
+                                      std::memory_order_relaxed);
 
   new_data->previous_data_ = std::move(data);
   return new_data;
@@ -260,8 +316,14 @@ InternalIndex StringTable::Data::FindEntry(IsolateT* isolate,
     // TODO(leszeks): Consider delaying the decompression until after the
     // comparisons against empty/deleted.
     Object element = Get(isolate, entry);
-    if (element == empty_element()) return InternalIndex::NotFound();
-    if (element == deleted_element()) continue;
+    if (element == empty_element() || element == moved_element()) {
+      return InternalIndex::NotFound();
+    }
+    // A reserved slot might hold the key once published; treating it as a
+    // miss is fine since lookups may have false negatives.
+    if (element == deleted_element() || element == reserved_element()) {
+      continue;
+    }
     String string = String::cast(element);
     if (KeyIsMatch(isolate, key, string)) return entry;
   }
@@ -282,31 +344,39 @@ InternalIndex StringTable::Data::FindInsertionEntry(PtrComprCageBase cage_base,
 }
 
 template <typename IsolateT, typename StringTableKey>
-InternalIndex StringTable::Data::FindEntryOrInsertionEntry(
-    IsolateT* isolate, StringTableKey* key, uint32_t hash) const {
-  InternalIndex insertion_entry = InternalIndex::NotFound();
+Object StringTable::Data::FindOrInsertEntry(IsolateT* isolate,
+                                            StringTableKey* key,
+                                            uint32_t hash) {
   uint32_t count = 1;
   // EnsureCapacity will guarantee the hash table is never full.
   for (InternalIndex entry = FirstProbe(hash, capacity_);;
        entry = NextProbe(entry, count++, capacity_)) {
-    // TODO(leszeks): Consider delaying the decompression until after the
-    // comparisons against empty/deleted.
     Object element = Get(isolate, entry);
-    if (element == empty_element()) {
-      // Empty entry, it's our insertion entry if there was no previous Hole.
-      if (insertion_entry.is_not_found()) return entry;
-      return insertion_entry;
+    while (element == empty_element() || element == reserved_element()) {
+      if (element == empty_element()) {
+        // Strings matching the key can only be inserted before the first empty
+        // slot of the probe sequence, so this is our insertion entry. Reserve
+        // it, so that no other thread can publish a string in it before we do.
+        if (ReplaceSentinel(entry, empty_element(), reserved_element())) {
+          Handle<String> new_string = key->GetHandleForInsertion();
+          DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
+          Set(entry, *new_string);
+          ElementAdded();
+          return *new_string;
+        }
+      } else {
+        // Another thread is about to publish a string here, which might match
+        // our key.
+        YIELD_PROCESSOR;
+      }
+      element = Get(isolate, entry);
     }
 
-    if (element == deleted_element()) {
-      // Holes are potential insertion candidates, but we continue the search
-      // in case we find the actual matching entry.
-      if (insertion_entry.is_not_found()) insertion_entry = entry;
-      continue;
-    }
+    if (element == moved_element()) return moved_element();
+    if (element == deleted_element()) continue;
 
     String string = String::cast(element);
-    if (KeyIsMatch(isolate, key, string)) return entry;
+    if (KeyIsMatch(isolate, key, string)) return string;
   }
 }
 
@@ -335,10 +405,7 @@ int StringTable::Capacity() const {
   return data_.load(std::memory_order_acquire)->capacity();
 }
 int StringTable::NumberOfElements() const {
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-    return data_.load(std::memory_order_relaxed)->number_of_elements();
-  }
+  return data_.load(std::memory_order_acquire)->number_of_elements();
 }
 
 // InternalizedStringKey carries a string/internalized-string object as key.
@@ -424,7 +491,7 @@ class InternalizedStringKey final : public StringTableKey {
       // It is always safe to overwrite the map. The only transition possible
       // is another thread migrated the string to internalized already.
       // Migrations to thin are impossible, as we only call this method on table
-      // misses inside the critical section.
+      // misses after reserving the slot the string is inserted into.
       string_->set_map_safe_transition_no_write_barrier(*internalized_map);
       DCHECK(IsInternalizedString(*string_));
       return string_;
@@ -518,8 +585,8 @@ Handle<String> StringTable::LookupString(Isolate* isolate,
   //  - In-place internalizable strings do not incur a copy regardless of string
   //    table sharing. The map mutation is threadsafe even with relaxed memory
   //    order, because for concurrent table lookups, the "losing" thread will be
-  //    correctly ordered by LookupKey's write mutex and see the updated map
-  //    during the re-lookup.
+  //    correctly ordered by LookupKey's slot reservation and see the updated
+  //    map during the re-lookup.
   //
   // For lookup misses, the internalized string map is the same map in RO space
   // regardless of which thread is doing the lookup.
@@ -556,11 +623,12 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
   //
   //   - The Heap access is allowed to be concurrent (using LocalHeap or
   //     similar),
-  //   - All writes to the string table are guarded by the Isolate string table
-  //     mutex,
-  //   - Resizes of the string table first copies the old contents to the new
-  //     table, and only then sets the new string table pointer to the new
-  //     table,
+  //   - Strings are only ever added to empty slots of the string table, by
+  //     reserving the slot with a compare-and-swap and then publishing the
+  //     string with a release store,
+  //   - Resizes of the string table are guarded by the Isolate string table
+  //     mutex, first copy the old contents to the new table, and only then set
+  //     the new string table pointer to the new table,
   //   - Only GCs can remove elements from the string table.
   //
   // These assumptions allow us to make the following statement:
@@ -574,17 +642,18 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
   // for strong consistency of internalized string equality implying reference
   // equality.
   //
-  // We therefore try to optimistically read from the string table without
-  // taking the lock (both here and in the NoAllocate version of the lookup),
-  // and on a miss we take the lock and try to write the entry, with a second
-  // read lookup in case the non-locked read missed a write.
+  // We therefore try to optimistically read from the string table (both here
+  // and in the NoAllocate version of the lookup), and on a miss we try to
+  // write the entry, with a second read lookup along the probe sequence in
+  // case the first read missed a write. Two threads inserting the same string
+  // race for the same first empty slot; the loser sees the winner's string
+  // there and returns it.
   //
-  // One complication is allocation -- we don't want to allocate while holding
-  // the string table lock. This applies to both allocation of new strings, and
-  // re-allocation of the string table on resize. So, we optimistically allocate
-  // (without copying values) outside the lock, and potentially discard the
-  // allocation if another write also did an allocation. This assumes that
-  // writes are rarer than reads.
+  // One complication is allocation -- we don't want to allocate while a slot
+  // is reserved, since other threads probing through it wait for it. So, we
+  // optimistically allocate outside of the reservation, and potentially
+  // discard the allocation if another thread inserted the same string. This
+  // assumes that writes are rarer than reads.
 
   // Load the current string table data, in case another thread updates the
   // data while we're reading.
@@ -605,36 +674,22 @@ Handle<String> StringTable::LookupKey(IsolateT* isolate, StringTableKey* key) {
 
   // No entry found, so adding new string.
   key->PrepareForInsertion(isolate);
-  {
-    base::MutexGuard table_write_guard(&write_mutex_);
-
+  while (true) {
     Data* data = EnsureCapacity(isolate, 1);
 
     // Check one last time if the key is present in the table, in case it was
-    // added after the check.
-    entry = data->FindEntryOrInsertionEntry(isolate, key, key->hash());
-
-    Object element = data->Get(isolate, entry);
-    if (element == empty_element()) {
-      // This entry is empty, so write it and register that we added an
-      // element.
-      Handle<String> new_string = key->GetHandleForInsertion();
-      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      data->Set(entry, *new_string);
-      data->ElementAdded();
-      return new_string;
-    } else if (element == deleted_element()) {
-      // This entry was deleted, so overwrite it and register that we
-      // overwrote a deleted element.
-      Handle<String> new_string = key->GetHandleForInsertion();
-      DCHECK_IMPLIES(v8_flags.shared_string_table, new_string->IsShared());
-      data->Set(entry, *new_string);
-      data->DeletedElementOverwritten();
-      return new_string;
-    } else {
-      // Return the existing string as a handle.
-      return handle(String::cast(element), isolate);
+    // added after the check, and insert it otherwise.
+    Object result = data->FindOrInsertEntry(isolate, key, key->hash());
+    if (result != moved_element()) {
+      Handle<String> string(String::cast(result), isolate);
+      DCHECK_IMPLIES(v8_flags.shared_string_table,
+                     Object::InSharedHeap(*string));
+      return string;
     }
+
+    // The table is being resized. The resizing thread holds the write mutex
+    // until the new table is published, so wait for it and try again.
+    base::MutexGuard wait_for_resize(&write_mutex_);
   }
 }
 
@@ -659,31 +714,22 @@ template Handle<String> StringTable::LookupKey(LocalIsolate* isolate,
 
 StringTable::Data* StringTable::EnsureCapacity(PtrComprCageBase cage_base,
                                                int additional_elements) {
-  // This call is only allowed while the write mutex is held.
-  write_mutex_.AssertHeld();
-
-  // This load can be relaxed as the table pointer can only be modified while
-  // the lock is held.
-  Data* data = data_.load(std::memory_order_relaxed);
-
-  // Grow or shrink table if needed. We first try to shrink the table, if it
-  // is sufficiently empty; otherwise we make sure to grow it so that it has
-  // enough space.
-  int current_capacity = data->capacity();
-  int current_nof = data->number_of_elements();
-  int capacity_after_shrinking =
-      ComputeStringTableCapacityWithShrink(current_capacity, current_nof + 1);
-
-  int new_capacity = -1;
-  if (capacity_after_shrinking < current_capacity) {
-    DCHECK(StringTableHasSufficientCapacityToAdd(capacity_after_shrinking,
-                                                 current_nof, 0, 1));
-    new_capacity = capacity_after_shrinking;
-  } else if (!StringTableHasSufficientCapacityToAdd(
-                 current_capacity, current_nof,
-                 data->number_of_deleted_elements(), 1)) {
-    new_capacity = ComputeStringTableCapacity(current_nof + 1);
-  }
+  Data* data = data_.load(std::memory_order_acquire);
+  if (ComputeStringTableResizeCapacity(
+          data->capacity(), data->number_of_elements(),
+          data->number_of_deleted_elements(), additional_elements) == -1) {
+    return data;
+  }
+
+  base::MutexGuard table_write_guard(&write_mutex_);
+
+  // Another thread may have resized the table while we were waiting for the
+  // lock. This load can be relaxed as the table pointer can only be modified
+  // while the lock is held.
+  data = data_.load(std::memory_order_relaxed);
+  int new_capacity = ComputeStringTableResizeCapacity(
+      data->capacity(), data->number_of_elements(),
+      data->number_of_deleted_elements(), additional_elements);
 
   if (new_capacity != -1) {
     std::unique_ptr<Data> new_data =
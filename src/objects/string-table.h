@@ -41,7 +41,8 @@ class StringTableKey {
 class SeqOneByteString;
 
 // StringTable, for internalizing strings. The Lookup methods are designed to be
-// thread-safe, in combination with GC safepoints.
+// thread-safe, in combination with GC safepoints. Insertion is lock-free;
+// only resizing the table takes the write lock.
 //
 // The string table layout is defined by its Data implementation class, see
 // StringTable::Data for details.
@@ -75,8 +76,7 @@ class V8_EXPORT_PRIVATE StringTable {
   void Print(PtrComprCageBase cage_base) const;
   size_t GetCurrentMemoryUsage() const;
 
-  // The following methods must be called either while holding the write lock,
-  // or while in a Heap safepoint.
+  // The following methods must be called while in a Heap safepoint.
   void IterateElements(RootVisitor* visitor);
   void DropOldData();
   void NotifyElementsRemoved(int count);
@@ -86,12 +86,19 @@ class V8_EXPORT_PRIVATE StringTable {
  private:
   class Data;
 
+  // Transient sentinels that are only ever observed outside of GC. A slot is
+  // reserved by a thread that is about to publish a new string in it, and
+  // empty slots of a table that is being resized are marked as moved, so that
+  // no further strings are inserted into it.
+  static constexpr Smi reserved_element() { return Smi::FromInt(2); }
+  static constexpr Smi moved_element() { return Smi::FromInt(3); }
+
   Data* EnsureCapacity(PtrComprCageBase cage_base, int additional_elements);
 
   std::atomic<Data*> data_;
-  // Write mutex is mutable so that readers of concurrently mutated values (e.g.
-  // NumberOfElements) are allowed to lock it while staying const.
-  mutable base::Mutex write_mutex_;
+  // Serializes resizes of the table. Insertions into a table that is being
+  // resized wait on this mutex before retrying in the new table.
+  base::Mutex write_mutex_;
   Isolate* isolate_;
 };
 
@@ -9,6 +9,7 @@
 #include "src/base/optional.h"
 #include "src/debug/debug.h"
 #include "src/heap/combined-heap.h"
+#include "src/heap/heap-census.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap.h"
 #include "src/objects/js-array-buffer-inl.h"
@@ -141,6 +142,24 @@ v8::AllocationProfile* HeapProfiler::GetAllocationProfile() {
   }
 }
 
+void HeapProfiler::StartHeapCensus(size_t sample_interval) {
+  heap()->heap_census()->Start(sample_interval);
+}
+
+void HeapProfiler::StopHeapCensus() { heap()->heap_census()->Stop(); }
+
+std::vector<v8::HeapCensusEntry> HeapProfiler::GetHeapCensus() {
+  std::vector<v8::HeapCensusEntry> result;
+  const std::vector<HeapCensus::Entry>& entries =
+      heap()->heap_census()->entries();
+  result.reserve(entries.size());
+  for (const HeapCensus::Entry& entry : entries) {
+    result.push_back({HeapCensus::InstanceTypeName(entry.instance_type),
+                      entry.constructor_name, entry.count, entry.size});
+  }
+  return result;
+}
+
 
 void HeapProfiler::StartHeapObjectsTracking(bool track_allocations) {
   ids_->UpdateHeapObjectsMap();
@@ -67,6 +67,10 @@ class HeapProfiler : public HeapObjectAllocationTracker {
   bool is_sampling_allocations() { return !!sampling_heap_profiler_; }
   AllocationProfile* GetAllocationProfile();
 
+  void StartHeapCensus(size_t sample_interval);
+  void StopHeapCensus();
+  std::vector<v8::HeapCensusEntry> GetHeapCensus();
+
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
   AllocationTracker* allocation_tracker() const {
@@ -42,6 +42,7 @@
 #include "src/profiler/heap-profiler.h"
 #include "src/profiler/heap-snapshot-generator-inl.h"
 #include "src/profiler/output-stream-writer.h"
+#include "src/tasks/task-utils.h"
 #include "v8-persistent-handle.h"
 
 #if V8_ENABLE_WEBASSEMBLY
@@ -50,6 +51,10 @@
 #include "src/wasm/wasm-objects.h"
 #endif  // V8_ENABLE_WEBASSEMBLY
 
+#ifdef V8_USE_ZLIB
+#include "third_party/zlib/google/compression_utils_portable.h"
+#endif  // V8_USE_ZLIB
+
 namespace v8 {
 namespace internal {
 
@@ -2966,6 +2971,83 @@ void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
   timer.Stop();
 }
 
+#ifdef V8_USE_ZLIB
+namespace {
+
+// Compresses everything written to it into a gzip stream, which is passed on
+// to the underlying stream in chunks of its preferred size.
+class GzipOutputStream final : public v8::OutputStream {
+ public:
+  explicit GzipOutputStream(v8::OutputStream* stream)
+      : stream_(stream),
+        chunk_size_(stream->GetChunkSize()),
+        chunk_(base::OwnedVector<char>::NewForOverwrite(chunk_size_)) {
+    // Snapshots compress well even at the fastest level. A window size of
+    // 15 + 16 makes zlib write a gzip header and trailer.
+    CHECK_EQ(Z_OK, deflateInit2(&zstream_, Z_BEST_SPEED, Z_DEFLATED, 15 + 16,
+                                8, Z_DEFAULT_STRATEGY));
+  }
+  ~GzipOutputStream() override { deflateEnd(&zstream_); }
+
+  int GetChunkSize() override { return chunk_size_; }
+
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    if (aborted_) return kAbort;
+    zstream_.next_in = reinterpret_cast<Bytef*>(data);
+    zstream_.avail_in = static_cast<uInt>(size);
+    Deflate(Z_NO_FLUSH);
+    return aborted_ ? kAbort : kContinue;
+  }
+
+  void EndOfStream() override {
+    Deflate(Z_FINISH);
+    if (aborted_) return;
+    if (chunk_pos_ != 0) WriteChunk();
+    if (aborted_) return;
+    stream_->EndOfStream();
+  }
+
+ private:
+  void Deflate(int flush) {
+    int result;
+    do {
+      zstream_.next_out =
+          reinterpret_cast<Bytef*>(chunk_.begin() + chunk_pos_);
+      zstream_.avail_out = static_cast<uInt>(chunk_size_ - chunk_pos_);
+      result = deflate(&zstream_, flush);
+      CHECK_NE(Z_STREAM_ERROR, result);
+      chunk_pos_ = chunk_size_ - static_cast<int>(zstream_.avail_out);
+      if (chunk_pos_ == chunk_size_) WriteChunk();
+      // Without Z_FINISH, all input has been consumed once zlib stops filling
+      // the whole output buffer.
+    } while (!aborted_ && (flush == Z_FINISH ? result != Z_STREAM_END
+                                             : zstream_.avail_out == 0));
+  }
+
+  void WriteChunk() {
+    if (stream_->WriteAsciiChunk(chunk_.begin(), chunk_pos_) ==
+        v8::OutputStream::kAbort) {
+      aborted_ = true;
+    }
+    chunk_pos_ = 0;
+  }
+
+  v8::OutputStream* stream_;
+  int chunk_size_;
+  base::OwnedVector<char> chunk_;
+  int chunk_pos_ = 0;
+  bool aborted_ = false;
+  z_stream zstream_ = {};
+};
+
+}  // namespace
+
+void HeapSnapshotJSONSerializer::SerializeCompressed(
+    v8::OutputStream* stream) {
+  GzipOutputStream gzip_stream(stream);
+  Serialize(&gzip_stream);
+}
+#endif  // V8_USE_ZLIB
 
 void HeapSnapshotJSONSerializer::SerializeImpl() {
   DCHECK_EQ(0, snapshot_->root()->index());
@@ -3066,75 +3148,172 @@ static int utoa(T value, base::Vector<char> buffer, int buffer_pos) {
   return utoa_impl(unsigned_value, buffer, buffer_pos);
 }
 
-void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
-                                               bool first_edge) {
-  // The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
-  static const int kBufferSize =
-      MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;
-  base::EmbeddedVector<char, kBufferSize> buffer;
-  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
-      || edge->type() == HeapGraphEdge::kHidden
-      ? edge->index() : GetStringId(edge->name());
-  int buffer_pos = 0;
-  if (!first_edge) {
-    buffer[buffer_pos++] = ',';
-  }
-  buffer_pos = utoa(edge->type(), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(edge_name_or_index, buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(to_node_index(edge->to()), buffer, buffer_pos);
-  buffer[buffer_pos++] = '\n';
-  buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.begin());
-}
+namespace {
 
-void HeapSnapshotJSONSerializer::SerializeEdges() {
-  std::vector<HeapGraphEdge*>& edges = snapshot_->children();
-  for (size_t i = 0; i < edges.size(); ++i) {
-    DCHECK(i == 0 ||
-           edges[i - 1]->from()->index() <= edges[i]->from()->index());
-    SerializeEdge(edges[i], i == 0);
-    if (writer_->aborted()) return;
+// A chunk of formatted rows of the nodes or edges array.
+struct SnapshotRowChunk {
+  base::OwnedVector<char> buffer;
+  int length = 0;
+};
+
+// Formats the rows [begin, end) into |chunk|. Can run on any thread.
+template <typename RowFormatter>
+void FormatSnapshotRows(const RowFormatter* formatter, size_t begin,
+                        size_t end, SnapshotRowChunk* chunk) {
+  // Leave room for the terminating \0.
+  size_t capacity = (end - begin) * RowFormatter::kMaxRowLength + 1;
+  if (chunk->buffer.size() < capacity) {
+    chunk->buffer = base::OwnedVector<char>::NewForOverwrite(capacity);
   }
+  char* buffer = chunk->buffer.begin();
+  int length = 0;
+  for (size_t row = begin; row < end; row++) {
+    length += formatter->FormatRow(row, buffer + length);
+  }
+  buffer[length] = '\0';
+  chunk->length = length;
 }
 
-void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
-  // The buffer needs space for 5 unsigned ints, 1 size_t, 1 uint8_t, 7 commas,
-  // \n and \0
-  static const int kBufferSize =
+}  // namespace
+
+// Formats rows of the nodes array. String ids are assigned on the main thread
+// in PrepareRows(), so that FormatRow() can run on any thread.
+class HeapSnapshotJSONSerializer::NodeRowFormatter {
+ public:
+  // Space for 5 unsigned ints, 1 size_t, 1 uint8_t, 7 commas and \n.
+  static constexpr int kMaxRowLength =
       5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned +
       MaxDecimalDigitsIn<sizeof(size_t)>::kUnsigned +
-      MaxDecimalDigitsIn<sizeof(uint8_t)>::kUnsigned + 7 + 1 + 1;
-  base::EmbeddedVector<char, kBufferSize> buffer;
-  int buffer_pos = 0;
-  if (to_node_index(entry) != 0) {
+      MaxDecimalDigitsIn<sizeof(uint8_t)>::kUnsigned + 7 + 1;
+
+  explicit NodeRowFormatter(HeapSnapshotJSONSerializer* serializer)
+      : serializer_(serializer),
+        entries_(serializer->snapshot_->entries()) {}
+
+  size_t row_count() const { return entries_.size(); }
+
+  void PrepareRows(size_t begin, size_t end) {
+    first_row_ = begin;
+    name_ids_.resize(end - begin);
+    for (size_t row = begin; row < end; row++) {
+      name_ids_[row - begin] = serializer_->GetStringId(entries_[row].name());
+    }
+  }
+
+  int FormatRow(size_t row, char* chars) const {
+    const HeapEntry* entry = &entries_[row];
+    base::Vector<char> buffer(chars, kMaxRowLength);
+    int buffer_pos = 0;
+    if (serializer_->to_node_index(entry) != 0) {
+      buffer[buffer_pos++] = ',';
+    }
+    buffer_pos = utoa(entry->type(), buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(name_ids_[row - first_row_], buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(entry->id(), buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(entry->self_size(), buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(entry->children_count(), buffer, buffer_pos);
     buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(entry->trace_node_id(), buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(entry->detachedness(), buffer, buffer_pos);
+    buffer[buffer_pos++] = '\n';
+    return buffer_pos;
+  }
+
+ private:
+  HeapSnapshotJSONSerializer* const serializer_;
+  const std::deque<HeapEntry>& entries_;
+  size_t first_row_ = 0;
+  std::vector<int> name_ids_;
+};
+
+// Formats rows of the edges array, see NodeRowFormatter.
+class HeapSnapshotJSONSerializer::EdgeRowFormatter {
+ public:
+  // Space for 3 unsigned ints, 3 commas and \n.
+  static constexpr int kMaxRowLength =
+      MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 1;
+
+  explicit EdgeRowFormatter(HeapSnapshotJSONSerializer* serializer)
+      : serializer_(serializer), edges_(serializer->snapshot_->children()) {}
+
+  size_t row_count() const { return edges_.size(); }
+
+  void PrepareRows(size_t begin, size_t end) {
+    first_row_ = begin;
+    name_or_indices_.resize(end - begin);
+    for (size_t row = begin; row < end; row++) {
+      HeapGraphEdge* edge = edges_[row];
+      DCHECK(row == 0 ||
+             edges_[row - 1]->from()->index() <= edge->from()->index());
+      name_or_indices_[row - begin] =
+          edge->type() == HeapGraphEdge::kElement ||
+                  edge->type() == HeapGraphEdge::kHidden
+              ? edge->index()
+              : serializer_->GetStringId(edge->name());
+    }
+  }
+
+  int FormatRow(size_t row, char* chars) const {
+    HeapGraphEdge* edge = edges_[row];
+    base::Vector<char> buffer(chars, kMaxRowLength);
+    int buffer_pos = 0;
+    if (row != 0) {
+      buffer[buffer_pos++] = ',';
+    }
+    buffer_pos = utoa(edge->type(), buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(name_or_indices_[row - first_row_], buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(serializer_->to_node_index(edge->to()), buffer,
+                      buffer_pos);
+    buffer[buffer_pos++] = '\n';
+    return buffer_pos;
+  }
+
+ private:
+  HeapSnapshotJSONSerializer* const serializer_;
+  const std::vector<HeapGraphEdge*>& edges_;
+  size_t first_row_ = 0;
+  std::vector<int> name_or_indices_;
+};
+
+template <typename RowFormatter>
+void HeapSnapshotJSONSerializer::SerializeRows(RowFormatter* formatter) {
+  const size_t row_count = formatter->row_count();
+  std::vector<SnapshotRowChunk> chunks(kRowChunksPerBatch);
+  const size_t batch_size = kRowsPerChunk * kRowChunksPerBatch;
+  for (size_t begin = 0; begin < row_count; begin += batch_size) {
+    size_t end = std::min(begin + batch_size, row_count);
+    formatter->PrepareRows(begin, end);
+    size_t chunk_count = (end - begin + kRowsPerChunk - 1) / kRowsPerChunk;
+    ProcessChunksInParallel(
+        chunk_count, v8_flags.heap_snapshot_parallel_serialization,
+        [&](size_t index) {
+          size_t chunk_begin = begin + index * kRowsPerChunk;
+          FormatSnapshotRows(formatter, chunk_begin,
+                             std::min(chunk_begin + kRowsPerChunk, end),
+                             &chunks[index]);
+        });
+    for (size_t i = 0; i < chunk_count; i++) {
+      writer_->AddSubstring(chunks[i].buffer.begin(), chunks[i].length);
+      if (writer_->aborted()) return;
+    }
   }
-  buffer_pos = utoa(entry->type(), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(GetStringId(entry->name()), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->id(), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->self_size(), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->children_count(), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->trace_node_id(), buffer, buffer_pos);
-  buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->detachedness(), buffer, buffer_pos);
-  buffer[buffer_pos++] = '\n';
-  buffer[buffer_pos++] = '\0';
-  writer_->AddString(buffer.begin());
+}
+
+void HeapSnapshotJSONSerializer::SerializeEdges() {
+  EdgeRowFormatter formatter(this);
+  SerializeRows(&formatter);
 }
 
 void HeapSnapshotJSONSerializer::SerializeNodes() {
-  const std::deque<HeapEntry>& entries = snapshot_->entries();
-  for (const HeapEntry& entry : entries) {
-    SerializeNode(&entry);
-    if (writer_->aborted()) return;
-  }
+  NodeRowFormatter formatter(this);
+  SerializeRows(&formatter);
 }
 
 void HeapSnapshotJSONSerializer::SerializeSnapshot() {
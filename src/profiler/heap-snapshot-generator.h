@@ -703,8 +703,16 @@ class HeapSnapshotJSONSerializer {
   HeapSnapshotJSONSerializer& operator=(const HeapSnapshotJSONSerializer&) =
       delete;
   void Serialize(v8::OutputStream* stream);
+#ifdef V8_USE_ZLIB
+  // Like Serialize(), but passes the JSON through gzip before writing it to
+  // |stream|.
+  void SerializeCompressed(v8::OutputStream* stream);
+#endif  // V8_USE_ZLIB
 
  private:
+  class NodeRowFormatter;
+  class EdgeRowFormatter;
+
   V8_INLINE static bool StringsMatch(void* key1, void* key2) {
     return strcmp(reinterpret_cast<char*>(key1),
                   reinterpret_cast<char*>(key2)) == 0;
@@ -715,11 +723,11 @@ class HeapSnapshotJSONSerializer {
   int GetStringId(const char* s);
   V8_INLINE int to_node_index(const HeapEntry* e);
   V8_INLINE int to_node_index(int entry_index);
-  void SerializeEdge(HeapGraphEdge* edge, bool first_edge);
   void SerializeEdges();
   void SerializeImpl();
-  void SerializeNode(const HeapEntry* entry);
   void SerializeNodes();
+  template <typename RowFormatter>
+  void SerializeRows(RowFormatter* formatter);
   void SerializeSnapshot();
   void SerializeTraceTree();
   void SerializeTraceNode(AllocationTraceNode* node);
@@ -733,6 +741,12 @@ class HeapSnapshotJSONSerializer {
   static const int kEdgeFieldsCount;
   static const int kNodeFieldsCount;
 
+  // The nodes and edges arrays are formatted in chunks of kRowsPerChunk rows,
+  // in parallel if possible. kRowChunksPerBatch chunks are formatted at a time
+  // before they are written out, which bounds the memory used for buffering.
+  static constexpr size_t kRowsPerChunk = 4096;
+  static constexpr size_t kRowChunksPerBatch = 64;
+
   HeapSnapshot* snapshot_;
   base::CustomMatcherHashMap strings_;
   int next_node_id_;
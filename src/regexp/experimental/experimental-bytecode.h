@@ -37,6 +37,14 @@
 //   contained in a non-empty closed interval [min, max] specified in the
 //   instruction payload.  Abort this thread if false, otherwise advance the
 //   input position by 1 and continue with the next instruction.
+// - RANGE_COUNT: Check whether the codepoint of the current character is
+//   contained in any of the intervals given by the CONSUME_RANGE instructions
+//   directly following this instruction.  The number of such instructions is
+//   specified in the payload.  Abort this thread if false, otherwise advance
+//   the input position by 1 and continue with the first instruction after the
+//   ranges.  The CONSUME_RANGE instructions are never executed themselves.
+//   This is equivalent to a disjunction of CONSUME_RANGEs, but runs on a
+//   single thread instead of spawning one thread per range.
 // - ACCEPT: Stop this thread and signify the end of a match at the current
 //   input position.
 // - FORK: If executed by a thread t, spawn a new thread t0 whose register
@@ -99,6 +107,7 @@ struct RegExpInstruction {
     CONSUME_RANGE,
     FORK,
     JMP,
+    RANGE_COUNT,
     SET_REGISTER_TO_CP,
   };
 
@@ -114,6 +123,13 @@ struct RegExpInstruction {
     return result;
   }
 
+  static RegExpInstruction RangeCount(int32_t num_ranges) {
+    RegExpInstruction result;
+    result.opcode = RANGE_COUNT;
+    result.payload.num_ranges = num_ranges;
+    return result;
+  }
+
   static RegExpInstruction ConsumeAnyChar() {
     return ConsumeRange(0x0000, 0xFFFF);
   }
@@ -169,6 +185,9 @@ struct RegExpInstruction {
   union {
     // Payload of CONSUME_RANGE:
     Uc16Range consume_range;
+    // Payload of RANGE_COUNT, the number of CONSUME_RANGE instructions that
+    // follow:
+    int32_t num_ranges;
     // Payload of FORK and JMP, the next/forked program counter (pc):
     int32_t pc;
     // Payload of SET_REGISTER_TO_CP and CLEAR_REGISTER:
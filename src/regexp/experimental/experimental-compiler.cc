@@ -38,7 +38,7 @@ class CanBeHandledVisitor final : private RegExpVisitor {
     // future.
     static constexpr RegExpFlags kAllowedFlags =
         RegExpFlag::kGlobal | RegExpFlag::kSticky | RegExpFlag::kMultiline |
-        RegExpFlag::kDotAll | RegExpFlag::kLinear;
+        RegExpFlag::kDotAll | RegExpFlag::kLinear | RegExpFlag::kIgnoreCase;
     // We support Unicode iff kUnicode is among the supported flags.
     static_assert(ExperimentalRegExp::kSupportsUnicode ==
                   IsUnicode(kAllowedFlags));
@@ -244,6 +244,10 @@ class BytecodeAssembler {
     code_.Add(RegExpInstruction::ConsumeRange(from, to), zone_);
   }
 
+  void RangeCount(int32_t num_ranges) {
+    code_.Add(RegExpInstruction::RangeCount(num_ranges), zone_);
+  }
+
   void ConsumeAnyChar() {
     code_.Add(RegExpInstruction::ConsumeAnyChar(), zone_);
   }
@@ -307,8 +311,9 @@ class BytecodeAssembler {
 class CompileVisitor : private RegExpVisitor {
  public:
   static ZoneList<RegExpInstruction> Compile(RegExpTree* tree,
-                                             RegExpFlags flags, Zone* zone) {
-    CompileVisitor compiler(zone);
+                                             RegExpFlags flags,
+                                             Isolate* isolate, Zone* zone) {
+    CompileVisitor compiler(flags, isolate, zone);
 
     if (!IsSticky(flags) && !tree->IsAnchoredAtStart()) {
       // The match is not anchored, i.e. may start at any input position, so we
@@ -327,7 +332,8 @@ class CompileVisitor : private RegExpVisitor {
   }
 
  private:
-  explicit CompileVisitor(Zone* zone) : zone_(zone), assembler_(zone) {}
+  CompileVisitor(RegExpFlags flags, Isolate* isolate, Zone* zone)
+      : flags_(flags), isolate_(isolate), zone_(zone), assembler_(zone) {}
 
   // Generate a disjunction of code fragments compiled by a function `alt_gen`.
   // `alt_gen` is called repeatedly with argument `int i = 0, 1, ..., alt_num -
@@ -397,7 +403,9 @@ class CompileVisitor : private RegExpVisitor {
   }
 
   void CompileCharacterRanges(ZoneList<CharacterRange>* ranges, bool negated) {
-    // A character class is compiled as Disjunction over its `CharacterRange`s.
+    // A character class is compiled as a single RANGE_COUNT instruction
+    // followed by its `CharacterRange`s.  This is equivalent to a disjunction
+    // of CONSUME_RANGEs, but only needs one thread in the interpreter.
     CharacterRange::Canonicalize(ranges);
     if (negated) {
       // The complement of a disjoint, non-adjacent (i.e. `Canonicalize`d)
@@ -409,7 +417,14 @@ class CompileVisitor : private RegExpVisitor {
       ranges = negated;
     }
 
-    CompileDisjunction(ranges->length(), [&](int i) {
+    const int num_ranges = ranges->length();
+    if (num_ranges == 0) {
+      // The empty class.  This can never match.
+      assembler_.Fail();
+      return;
+    }
+    if (num_ranges > 1) assembler_.RangeCount(num_ranges);
+    for (int i = 0; i != num_ranges; ++i) {
       // We don't support utf16 for now, so only ranges that can be specified
       // by (complements of) ranges with base::uc16 bounds.
       static_assert(kMaxSupportedCodepoint <=
@@ -425,11 +440,20 @@ class CompileVisitor : private RegExpVisitor {
           static_cast<base::uc16>(std::min(to, kMaxSupportedCodepoint));
 
       assembler_.ConsumeRange(from_uc16, to_uc16);
-    });
+    }
   }
 
   void* VisitClassRanges(RegExpClassRanges* node, void*) override {
-    CompileCharacterRanges(node->ranges(zone_), node->is_negated());
+    ZoneList<CharacterRange>* ranges = node->ranges(zone_);
+    // None of the standard character classes is different in the case
+    // independent case, see also `TextNode::MakeCaseIndependent`.
+    if (IsIgnoreCase(flags_) && !node->is_standard(zone_)) {
+      // Add the case equivalents to a copy, since the tree may still be
+      // compiled by irregexp afterwards.
+      ranges = zone_->New<ZoneList<CharacterRange>>(*ranges, zone_);
+      CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges, false);
+    }
+    CompileCharacterRanges(ranges, node->is_negated());
     return nullptr;
   }
 
@@ -448,7 +472,16 @@ class CompileVisitor : private RegExpVisitor {
 
   void* VisitAtom(RegExpAtom* node, void*) override {
     for (base::uc16 c : node->data()) {
-      assembler_.ConsumeRange(c, c);
+      if (IsIgnoreCase(flags_)) {
+        // Match every character that is case-insensitively equal to `c`.
+        ZoneList<CharacterRange>* ranges =
+            zone_->New<ZoneList<CharacterRange>>(2, zone_);
+        ranges->Add(CharacterRange::Singleton(c), zone_);
+        CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges, false);
+        CompileCharacterRanges(ranges, false);
+      } else {
+        assembler_.ConsumeRange(c, c);
+      }
     }
     return nullptr;
   }
@@ -648,6 +681,8 @@ class CompileVisitor : private RegExpVisitor {
   }
 
  private:
+  const RegExpFlags flags_;
+  Isolate* const isolate_;
   Zone* zone_;
   BytecodeAssembler assembler_;
 };
@@ -655,8 +690,8 @@ class CompileVisitor : private RegExpVisitor {
 }  // namespace
 
 ZoneList<RegExpInstruction> ExperimentalRegExpCompiler::Compile(
-    RegExpTree* tree, RegExpFlags flags, Zone* zone) {
-  return CompileVisitor::Compile(tree, flags, zone);
+    RegExpTree* tree, RegExpFlags flags, Isolate* isolate, Zone* zone) {
+  return CompileVisitor::Compile(tree, flags, isolate, zone);
 }
 
 }  // namespace internal
@@ -25,8 +25,10 @@ class ExperimentalRegExpCompiler final : public AllStatic {
   // Compile regexp into a bytecode program.  The regexp must be handlable by
   // the experimental engine; see`CanBeHandled`.  The program is returned as a
   // ZoneList backed by the same Zone that is used in the RegExpTree argument.
+  // The isolate is used to look up case equivalents for ignore-case regexps.
   static ZoneList<RegExpInstruction> Compile(RegExpTree* tree,
-                                             RegExpFlags flags, Zone* zone);
+                                             RegExpFlags flags,
+                                             Isolate* isolate, Zone* zone);
 };
 
 }  // namespace internal
@@ -147,8 +147,8 @@ class NfaInterpreter {
         input_object_(input),
         input_(ToCharacterVector<Character>(input, no_gc_)),
         input_index_(input_index),
-        pc_last_input_index_(zone->AllocateArray<int>(bytecode->length()),
-                             bytecode->length()),
+        pc_last_input_index_(zone->AllocateArray<int>(bytecode_.length()),
+                             bytecode_.length()),
         active_threads_(0, zone),
         blocked_threads_(0, zone),
         register_array_allocator_(zone),
@@ -364,10 +364,10 @@ class NfaInterpreter {
     return RegExp::kInternalRegExpSuccess;
   }
 
-  // Run an active thread `t` until it executes a CONSUME_RANGE or ACCEPT
-  // instruction, or its PC value was already processed.
-  // - If processing of `t` can't continue because of CONSUME_RANGE, it is
-  //   pushed on `blocked_threads_`.
+  // Run an active thread `t` until it executes a CONSUME_RANGE, RANGE_COUNT or
+  // ACCEPT instruction, or its PC value was already processed.
+  // - If processing of `t` can't continue because of CONSUME_RANGE or
+  //   RANGE_COUNT, it is pushed on `blocked_threads_`.
   // - If `t` executes ACCEPT, set `best_match` according to `t.match_begin` and
   //   the current input index. All remaining `active_threads_` are discarded.
   void RunActiveThread(InterpreterThread t) {
@@ -377,7 +377,8 @@ class NfaInterpreter {
 
       RegExpInstruction inst = bytecode_[t.pc];
       switch (inst.opcode) {
-        case RegExpInstruction::CONSUME_RANGE: {
+        case RegExpInstruction::CONSUME_RANGE:
+        case RegExpInstruction::RANGE_COUNT: {
           blocked_threads_.Add(t, zone_);
           return;
         }
@@ -447,11 +448,9 @@ class NfaInterpreter {
     // need to activate blocked threads in reverse order.
     for (int i = blocked_threads_.length() - 1; i >= 0; --i) {
       InterpreterThread t = blocked_threads_[i];
-      RegExpInstruction inst = bytecode_[t.pc];
-      DCHECK_EQ(inst.opcode, RegExpInstruction::CONSUME_RANGE);
-      RegExpInstruction::Uc16Range range = inst.payload.consume_range;
-      if (input_char >= range.min && input_char <= range.max) {
-        ++t.pc;
+      int next_pc = ConsumeInput(t.pc, input_char);
+      if (next_pc != kNoPc) {
+        t.pc = next_pc;
         active_threads_.Add(t, zone_);
       } else {
         DestroyThread(t);
@@ -460,6 +459,32 @@ class NfaInterpreter {
     blocked_threads_.DropAndClear();
   }
 
+  static constexpr int kNoPc = -1;
+
+  // Feeds `input_char` to the CONSUME_RANGE or RANGE_COUNT instruction at
+  // `pc`.  Returns the pc of the instruction to continue with, or `kNoPc` if
+  // the character is rejected.
+  int ConsumeInput(int pc, base::uc16 input_char) const {
+    RegExpInstruction inst = bytecode_[pc];
+    if (inst.opcode == RegExpInstruction::CONSUME_RANGE) {
+      RegExpInstruction::Uc16Range range = inst.payload.consume_range;
+      return input_char >= range.min && input_char <= range.max ? pc + 1
+                                                                : kNoPc;
+    }
+    DCHECK_EQ(inst.opcode, RegExpInstruction::RANGE_COUNT);
+    const int num_ranges = inst.payload.num_ranges;
+    // The ranges are sorted and disjoint, so we can stop at the first range
+    // that starts after `input_char`.
+    for (int i = 1; i <= num_ranges; ++i) {
+      DCHECK_EQ(bytecode_[pc + i].opcode, RegExpInstruction::CONSUME_RANGE);
+      RegExpInstruction::Uc16Range range =
+          bytecode_[pc + i].payload.consume_range;
+      if (input_char < range.min) break;
+      if (input_char <= range.max) return pc + num_ranges + 1;
+    }
+    return kNoPc;
+  }
+
   bool FoundMatch() const { return best_match_registers_.has_value(); }
 
   base::Vector<int> GetRegisterArray(InterpreterThread t) {
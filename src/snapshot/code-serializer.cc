@@ -10,6 +10,7 @@
 #include "src/base/platform/elapsed-timer.h"
 #include "src/base/platform/platform.h"
 #include "src/baseline/baseline-batch-compiler.h"
+#include "src/baseline/baseline.h"
 #include "src/codegen/background-merge-task.h"
 #include "src/common/globals.h"
 #include "src/handles/maybe-handles.h"
@@ -377,17 +378,26 @@ void FinalizeDeserialization(Isolate* isolate,
   }
 }
 
-void BaselineBatchCompileIfSparkplugCompiled(Isolate* isolate, Script script) {
+void BaselineCompileDeserializedFunctions(Isolate* isolate, Script script) {
   // Here is main thread, we trigger early baseline compilation only in
   // concurrent sparkplug and baseline batch compilation mode which consumes
-  // little main thread execution time.
-  if (v8_flags.concurrent_sparkplug && v8_flags.baseline_batch_compilation) {
-    SharedFunctionInfo::ScriptIterator iter(isolate, script);
-    for (SharedFunctionInfo info = iter.Next(); !info.is_null();
-         info = iter.Next()) {
-      if (info->sparkplug_compiled() && CanCompileWithBaseline(isolate, info)) {
-        isolate->baseline_batch_compiler()->EnqueueSFI(info);
-      }
+  // little main thread execution time. With profile guided optimization,
+  // functions that were optimized in the process that produced the cache are
+  // enqueued as well. Without concurrent batch compilation, they are compiled
+  // lazily instead: their cached tiering decision moves their first interrupt
+  // tick, which compiles them with Sparkplug, to their first invocation.
+  if (!v8_flags.concurrent_sparkplug || !v8_flags.baseline_batch_compilation) {
+    return;
+  }
+  SharedFunctionInfo::ScriptIterator iter(isolate, script);
+  for (SharedFunctionInfo info = iter.Next(); !info.is_null();
+       info = iter.Next()) {
+    const bool was_hot = v8_flags.profile_guided_optimization &&
+                         info->cached_tiering_decision() >=
+                             CachedTieringDecision::kEarlyMaglev;
+    if ((info->sparkplug_compiled() || was_hot) &&
+        CanCompileWithBaseline(isolate, info)) {
+      isolate->baseline_batch_compiler()->EnqueueSFI(info);
     }
   }
 }
@@ -454,8 +464,7 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     result = merge.CompleteMergeInForeground(isolate, new_script);
   }
 
-  BaselineBatchCompileIfSparkplugCompiled(isolate,
-                                          Script::cast(result->script()));
+  BaselineCompileDeserializedFunctions(isolate, Script::cast(result->script()));
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
     int length = cached_data->length();
@@ -590,7 +599,7 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
     // Fix up the script list to include the newly deserialized script.
     Handle<WeakArrayList> list = isolate->factory()->script_list();
     for (Handle<Script> script : data.scripts) {
-      BaselineBatchCompileIfSparkplugCompiled(isolate, *script);
+      BaselineCompileDeserializedFunctions(isolate, *script);
       DCHECK(data.persistent_handles->Contains(script.location()));
       list = WeakArrayList::AddToEnd(isolate, list,
                                      MaybeObjectHandle::Weak(script));
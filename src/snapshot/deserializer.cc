@@ -18,6 +18,7 @@
 #include "src/heap/local-heap-inl.h"
 #include "src/logging/local-logger.h"
 #include "src/logging/log.h"
+#include "src/numbers/hash-seed-inl.h"
 #include "src/objects/backing-store.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/maybe-object.h"
@@ -31,6 +32,7 @@
 #include "src/snapshot/serializer-deserializer.h"
 #include "src/snapshot/shared-heap-serializer.h"
 #include "src/snapshot/snapshot-data.h"
+#include "src/strings/string-hasher-inl.h"
 #include "src/utils/memcopy.h"
 
 namespace v8 {
@@ -252,9 +254,60 @@ Deserializer<IsolateT>::Deserializer(IsolateT* isolate,
   CHECK_EQ(magic_number_, SerializedData::kMagicNumber);
 }
 
+namespace {
+
+// Collects sequential strings so that their hashes can be computed together
+// with the batch string hasher.
+template <typename SeqStringT>
+class SequentialStringBatch {
+ public:
+  using Char = typename SeqStringT::Char;
+
+  void Add(SeqStringT string, const DisallowGarbageCollection& no_gc) {
+    strings_.push_back(string);
+    chars_.push_back(string->GetChars(no_gc));
+    lengths_.push_back(string->length());
+  }
+
+  void ComputeHashes(uint64_t seed) {
+    std::vector<uint32_t> raw_hash_fields(strings_.size());
+    StringHasher::HashSequentialStrings(chars_.data(), lengths_.data(),
+                                        static_cast<int>(strings_.size()),
+                                        seed, raw_hash_fields.data());
+    for (size_t i = 0; i < strings_.size(); i++) {
+      strings_[i]->set_raw_hash_field(raw_hash_fields[i]);
+    }
+  }
+
+ private:
+  std::vector<SeqStringT> strings_;
+  std::vector<const Char*> chars_;
+  std::vector<int> lengths_;
+};
+
+}  // namespace
+
 template <typename IsolateT>
 void Deserializer<IsolateT>::Rehash() {
   DCHECK(should_rehash());
+  {
+    // Hash sequential strings in bulk first; RehashBasedOnMap below finds
+    // their hashes already computed.
+    DisallowGarbageCollection no_gc;
+    SequentialStringBatch<SeqOneByteString> one_byte_strings;
+    SequentialStringBatch<SeqTwoByteString> two_byte_strings;
+    for (Handle<HeapObject> item : to_rehash_) {
+      HeapObject raw_item = *item;
+      if (IsSeqOneByteString(raw_item)) {
+        one_byte_strings.Add(SeqOneByteString::cast(raw_item), no_gc);
+      } else if (IsSeqTwoByteString(raw_item)) {
+        two_byte_strings.Add(SeqTwoByteString::cast(raw_item), no_gc);
+      }
+    }
+    const uint64_t seed = HashSeed(isolate());
+    one_byte_strings.ComputeHashes(seed);
+    two_byte_strings.ComputeHashes(seed);
+  }
   for (Handle<HeapObject> item : to_rehash_) {
     item->RehashBasedOnMap(isolate());
   }
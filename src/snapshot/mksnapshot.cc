@@ -231,6 +231,7 @@ int main(int argc, char** argv) {
   using HelpOptions = i::FlagList::HelpOptions;
   std::string usage = "Usage: " + std::string(argv[0]) +
                       " [--startup-src=file]" + " [--startup-blob=file]" +
+                      " [--startup-read-only-heap-image=file]" +
                       " [--embedded-src=file]" + " [--embedded-variant=label]" +
                       " [--static-roots-src=file]" + " [--target-arch=arch]" +
                       " [--target-os=os] [extras]\n\n";
@@ -306,6 +307,11 @@ int main(int argc, char** argv) {
 
     CHECK(blob.data);
     snapshot_writer.WriteSnapshot(blob);
+    if (i::v8_flags.startup_read_only_heap_image &&
+        !i::Snapshot::WriteReadOnlyHeapImage(
+            &blob, i::v8_flags.startup_read_only_heap_image)) {
+      exit(1);
+    }
     delete[] blob.data;
   }
 
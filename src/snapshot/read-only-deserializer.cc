@@ -11,6 +11,7 @@
 #include "src/objects/objects-inl.h"
 #include "src/objects/slots.h"
 #include "src/snapshot/embedded/embedded-data-inl.h"
+#include "src/snapshot/read-only-heap-image.h"
 #include "src/snapshot/read-only-serializer-deserializer.h"
 #include "src/snapshot/snapshot-data.h"
 
@@ -19,15 +20,18 @@ namespace internal {
 
 class ReadOnlyHeapImageDeserializer final {
  public:
-  static void Deserialize(Isolate* isolate, SnapshotByteSource* source) {
-    ReadOnlyHeapImageDeserializer{isolate, source}.DeserializeImpl();
+  // Pages are mapped from `image` if it is not null.
+  static void Deserialize(Isolate* isolate, SnapshotByteSource* source,
+                          ReadOnlyHeapImage* image) {
+    ReadOnlyHeapImageDeserializer{isolate, source, image}.DeserializeImpl();
   }
 
  private:
   using Bytecode = ro::Bytecode;
 
-  ReadOnlyHeapImageDeserializer(Isolate* isolate, SnapshotByteSource* source)
-      : source_(source), isolate_(isolate) {}
+  ReadOnlyHeapImageDeserializer(Isolate* isolate, SnapshotByteSource* source,
+                                ReadOnlyHeapImage* image)
+      : source_(source), isolate_(isolate), image_(image) {}
 
   void DeserializeImpl() {
     while (true) {
@@ -60,6 +64,13 @@ class ReadOnlyHeapImageDeserializer final {
       uint32_t compressed_page_addr = source_->GetUint32();
       Address pos = isolate_->GetPtrComprCage()->base() + compressed_page_addr;
       ro_space()->AllocateNextPageAt(pos);
+      if (image_) {
+        int index = static_cast<int>(ro_space()->pages().size()) - 1;
+        ReadOnlyPage* page = ro_space()->pages().back();
+        current_page_is_mapped_ = image_->MapPage(
+            index, compressed_page_addr, page->address(), page->size(),
+            page->area_start() - page->address());
+      }
     } else {
       ro_space()->AllocateNextPage();
     }
@@ -72,7 +83,12 @@ class ReadOnlyHeapImageDeserializer final {
     Address start = cur_page->area_start() + source_->GetUint30();
     int size_in_bytes = source_->GetUint30();
     CHECK_LE(start + size_in_bytes, cur_page->area_end());
-    source_->CopyRaw(reinterpret_cast<void*>(start), size_in_bytes);
+    if (current_page_is_mapped_) {
+      // The contents were mapped from the read-only heap image.
+      source_->Advance(size_in_bytes);
+    } else {
+      source_->CopyRaw(reinterpret_cast<void*>(start), size_in_bytes);
+    }
     ro_space()->top_ = start + size_in_bytes;
 
     if (!V8_STATIC_ROOTS_BOOL) {
@@ -132,6 +148,8 @@ class ReadOnlyHeapImageDeserializer final {
 
   SnapshotByteSource* const source_;
   Isolate* const isolate_;
+  ReadOnlyHeapImage* const image_;
+  bool current_page_is_mapped_ = false;
 };
 
 ReadOnlyDeserializer::ReadOnlyDeserializer(Isolate* isolate,
@@ -146,7 +164,15 @@ void ReadOnlyDeserializer::DeserializeIntoIsolate() {
   HandleScope scope(isolate());
   ReadOnlyHeap* ro_heap = isolate()->read_only_heap();
 
-  ReadOnlyHeapImageDeserializer::Deserialize(isolate(), source());
+  // Mapping the pages only pays off if they are not rewritten by rehashing.
+  std::unique_ptr<ReadOnlyHeapImage> image;
+  if (V8_STATIC_ROOTS_BOOL && v8_flags.read_only_heap_image &&
+      !should_rehash()) {
+    image = ReadOnlyHeapImage::Open(
+        v8_flags.read_only_heap_image,
+        base::Vector<const uint8_t>(source()->data(), source()->length()));
+  }
+  ReadOnlyHeapImageDeserializer::Deserialize(isolate(), source(), image.get());
   ro_heap->read_only_space()->RepairFreeSpacesAfterDeserialization();
   PostProcessNewObjects();
 
@@ -0,0 +1,175 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/read-only-heap-image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "src/base/platform/wrappers.h"
+#include "src/heap/memory-chunk-layout.h"
+#include "src/heap/read-only-spaces.h"
+#include "src/snapshot/read-only-serializer-deserializer.h"
+#include "src/snapshot/snapshot-source-sink.h"
+#include "src/snapshot/snapshot-utils.h"
+#include "src/utils/allocation.h"
+#include "src/utils/utils.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+struct PageContents {
+  uint32_t compressed_address;
+  std::vector<uint8_t> bytes;
+};
+
+// Replays the page and segment bytecodes of a read-only snapshot that was
+// serialized with static roots.
+std::vector<PageContents> ReadPages(base::Vector<const uint8_t> payload) {
+  const size_t area_offset =
+      MemoryChunkLayout::ObjectStartOffsetInReadOnlyPage();
+  std::vector<PageContents> pages;
+  SnapshotByteSource source(payload);
+  while (true) {
+    switch (static_cast<ro::Bytecode>(source.Get())) {
+      case ro::Bytecode::kPage:
+        pages.push_back({source.GetUint32(), {}});
+        break;
+      case ro::Bytecode::kSegment: {
+        CHECK(!pages.empty());
+        const size_t start = area_offset + source.GetUint30();
+        const int size_in_bytes = source.GetUint30();
+        std::vector<uint8_t>& bytes = pages.back().bytes;
+        if (bytes.size() < start + size_in_bytes) {
+          bytes.resize(start + size_in_bytes);
+        }
+        source.CopyRaw(bytes.data() + start, size_in_bytes);
+        break;
+      }
+      case ro::Bytecode::kRelocateSegment:
+        // Only emitted without static roots.
+        UNREACHABLE();
+      case ro::Bytecode::kFinalizePage:
+      case ro::Bytecode::kReadOnlyRootsTable:
+        break;
+      case ro::Bytecode::kFinalizeReadOnlySpace:
+        return pages;
+    }
+  }
+}
+
+}  // namespace
+
+// static
+bool ReadOnlyHeapImage::Write(base::Vector<const uint8_t> payload,
+                              const char* path) {
+  if (!V8_STATIC_ROOTS_BOOL) {
+    PrintF("The read-only heap image requires static roots.\n");
+    return false;
+  }
+  std::vector<PageContents> pages = ReadPages(payload);
+
+  Header header{kMagicNumber, Checksum(payload),
+                static_cast<uint32_t>(pages.size())};
+  std::vector<PageEntry> entries;
+  size_t offset = RoundUp(sizeof(Header) + pages.size() * sizeof(PageEntry),
+                          kPageAlignment);
+  for (const PageContents& page : pages) {
+    const size_t size = RoundUp(page.bytes.size(), kPageAlignment);
+    CHECK_LE(offset + size, kMaxUInt32);
+    entries.push_back({page.compressed_address, static_cast<uint32_t>(offset),
+                       static_cast<uint32_t>(size)});
+    offset += size;
+  }
+
+  FILE* fp = base::OS::FOpen(path, "wb");
+  if (fp == nullptr) {
+    PrintF("Unable to open file \"%s\" for writing.\n", path);
+    return false;
+  }
+  bool success = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                 fwrite(entries.data(), sizeof(PageEntry), entries.size(),
+                        fp) == entries.size();
+  for (size_t i = 0; success && i < pages.size(); i++) {
+    // The contents are padded with zeros up to the aligned size.
+    std::vector<uint8_t> contents(entries[i].size, 0);
+    std::copy(pages[i].bytes.begin(), pages[i].bytes.end(), contents.begin());
+    success = fseek(fp, entries[i].offset, SEEK_SET) == 0 &&
+              fwrite(contents.data(), 1, contents.size(), fp) ==
+                  contents.size();
+  }
+  base::Fclose(fp);
+  if (!success) {
+    PrintF("Writing read-only heap image \"%s\" failed.\n", path);
+    remove(path);
+  }
+  return success;
+}
+
+// static
+std::unique_ptr<ReadOnlyHeapImage> ReadOnlyHeapImage::Open(
+    const char* path, base::Vector<const uint8_t> payload) {
+  if (!V8_STATIC_ROOTS_BOOL || !base::OS::IsRemapPageSupported()) {
+    return nullptr;
+  }
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::open(
+          path, base::OS::MemoryMappedFile::FileMode::kReadOnly));
+  if (!file || file->size() < sizeof(Header)) return nullptr;
+
+  std::unique_ptr<ReadOnlyHeapImage> image(
+      new ReadOnlyHeapImage(std::move(file)));
+  const Header* header = image->header();
+  if (header->magic_number != kMagicNumber ||
+      header->checksum != Checksum(payload)) {
+    return nullptr;
+  }
+  const size_t file_size = image->file_->size();
+  if (sizeof(Header) + header->page_count * sizeof(PageEntry) > file_size) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < header->page_count; i++) {
+    const PageEntry& entry = image->page_entries()[i];
+    if (!IsAligned(entry.offset, kPageAlignment) ||
+        size_t{entry.offset} + entry.size > file_size) {
+      return nullptr;
+    }
+  }
+  return image;
+}
+
+bool ReadOnlyHeapImage::MapPage(int index, uint32_t compressed_address,
+                                Address page_start, size_t page_size,
+                                size_t header_size) {
+  if (index >= static_cast<int>(header()->page_count)) return false;
+  const PageEntry& entry = page_entries()[index];
+  const size_t allocate_page_size =
+      GetPlatformPageAllocator()->AllocatePageSize();
+  if (entry.compressed_address != compressed_address ||
+      entry.size > page_size || kPageAlignment % allocate_page_size != 0 ||
+      !IsAligned(page_start, allocate_page_size)) {
+    return false;
+  }
+
+  // The file mapping replaces the whole range, so the header that was
+  // initialized when the page was allocated is saved and restored. This only
+  // dirties the first OS page.
+  std::unique_ptr<uint8_t[]> saved_header(new uint8_t[header_size]);
+  void* start = reinterpret_cast<void*>(page_start);
+  memcpy(saved_header.get(), start, header_size);
+  const uint8_t* contents =
+      reinterpret_cast<const uint8_t*>(file_->memory()) + entry.offset;
+  if (!base::OS::RemapPages(contents, entry.size, start,
+                            base::OS::MemoryPermission::kReadWrite)) {
+    return false;
+  }
+  memcpy(start, saved_header.get(), header_size);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
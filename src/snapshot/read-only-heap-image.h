@@ -0,0 +1,97 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_SNAPSHOT_READ_ONLY_HEAP_IMAGE_H_
+#define V8_SNAPSHOT_READ_ONLY_HEAP_IMAGE_H_
+
+#include <memory>
+
+#include "src/base/platform/platform.h"
+#include "src/base/vector.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+// A file with the contents of the read-only pages of a snapshot, written by
+// mksnapshot (--startup-read-only-heap-image).
+//
+// With static roots, read-only pages always live at the same offsets in the
+// pointer compression cage. Instead of copying the read-only snapshot into
+// freshly allocated pages, the deserializer can map the pages copy-on-write
+// from the image (--read-only-heap-image). Pages that are not written during
+// deserialization stay backed by the page cache and are shared between all
+// processes that use the image.
+//
+// Layout:
+// [0] magic number
+// [1] checksum of the read-only snapshot the image was created from
+// [2] number of pages N
+// [3] page 0 entry: compressed page address, offset in file, size
+// ... page N - 1 entry
+// ... page contents, each aligned to kPageAlignment
+//
+// The contents of a page start at the page address. The page header is
+// left empty, it is initialized when the page is allocated.
+class ReadOnlyHeapImage final {
+ public:
+  // The largest OS allocation granularity the image can be mapped with.
+  static constexpr size_t kPageAlignment = 64 * KB;
+
+  ReadOnlyHeapImage(const ReadOnlyHeapImage&) = delete;
+  ReadOnlyHeapImage& operator=(const ReadOnlyHeapImage&) = delete;
+
+  // Writes the image of the given read-only snapshot payload to `path`.
+  // Returns false if the build has no static roots or the file cannot be
+  // written.
+  V8_EXPORT_PRIVATE static bool Write(base::Vector<const uint8_t> payload,
+                                      const char* path);
+
+  // Opens the image at `path`. Returns nullptr if the image cannot be read
+  // or was not created from the given read-only snapshot payload.
+  V8_EXPORT_PRIVATE static std::unique_ptr<ReadOnlyHeapImage> Open(
+      const char* path, base::Vector<const uint8_t> payload);
+
+  // Maps the contents of the `index`-th page of the image over the
+  // `page_size` bytes at `page_start`, where the read-only page at
+  // `compressed_address` was allocated. The first `header_size` bytes, the
+  // page header, are preserved. Returns false if the page does not match the
+  // image or could not be mapped, in which case the memory is unchanged.
+  V8_EXPORT_PRIVATE bool MapPage(int index, uint32_t compressed_address,
+                                 Address page_start, size_t page_size,
+                                 size_t header_size);
+
+ private:
+  static constexpr uint32_t kMagicNumber = 0x524F4849;
+
+  struct Header {
+    uint32_t magic_number;
+    uint32_t checksum;
+    uint32_t page_count;
+  };
+
+  struct PageEntry {
+    uint32_t compressed_address;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  explicit ReadOnlyHeapImage(
+      std::unique_ptr<base::OS::MemoryMappedFile> file)
+      : file_(std::move(file)) {}
+
+  const Header* header() const {
+    return reinterpret_cast<const Header*>(file_->memory());
+  }
+  const PageEntry* page_entries() const {
+    return reinterpret_cast<const PageEntry*>(header() + 1);
+  }
+
+  std::unique_ptr<base::OS::MemoryMappedFile> file_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_SNAPSHOT_READ_ONLY_HEAP_IMAGE_H_
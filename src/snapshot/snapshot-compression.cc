@@ -4,7 +4,12 @@
 
 #include "src/snapshot/snapshot-compression.h"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include "src/base/platform/elapsed-timer.h"
+#include "src/tasks/task-utils.h"
 #include "src/utils/memcopy.h"
 #include "src/utils/utils.h"
 #include "third_party/zlib/google/compression_utils_portable.h"
@@ -12,12 +17,48 @@
 namespace v8 {
 namespace internal {
 
-uint32_t GetUncompressedSize(const Bytef* compressed_data) {
-  uint32_t size;
-  MemCopy(&size, compressed_data, sizeof(size));
-  return size;
+namespace {
+
+// The compressed data starts with a header of uint32_t-sized entries:
+// [0] uncompressed payload length
+// [1] codec
+// [2] uncompressed chunk size
+// [3] number of chunks
+// ... compressed size of each chunk
+// ... compressed chunks
+// Chunks are compressed independently, so that they can be decompressed in
+// parallel.
+constexpr uint32_t kPayloadLengthOffset = 0;
+constexpr uint32_t kCodecOffset = kPayloadLengthOffset + kUInt32Size;
+constexpr uint32_t kChunkSizeOffset = kCodecOffset + kUInt32Size;
+constexpr uint32_t kChunkCountOffset = kChunkSizeOffset + kUInt32Size;
+constexpr uint32_t kChunkSizesOffset = kChunkCountOffset + kUInt32Size;
+
+uint32_t GetHeaderValue(const uint8_t* data, uint32_t offset) {
+  uint32_t value;
+  MemCopy(&value, data + offset, sizeof(value));
+  return value;
+}
+
+void SetHeaderValue(uint8_t* data, uint32_t offset, uint32_t value) {
+  MemCopy(data + offset, &value, sizeof(value));
+}
+
+SnapshotCompression::Codec CodecFromFlag() {
+  const char* codec = v8_flags.snapshot_compression_codec;
+  if (strcmp(codec, "deflate") == 0) return SnapshotCompression::kDeflate;
+  if (strcmp(codec, "store") == 0) return SnapshotCompression::kStore;
+  FATAL("Unknown snapshot compression codec '%s'", codec);
+}
+
+void ProcessChunks(size_t chunk_count,
+                   std::function<void(size_t)> process_chunk) {
+  ProcessChunksInParallel(chunk_count, !v8_flags.single_threaded,
+                          std::move(process_chunk));
 }
 
+}  // namespace
+
 SnapshotData SnapshotCompression::Compress(
     const SnapshotData* uncompressed_data) {
   SnapshotData snapshot_data;
@@ -25,40 +66,62 @@ SnapshotData SnapshotCompression::Compress(
   if (v8_flags.profile_deserialization) timer.Start();
 
   static_assert(sizeof(Bytef) == 1, "");
-  const uLongf input_size =
-      static_cast<uLongf>(uncompressed_data->RawData().size());
-  uint32_t payload_length =
-      static_cast<uint32_t>(uncompressed_data->RawData().size());
-
-  uLongf compressed_data_size = compressBound(input_size);
-
-  // Allocating >= the final amount we will need.
-  snapshot_data.AllocateData(
-      static_cast<uint32_t>(sizeof(payload_length) + compressed_data_size));
-
+  const Codec codec = CodecFromFlag();
+  base::Vector<const uint8_t> input = uncompressed_data->RawData();
+  const uint32_t payload_length = static_cast<uint32_t>(input.size());
+  CHECK_GT(v8_flags.snapshot_compression_chunk_size, 0);
+  const uint32_t chunk_size =
+      static_cast<uint32_t>(v8_flags.snapshot_compression_chunk_size) * KB;
+  const uint32_t chunk_count = (payload_length + chunk_size - 1) / chunk_size;
+
+  // Compress every chunk into its own buffer first; the sizes are only known
+  // afterwards.
+  std::vector<std::vector<Bytef>> chunks(chunk_count);
+  ProcessChunks(chunk_count, [&](size_t index) {
+    const uint32_t offset = static_cast<uint32_t>(index) * chunk_size;
+    const uint8_t* chunk_start = input.begin() + offset;
+    const uint32_t chunk_length = std::min(chunk_size, payload_length - offset);
+    std::vector<Bytef>& chunk = chunks[index];
+    if (codec == kStore) {
+      chunk.assign(chunk_start, chunk_start + chunk_length);
+      return;
+    }
+    uLongf compressed_size = compressBound(chunk_length);
+    chunk.resize(compressed_size);
+    CHECK_EQ(zlib_internal::CompressHelper(
+                 zlib_internal::ZRAW, chunk.data(), &compressed_size,
+                 base::bit_cast<const Bytef*>(chunk_start),
+                 static_cast<uLongf>(chunk_length),
+                 Z_DEFAULT_COMPRESSION, nullptr, nullptr),
+             Z_OK);
+    chunk.resize(compressed_size);
+  });
+
+  uint32_t size = kChunkSizesOffset + chunk_count * kUInt32Size;
+  for (const std::vector<Bytef>& chunk : chunks) {
+    size += static_cast<uint32_t>(chunk.size());
+  }
+  snapshot_data.AllocateData(size);
   uint8_t* compressed_data =
       const_cast<uint8_t*>(snapshot_data.RawData().begin());
-  // Since we are doing raw compression (no zlib or gzip headers), we need to
-  // manually store the uncompressed size.
-  MemCopy(compressed_data, &payload_length, sizeof(payload_length));
-
-  CHECK_EQ(
-      zlib_internal::CompressHelper(
-          zlib_internal::ZRAW, compressed_data + sizeof(payload_length),
-          &compressed_data_size,
-          base::bit_cast<const Bytef*>(uncompressed_data->RawData().begin()),
-          input_size, Z_DEFAULT_COMPRESSION, nullptr, nullptr),
-      Z_OK);
-
-  // Reallocating to exactly the size we need.
-  snapshot_data.Resize(static_cast<uint32_t>(compressed_data_size) +
-                       sizeof(payload_length));
-  DCHECK_EQ(payload_length,
-            GetUncompressedSize(snapshot_data.RawData().begin()));
+  SetHeaderValue(compressed_data, kPayloadLengthOffset, payload_length);
+  SetHeaderValue(compressed_data, kCodecOffset, codec);
+  SetHeaderValue(compressed_data, kChunkSizeOffset, chunk_size);
+  SetHeaderValue(compressed_data, kChunkCountOffset, chunk_count);
+  uint8_t* cursor =
+      compressed_data + kChunkSizesOffset + chunk_count * kUInt32Size;
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    SetHeaderValue(compressed_data, kChunkSizesOffset + i * kUInt32Size,
+                   static_cast<uint32_t>(chunks[i].size()));
+    MemCopy(cursor, chunks[i].data(), chunks[i].size());
+    cursor += chunks[i].size();
+  }
+  DCHECK_EQ(compressed_data + size, cursor);
 
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
-    PrintF("[Compressing %d bytes took %0.3f ms]\n", payload_length, ms);
+    PrintF("[Compressing %d bytes in %d chunks took %0.3f ms]\n",
+           payload_length, chunk_count, ms);
   }
   return snapshot_data;
 }
@@ -69,29 +132,54 @@ SnapshotData SnapshotCompression::Decompress(
   base::ElapsedTimer timer;
   if (v8_flags.profile_deserialization) timer.Start();
 
-  const Bytef* input_bytef =
-      base::bit_cast<const Bytef*>(compressed_data.begin());
-
-  // Since we are doing raw compression (no zlib or gzip headers), we need to
-  // manually retrieve the uncompressed size.
-  uint32_t uncompressed_payload_length = GetUncompressedSize(input_bytef);
-  input_bytef += sizeof(uncompressed_payload_length);
+  const uint8_t* header = compressed_data.begin();
+  const uint32_t uncompressed_payload_length =
+      GetHeaderValue(header, kPayloadLengthOffset);
+  const Codec codec = static_cast<Codec>(GetHeaderValue(header, kCodecOffset));
+  CHECK(codec == kDeflate || codec == kStore);
+  const uint32_t chunk_size = GetHeaderValue(header, kChunkSizeOffset);
+  const uint32_t chunk_count = GetHeaderValue(header, kChunkCountOffset);
+
+  // Find the start of every chunk up front, so that chunks can be
+  // decompressed independently.
+  std::vector<base::Vector<const uint8_t>> chunks(chunk_count);
+  const uint8_t* cursor =
+      header + kChunkSizesOffset + chunk_count * kUInt32Size;
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    uint32_t compressed_size =
+        GetHeaderValue(header, kChunkSizesOffset + i * kUInt32Size);
+    chunks[i] = base::Vector<const uint8_t>(cursor, compressed_size);
+    cursor += compressed_size;
+  }
+  CHECK_EQ(compressed_data.end(), cursor);
 
   snapshot_data.AllocateData(uncompressed_payload_length);
-
-  uLongf uncompressed_size = uncompressed_payload_length;
-  CHECK_EQ(zlib_internal::UncompressHelper(
-               zlib_internal::ZRAW,
-               base::bit_cast<Bytef*>(snapshot_data.RawData().begin()),
-               &uncompressed_size, input_bytef,
-               static_cast<uLong>(compressed_data.size() -
-                                  sizeof(uncompressed_payload_length))),
-           Z_OK);
+  uint8_t* output = const_cast<uint8_t*>(snapshot_data.RawData().begin());
+  ProcessChunks(chunk_count, [&](size_t index) {
+    const uint32_t offset = static_cast<uint32_t>(index) * chunk_size;
+    uint8_t* chunk_start = output + offset;
+    const uint32_t chunk_length =
+        std::min(chunk_size, uncompressed_payload_length - offset);
+    base::Vector<const uint8_t> chunk = chunks[index];
+    if (codec == kStore) {
+      CHECK_EQ(chunk_length, chunk.size());
+      MemCopy(chunk_start, chunk.begin(), chunk_length);
+      return;
+    }
+    uLongf uncompressed_size = static_cast<uLongf>(chunk_length);
+    CHECK_EQ(zlib_internal::UncompressHelper(
+                 zlib_internal::ZRAW, base::bit_cast<Bytef*>(chunk_start),
+                 &uncompressed_size,
+                 base::bit_cast<const Bytef*>(chunk.begin()),
+                 static_cast<uLong>(chunk.size())),
+             Z_OK);
+    CHECK_EQ(chunk_length, uncompressed_size);
+  });
 
   if (v8_flags.profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
-    PrintF("[Decompressing %d bytes took %0.3f ms]\n",
-           uncompressed_payload_length, ms);
+    PrintF("[Decompressing %d bytes in %d chunks took %0.3f ms]\n",
+           uncompressed_payload_length, chunk_count, ms);
   }
   return snapshot_data;
 }
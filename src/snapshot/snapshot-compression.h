@@ -13,6 +13,13 @@ namespace internal {
 
 class SnapshotCompression : public AllStatic {
  public:
+  // How the chunks of a compressed snapshot are encoded. The codec is chosen
+  // with --snapshot-compression-codec when the snapshot is created.
+  enum Codec : uint32_t {
+    kDeflate = 0,  // Raw deflate, smallest output.
+    kStore = 1,    // Uncompressed, fastest to "decompress".
+  };
+
   V8_EXPORT_PRIVATE static SnapshotData Compress(
       const SnapshotData* uncompressed_data);
   V8_EXPORT_PRIVATE static SnapshotData Decompress(
@@ -18,6 +18,7 @@
 #include "src/objects/js-regexp-inl.h"
 #include "src/snapshot/context-deserializer.h"
 #include "src/snapshot/context-serializer.h"
+#include "src/snapshot/read-only-heap-image.h"
 #include "src/snapshot/read-only-serializer.h"
 #include "src/snapshot/shared-heap-serializer.h"
 #include "src/snapshot/snapshot-utils.h"
@@ -679,6 +680,32 @@ bool Snapshot::ExtractRehashability(const v8::StartupData* data) {
   return rehashability != 0;
 }
 
+namespace {
+SnapshotData ExtractReadOnlySnapshotData(const v8::StartupData* data) {
+  base::Vector<const uint8_t> read_only_data =
+      SnapshotImpl::ExtractReadOnlyData(data);
+#ifdef V8_SNAPSHOT_COMPRESSION
+  return SnapshotData(SnapshotCompression::Decompress(read_only_data));
+#else
+  return SnapshotData(read_only_data);
+#endif
+}
+}  // namespace
+
+// static
+bool Snapshot::WriteReadOnlyHeapImage(const v8::StartupData* data,
+                                      const char* path) {
+  SnapshotData read_only_snapshot_data = ExtractReadOnlySnapshotData(data);
+  return ReadOnlyHeapImage::Write(read_only_snapshot_data.Payload(), path);
+}
+
+// static
+std::unique_ptr<ReadOnlyHeapImage> Snapshot::OpenReadOnlyHeapImage(
+    const v8::StartupData* data, const char* path) {
+  SnapshotData read_only_snapshot_data = ExtractReadOnlySnapshotData(data);
+  return ReadOnlyHeapImage::Open(path, read_only_snapshot_data.Payload());
+}
+
 namespace {
 base::Vector<const uint8_t> ExtractData(const v8::StartupData* snapshot,
                                         uint32_t start_offset,
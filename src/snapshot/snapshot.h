@@ -5,6 +5,7 @@
 #ifndef V8_SNAPSHOT_SNAPSHOT_H_
 #define V8_SNAPSHOT_SNAPSHOT_H_
 
+#include <memory>
 #include <vector>
 
 #include "include/v8-array-buffer.h"  // For ArrayBuffer::Allocator.
@@ -18,6 +19,7 @@ namespace internal {
 class Context;
 class Isolate;
 class JSGlobalProxy;
+class ReadOnlyHeapImage;
 class SafepointScope;
 class SnapshotData;
 
@@ -114,6 +116,15 @@ class Snapshot : public AllStatic {
   static bool ExtractRehashability(const v8::StartupData* data);
   static bool VersionIsValid(const v8::StartupData* data);
 
+  // Writes the read-only heap image of the snapshot to `path`, see
+  // ReadOnlyHeapImage. Returns false on failure.
+  V8_EXPORT_PRIVATE static bool WriteReadOnlyHeapImage(
+      const v8::StartupData* data, const char* path);
+  // Opens the read-only heap image at `path` for the snapshot. Returns
+  // nullptr if it is missing, malformed or was written for another snapshot.
+  V8_EXPORT_PRIVATE static std::unique_ptr<ReadOnlyHeapImage>
+  OpenReadOnlyHeapImage(const v8::StartupData* data, const char* path);
+
   // To be implemented by the snapshot source.
   static const v8::StartupData* DefaultSnapshotBlob();
   static bool ShouldVerifyChecksum(const v8::StartupData* data);
@@ -8,8 +8,10 @@
 #include "src/strings/string-hasher.h"
 
 // Comment inserted to prevent header reordering.
+#include <algorithm>
 #include <type_traits>
 
+#include "src/base/bits.h"
 #include "src/objects/name-inl.h"
 #include "src/objects/string-inl.h"
 #include "src/strings/char-predicates-inl.h"
@@ -112,6 +114,11 @@ uint32_t StringHasher::HashSequentialString(const char_t* chars_raw, int length,
   }
 
   // Non-index hash.
+#ifdef V8_ENABLE_SIMD_STRING_HASH
+  if (length >= kLongStringHashMinLength) {
+    return HashLongString(chars, length, seed);
+  }
+#endif  // V8_ENABLE_SIMD_STRING_HASH
   uint32_t running_hash = static_cast<uint32_t>(seed);
   const uchar* end = &chars[length];
   while (chars != end) {
@@ -122,6 +129,106 @@ uint32_t StringHasher::HashSequentialString(const char_t* chars_raw, int length,
                                       String::HashFieldType::kHash);
 }
 
+template <typename uchar>
+bool StringHasher::HasPlainHash(const uchar* chars, int length) {
+#ifdef V8_ENABLE_SIMD_STRING_HASH
+  if (length >= kLongStringHashMinLength) return false;
+#else
+  if (length > String::kMaxHashCalcLength) return false;
+#endif  // V8_ENABLE_SIMD_STRING_HASH
+  return length == 0 || !IsDecimalDigit(chars[0]);
+}
+
+#ifdef V8_ENABLE_SIMD_STRING_HASH
+template <typename uchar>
+uint32_t StringHasher::HashLongString(const uchar* chars, int length,
+                                      uint64_t seed) {
+  DCHECK_GE(length, kLongStringHashMinLength);
+  DCHECK_LE(length, String::kMaxHashCalcLength);
+  // xxHash32 primes.
+  constexpr uint32_t kPrime1 = 0x9E3779B1u;
+  constexpr uint32_t kPrime2 = 0x85EBCA77u;
+  const uint32_t seed_low = static_cast<uint32_t>(seed);
+  const uint32_t seed_high = static_cast<uint32_t>(seed >> 32);
+  uint32_t lanes[kLongStringHashLanes];
+  for (int lane = 0; lane < kLongStringHashLanes; lane++) {
+    lanes[lane] = (seed_low + kPrime1 * (lane + 1)) ^ seed_high;
+  }
+  // Lane {j} mixes in every character at index {i + j}. The lanes don't
+  // depend on each other, so the compiler turns the inner loop into vector
+  // multiplies and rotates.
+  int i = 0;
+  for (; i + kLongStringHashLanes <= length; i += kLongStringHashLanes) {
+    for (int lane = 0; lane < kLongStringHashLanes; lane++) {
+      uint32_t value = lanes[lane] + chars[i + lane] * kPrime2;
+      lanes[lane] = base::bits::RotateLeft32(value, 13) * kPrime1;
+    }
+  }
+  uint32_t running_hash = static_cast<uint32_t>(length);
+  for (int lane = 0; lane < kLongStringHashLanes; lane++) {
+    running_hash =
+        base::bits::RotateLeft32(running_hash ^ lanes[lane], 7) * kPrime2;
+  }
+  for (; i < length; i++) {
+    running_hash = AddCharacterCore(running_hash, chars[i]);
+  }
+  return String::CreateHashFieldValue(GetHashCore(running_hash),
+                                      String::HashFieldType::kHash);
+}
+#endif  // V8_ENABLE_SIMD_STRING_HASH
+
+template <typename char_t>
+void StringHasher::HashSequentialStrings(const char_t* const* strings_raw,
+                                         const int* lengths, int count,
+                                         uint64_t seed,
+                                         uint32_t* raw_hash_fields) {
+  static_assert(std::is_integral<char_t>::value);
+  static_assert(sizeof(char_t) <= 2);
+  using uchar = typename std::make_unsigned<char_t>::type;
+  const uchar* const* strings =
+      reinterpret_cast<const uchar* const*>(strings_raw);
+  // Number of plain hashes computed in lockstep. Each running hash is a
+  // serial dependency chain; interleaving independent chains keeps the
+  // execution units busy.
+  constexpr int kInterleave = 4;
+  int i = 0;
+  while (i + kInterleave <= count) {
+    bool all_plain = true;
+    int common_length = lengths[i];
+    for (int k = 0; k < kInterleave; k++) {
+      all_plain &= HasPlainHash(strings[i + k], lengths[i + k]);
+      common_length = std::min(common_length, lengths[i + k]);
+    }
+    if (!all_plain) {
+      raw_hash_fields[i] = HashSequentialString(strings[i], lengths[i], seed);
+      i++;
+      continue;
+    }
+    uint32_t running_hashes[kInterleave];
+    for (int k = 0; k < kInterleave; k++) {
+      running_hashes[k] = static_cast<uint32_t>(seed);
+    }
+    for (int j = 0; j < common_length; j++) {
+      for (int k = 0; k < kInterleave; k++) {
+        running_hashes[k] =
+            AddCharacterCore(running_hashes[k], strings[i + k][j]);
+      }
+    }
+    for (int k = 0; k < kInterleave; k++) {
+      const uchar* chars = strings[i + k];
+      for (int j = common_length; j < lengths[i + k]; j++) {
+        running_hashes[k] = AddCharacterCore(running_hashes[k], chars[j]);
+      }
+      raw_hash_fields[i + k] = String::CreateHashFieldValue(
+          GetHashCore(running_hashes[k]), String::HashFieldType::kHash);
+    }
+    i += kInterleave;
+  }
+  for (; i < count; i++) {
+    raw_hash_fields[i] = HashSequentialString(strings[i], lengths[i], seed);
+  }
+}
+
 std::size_t SeededStringHasher::operator()(const char* name) const {
   return StringHasher::HashSequentialString(
       name, static_cast<int>(strlen(name)), hashseed_);
@@ -25,6 +25,16 @@ class V8_EXPORT_PRIVATE StringHasher final {
   static inline uint32_t HashSequentialString(const char_t* chars, int length,
                                               uint64_t seed);
 
+  // Hashes {count} independent strings and stores their raw hash fields in
+  // {raw_hash_fields}. The results are identical to calling
+  // HashSequentialString on each string, but the hash chains of short keys
+  // are interleaved so that their computations overlap.
+  template <typename char_t>
+  static inline void HashSequentialStrings(const char_t* const* strings,
+                                           const int* lengths, int count,
+                                           uint64_t seed,
+                                           uint32_t* raw_hash_fields);
+
   // Calculated hash value for a string consisting of 1 to
   // String::kMaxArrayIndexSize digits with no leading zeros (except "0").
   // value is represented decimal value.
@@ -40,6 +50,25 @@ class V8_EXPORT_PRIVATE StringHasher final {
   V8_INLINE static uint32_t GetHashCore(uint32_t running_hash);
 
   static inline uint32_t GetTrivialHash(int length);
+
+#ifdef V8_ENABLE_SIMD_STRING_HASH
+  // Non-index strings of at least this length are hashed in
+  // kLongStringHashLanes independent lanes that map onto SIMD registers.
+  static constexpr int kLongStringHashMinLength = 32;
+  static constexpr int kLongStringHashLanes = 8;
+#endif  // V8_ENABLE_SIMD_STRING_HASH
+
+ private:
+  // Returns true if the hash of {chars} is the plain character-by-character
+  // hash, i.e. it is neither an index nor a long string.
+  template <typename uchar>
+  V8_INLINE static bool HasPlainHash(const uchar* chars, int length);
+
+#ifdef V8_ENABLE_SIMD_STRING_HASH
+  template <typename uchar>
+  V8_INLINE static uint32_t HashLongString(const uchar* chars, int length,
+                                           uint64_t seed);
+#endif  // V8_ENABLE_SIMD_STRING_HASH
 };
 
 // Useful for std containers that require something ()'able.
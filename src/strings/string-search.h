@@ -5,11 +5,32 @@
 #ifndef V8_STRINGS_STRING_SEARCH_H_
 #define V8_STRINGS_STRING_SEARCH_H_
 
+#include <algorithm>
+
+#include "src/base/bits.h"
 #include "src/base/strings.h"
 #include "src/base/vector.h"
 #include "src/execution/isolate.h"
 #include "src/objects/string.h"
 
+#if defined(__AVX2__)
+#define V8_STRING_SEARCH_USE_AVX2 1
+#include <immintrin.h>
+#elif (defined(__SSE2__) ||  \
+       (defined(_MSC_VER) && \
+        (defined(_M_X64) || (defined(_M_IX86) && _M_IX86_FP >= 2))))
+#define V8_STRING_SEARCH_USE_SSE2 1
+#include <emmintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+#define V8_STRING_SEARCH_USE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(V8_STRING_SEARCH_USE_AVX2) || \
+    defined(V8_STRING_SEARCH_USE_SSE2) || defined(V8_STRING_SEARCH_USE_NEON)
+#define V8_STRING_SEARCH_USE_PACKED_SEARCH 1
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -42,6 +63,12 @@ class StringSearchBase {
   // to compensate for the algorithmic overhead compared to simple brute force.
   static const int kBMMinPatternLength = 7;
 
+  // Patterns up to this length are searched for by comparing their first and
+  // last characters against a block of subject positions at once, if SIMD
+  // instructions are available. Longer patterns benefit more from the
+  // Boyer-Moore skip tables.
+  static const int kPackedSearchMaxPatternLength = 64;
+
   static inline bool IsOneByteString(base::Vector<const uint8_t> string) {
     return true;
   }
@@ -67,11 +94,17 @@ class StringSearch : private StringSearchBase {
       }
     }
     int pattern_length = pattern_.length();
+    if (pattern_length == 1) {
+      strategy_ = &SingleCharSearch;
+      return;
+    }
+#ifdef V8_STRING_SEARCH_USE_PACKED_SEARCH
+    if (pattern_length <= kPackedSearchMaxPatternLength) {
+      strategy_ = &PackedSearch;
+      return;
+    }
+#endif  // V8_STRING_SEARCH_USE_PACKED_SEARCH
     if (pattern_length < kBMMinPatternLength) {
-      if (pattern_length == 1) {
-        strategy_ = &SingleCharSearch;
-        return;
-      }
       strategy_ = &LinearSearch;
       return;
     }
@@ -114,6 +147,12 @@ class StringSearch : private StringSearchBase {
                            base::Vector<const SubjectChar> subject,
                            int start_index);
 
+#ifdef V8_STRING_SEARCH_USE_PACKED_SEARCH
+  static int PackedSearch(StringSearch<PatternChar, SubjectChar>* search,
+                          base::Vector<const SubjectChar> subject,
+                          int start_index);
+#endif  // V8_STRING_SEARCH_USE_PACKED_SEARCH
+
   static int BoyerMooreHorspoolSearch(
       StringSearch<PatternChar, SubjectChar>* search,
       base::Vector<const SubjectChar> subject, int start_index);
@@ -533,6 +572,143 @@ int StringSearch<PatternChar, SubjectChar>::InitialSearch(
   return -1;
 }
 
+#ifdef V8_STRING_SEARCH_USE_PACKED_SEARCH
+//---------------------------------------------------------------------
+// Packed first and last character search
+//---------------------------------------------------------------------
+
+#ifdef V8_STRING_SEARCH_USE_AVX2
+constexpr int kPackedSearchBlockSize = 32;
+#else
+constexpr int kPackedSearchBlockSize = 16;
+#endif
+// Number of bits per byte in the mask returned by MatchPackedCharPair().
+#ifdef V8_STRING_SEARCH_USE_NEON
+constexpr int kPackedSearchMaskBitsPerByte = 4;
+#else
+constexpr int kPackedSearchMaskBitsPerByte = 1;
+#endif
+
+// Compares the kPackedSearchBlockSize bytes at |first| and |last| with |c1|
+// and |c2| respectively. Returns a mask that has the lowest of the
+// kPackedSearchMaskBitsPerByte * sizeof(Char) bits of character i set iff
+// first[i] == c1 and last[i] == c2.
+template <typename Char>
+V8_INLINE uint64_t MatchPackedCharPair(const Char* first, const Char* last,
+                                       Char c1, Char c2) {
+#if defined(V8_STRING_SEARCH_USE_AVX2)
+  __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+  __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last));
+  if constexpr (sizeof(Char) == 1) {
+    __m256i eq = _mm256_and_si256(
+        _mm256_cmpeq_epi8(v1, _mm256_set1_epi8(static_cast<char>(c1))),
+        _mm256_cmpeq_epi8(v2, _mm256_set1_epi8(static_cast<char>(c2))));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+  } else {
+    __m256i eq = _mm256_and_si256(
+        _mm256_cmpeq_epi16(v1, _mm256_set1_epi16(static_cast<int16_t>(c1))),
+        _mm256_cmpeq_epi16(v2, _mm256_set1_epi16(static_cast<int16_t>(c2))));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(eq)) & 0x55555555u;
+  }
+#elif defined(V8_STRING_SEARCH_USE_SSE2)
+  __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+  __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last));
+  if constexpr (sizeof(Char) == 1) {
+    __m128i eq = _mm_and_si128(
+        _mm_cmpeq_epi8(v1, _mm_set1_epi8(static_cast<char>(c1))),
+        _mm_cmpeq_epi8(v2, _mm_set1_epi8(static_cast<char>(c2))));
+    return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+  } else {
+    __m128i eq = _mm_and_si128(
+        _mm_cmpeq_epi16(v1, _mm_set1_epi16(static_cast<int16_t>(c1))),
+        _mm_cmpeq_epi16(v2, _mm_set1_epi16(static_cast<int16_t>(c2))));
+    return static_cast<uint32_t>(_mm_movemask_epi8(eq)) & 0x5555u;
+  }
+#else
+  uint8x16_t eq;
+  uint64_t lowest_bits;
+  if constexpr (sizeof(Char) == 1) {
+    eq = vandq_u8(vceqq_u8(vld1q_u8(first), vdupq_n_u8(c1)),
+                  vceqq_u8(vld1q_u8(last), vdupq_n_u8(c2)));
+    lowest_bits = 0x1111111111111111ull;
+  } else {
+    eq = vreinterpretq_u8_u16(
+        vandq_u16(vceqq_u16(vld1q_u16(first), vdupq_n_u16(c1)),
+                  vceqq_u16(vld1q_u16(last), vdupq_n_u16(c2))));
+    lowest_bits = 0x0101010101010101ull;
+  }
+  // Narrow every byte of the comparison result to a nibble to get a
+  // movemask equivalent.
+  uint64_t mask = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+  return mask & lowest_bits;
+#endif
+}
+
+// Like memchr for the pair of the first and the last pattern character:
+// candidate positions are found a block at a time, and only those are
+// compared with the rest of the pattern. Needs no tables, so it is also
+// cheap to set up for medium-sized patterns. Patterns that can be searched
+// with Boyer-Moore-Horspool bail out to it, like InitialSearch, if there
+// are too many false candidates.
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::PackedSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    base::Vector<const SubjectChar> subject, int index) {
+  base::Vector<const PatternChar> pattern = search->pattern_;
+  const int pattern_length = pattern.length();
+  DCHECK(base::IsInRange(pattern_length, 2, kPackedSearchMaxPatternLength));
+  // The constructor made sure that a two-byte pattern searched for in a
+  // one-byte subject only has one-byte characters.
+  const SubjectChar first_char = static_cast<SubjectChar>(pattern[0]);
+  const SubjectChar last_char =
+      static_cast<SubjectChar>(pattern[pattern_length - 1]);
+  constexpr int kBlockLength = kPackedSearchBlockSize / sizeof(SubjectChar);
+  constexpr int kMaskBitsPerChar =
+      kPackedSearchMaskBitsPerByte * sizeof(SubjectChar);
+  const bool can_bail_out = pattern_length >= kBMMinPatternLength;
+  // Badness is a count of how much more work was done than a scan of the
+  // subject, as in InitialSearch. Each block scanned earns a credit, but
+  // never more than the initial one, so that a long stretch without
+  // candidates does not hide a later one with many.
+  const int initial_badness = -10 - (pattern_length << 2);
+  int badness = initial_badness;
+  const int n = subject.length() - pattern_length;
+  int i = index;
+  for (; i <= n - kBlockLength + 1; i += kBlockLength) {
+    const SubjectChar* block = subject.begin() + i;
+    uint64_t mask = MatchPackedCharPair(block, block + pattern_length - 1,
+                                        first_char, last_char);
+    badness = std::max(initial_badness, badness - kBlockLength);
+    while (mask != 0) {
+      int offset = base::bits::CountTrailingZeros(mask) / kMaskBitsPerChar;
+      int j = 1;
+      while (j < pattern_length - 1 && pattern[j] == block[offset + j]) j++;
+      if (j == pattern_length - 1) return i + offset;
+      // Charge the candidate and the characters compared for it.
+      badness += 1 + j;
+      if (can_bail_out && badness > 0) {
+        search->PopulateBoyerMooreHorspoolTable();
+        search->strategy_ = &BoyerMooreHorspoolSearch;
+        return BoyerMooreHorspoolSearch(search, subject, i + offset + 1);
+      }
+      mask &= mask - 1;
+    }
+  }
+  // Check the remaining positions one at a time.
+  for (; i <= n; i++) {
+    if (subject[i] != first_char) continue;
+    if (subject[i + pattern_length - 1] != last_char) continue;
+    if (pattern_length == 2 ||
+        CharCompare(pattern.begin() + 1, subject.begin() + i + 1,
+                    pattern_length - 2)) {
+      return i;
+    }
+  }
+  return -1;
+}
+#endif  // V8_STRING_SEARCH_USE_PACKED_SEARCH
+
 // Perform a a single stand-alone search.
 // If searching multiple times for the same pattern, a search
 // object should be constructed once and the Search function then called
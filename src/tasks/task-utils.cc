@@ -4,6 +4,10 @@
 
 #include "src/tasks/task-utils.h"
 
+#include <atomic>
+
+#include "include/v8-platform.h"
+#include "src/init/v8.h"
 #include "src/tasks/cancelable-task.h"
 
 namespace v8 {
@@ -38,6 +42,31 @@ class CancelableIdleFuncTask final : public CancelableIdleTask {
   const std::function<void(double)> func_;
 };
 
+class ProcessChunksJob final : public JobTask {
+ public:
+  ProcessChunksJob(size_t chunk_count,
+                   std::function<void(size_t)> process_chunk)
+      : chunk_count_(chunk_count), process_chunk_(std::move(process_chunk)) {}
+
+  void Run(JobDelegate* delegate) override {
+    size_t index;
+    while ((index = next_chunk_.fetch_add(1, std::memory_order_relaxed)) <
+           chunk_count_) {
+      process_chunk_(index);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t /* worker_count */) const override {
+    size_t next_chunk = next_chunk_.load(std::memory_order_relaxed);
+    return next_chunk < chunk_count_ ? chunk_count_ - next_chunk : 0;
+  }
+
+ private:
+  const size_t chunk_count_;
+  const std::function<void(size_t)> process_chunk_;
+  std::atomic<size_t> next_chunk_{0};
+};
+
 }  // namespace
 
 std::unique_ptr<CancelableTask> MakeCancelableTask(Isolate* isolate,
@@ -60,5 +89,18 @@ std::unique_ptr<CancelableIdleTask> MakeCancelableIdleTask(
   return std::make_unique<CancelableIdleFuncTask>(manager, std::move(func));
 }
 
+void ProcessChunksInParallel(size_t chunk_count, bool parallel,
+                             std::function<void(size_t)> process_chunk) {
+  if (chunk_count <= 1 || !parallel) {
+    for (size_t i = 0; i < chunk_count; i++) process_chunk(i);
+    return;
+  }
+  V8::GetCurrentPlatform()
+      ->CreateJob(TaskPriority::kUserBlocking,
+                  std::make_unique<ProcessChunksJob>(chunk_count,
+                                                     std::move(process_chunk)))
+      ->Join();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -27,6 +27,13 @@ std::unique_ptr<CancelableIdleTask> MakeCancelableIdleTask(
 std::unique_ptr<CancelableIdleTask> MakeCancelableIdleTask(
     CancelableTaskManager* manager, std::function<void(double)>);
 
+// Calls |process_chunk| for every index in [0, chunk_count) and returns once
+// all of them are done. If |parallel| is set, the indices are claimed one at a
+// time by a job on the platform's worker threads, which the calling thread
+// joins; otherwise they are processed in order on the calling thread.
+void ProcessChunksInParallel(size_t chunk_count, bool parallel,
+                             std::function<void(size_t)> process_chunk);
+
 }  // namespace internal
 }  // namespace v8
 
@@ -12,6 +12,7 @@
 #include "src/base/logging.h"
 #include "src/base/page-allocator.h"
 #include "src/base/platform/memory.h"
+#include "src/base/platform/platform.h"
 #include "src/base/sanitizer/lsan-page-allocator.h"
 #include "src/base/sanitizer/lsan-virtual-address-space.h"
 #include "src/base/virtual-address-space.h"
@@ -201,6 +202,21 @@ bool SetPermissions(v8::PageAllocator* page_allocator, void* address,
   return page_allocator->SetPermissions(address, size, access);
 }
 
+bool AdviseTransparentHugePages(base::AddressRegion region) {
+  if (!v8_flags.transparent_huge_pages) return false;
+  // base::OS::AdviseHugePages() is only defined where transparent huge pages
+  // are supported, so the call has to be in a discarded branch elsewhere.
+  if constexpr (!base::OS::IsTransparentHugePageSupported()) {
+    return false;
+  } else {
+    const Address start = RoundUp(region.begin(), size_t{kHugePageSize});
+    const Address end = RoundDown(region.end(), size_t{kHugePageSize});
+    if (end <= start) return false;
+    return base::OS::AdviseHugePages(reinterpret_cast<void*>(start),
+                                     end - start);
+  }
+}
+
 void OnCriticalMemoryPressure() {
   V8::GetCurrentPlatform()->OnCriticalMemoryPressure();
 }
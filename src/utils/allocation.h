@@ -181,6 +181,11 @@ inline bool SetPermissions(v8::PageAllocator* page_allocator, Address address,
                         access);
 }
 
+// Advises the OS to back the committed parts of |region| with transparent huge
+// pages if --transparent-huge-pages is set. Returns true if the advice was
+// applied to at least one huge page.
+V8_EXPORT_PRIVATE bool AdviseTransparentHugePages(base::AddressRegion region);
+
 // Defines whether the address space reservation is going to be used for
 // allocating executable pages.
 enum class JitPermission { kNoJit, kMapAsJittable };
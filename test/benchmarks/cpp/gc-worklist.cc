@@ -0,0 +1,125 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "src/base/logging.h"
+#include "src/base/platform/yield-processor.h"
+#include "src/base/utils/random-number-generator.h"
+#include "src/heap/base/worklist.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+// A node of a synthetic object graph. Marking the graph with the worklist
+// mimics the transitive closure computed by parallel marking.
+struct Node {
+  bool TryMark() { return !marked.exchange(true, std::memory_order_relaxed); }
+
+  std::atomic<bool> marked{false};
+  std::vector<Node*> children;
+};
+
+using NodeWorklist = heap::base::Worklist<Node*, 64>;
+
+constexpr size_t kNumNodes = 1 << 20;
+constexpr size_t kFanout = 4;
+// Length of the chain at the start of the graph. Only one thread can make
+// progress on it, while the others wait for the work behind it.
+constexpr size_t kChainLength = 1 << 10;
+
+// Builds a graph that starts with a long chain followed by a wide tree, with
+// an additional random edge per node.
+std::vector<std::unique_ptr<Node>> MakeGraph() {
+  std::vector<std::unique_ptr<Node>> nodes(kNumNodes);
+  for (auto& node : nodes) node = std::make_unique<Node>();
+  for (size_t i = 0; i + 1 < kChainLength; i++) {
+    nodes[i]->children.push_back(nodes[i + 1].get());
+  }
+  for (size_t i = kChainLength - 1; i < kNumNodes; i++) {
+    const size_t tree_index = i - (kChainLength - 1);
+    for (size_t child = 1; child <= kFanout; child++) {
+      const size_t child_index =
+          kChainLength - 1 + tree_index * kFanout + child;
+      if (child_index >= kNumNodes) break;
+      nodes[i]->children.push_back(nodes[child_index].get());
+    }
+  }
+  v8::base::RandomNumberGenerator rng(42);
+  for (auto& node : nodes) {
+    node->children.push_back(
+        nodes[static_cast<size_t>(rng.NextInt(kNumNodes))].get());
+  }
+  return nodes;
+}
+
+// Drains the worklist from one thread. `active` counts the threads that may
+// still produce work; marking is done once the worklist is empty and no
+// thread is active.
+size_t MarkFromWorklist(NodeWorklist* worklist, std::atomic<size_t>* active) {
+  NodeWorklist::Local local(*worklist);
+  size_t visited = 0;
+  Node* node;
+  while (true) {
+    while (local.Pop(&node)) {
+      visited++;
+      for (Node* child : node->children) {
+        if (child->TryMark()) local.Push(child);
+      }
+      // Share work with idle threads, like the marking visitors do.
+      if (worklist->IsEmpty() && !local.IsLocalEmpty()) local.Publish();
+    }
+    active->fetch_sub(1);
+    while (worklist->IsEmpty()) {
+      if (active->load() == 0) return visited;
+      YIELD_PROCESSOR;
+    }
+    active->fetch_add(1);
+  }
+}
+
+// Marks the whole graph with `state.range(0)` threads. `state.range(1)`
+// selects a single shared segment stack (0) or one stack per thread (1).
+void BM_GCWorklistMarking(benchmark::State& state) {
+  const size_t num_threads = static_cast<size_t>(state.range(0));
+  const size_t num_stacks = state.range(1) ? num_threads : 1;
+  std::vector<std::unique_ptr<Node>> nodes = MakeGraph();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (auto& node : nodes) node->marked.store(false);
+    NodeWorklist worklist(num_stacks);
+    {
+      NodeWorklist::Local local(worklist);
+      nodes[0]->TryMark();
+      local.Push(nodes[0].get());
+      local.Publish();
+    }
+    state.ResumeTiming();
+
+    std::atomic<size_t> active{num_threads};
+    std::atomic<size_t> visited{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; i++) {
+      threads.emplace_back([&worklist, &active, &visited]() {
+        visited += MarkFromWorklist(&worklist, &active);
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
+    CHECK_EQ(kNumNodes, visited.load());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          kNumNodes);
+}
+
+}  // namespace
+
+BENCHMARK(BM_GCWorklistMarking)
+    ->ArgNames({"threads", "work_stealing"})
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,263 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures TLB misses on a large heap and on many functions. Compare runs
+// with and without --transparent-huge-pages, e.g.
+//
+//   huge_pages_benchmark
+//   huge_pages_benchmark --transparent-huge-pages
+//
+// The dTLB-load-misses and iTLB-load-misses counters are only reported on
+// Linux when perf events are accessible, see
+// /proc/sys/kernel/perf_event_paranoid.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "include/libplatform/libplatform.h"
+#include "include/v8-array-buffer.h"
+#include "include/v8-context.h"
+#include "include/v8-function.h"
+#include "include/v8-initialization.h"
+#include "include/v8-isolate.h"
+#include "include/v8-local-handle.h"
+#include "include/v8-primitive.h"
+#include "include/v8-script.h"
+#include "include/v8config.h"
+#include "src/base/logging.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+#if V8_OS_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Counts the TLB misses of the calling thread in user space.
+class TlbMissCounter {
+ public:
+  enum class Tlb { kData, kInstruction };
+
+  explicit TlbMissCounter(Tlb tlb) {
+#if V8_OS_LINUX
+    perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = (tlb == Tlb::kData ? PERF_COUNT_HW_CACHE_DTLB
+                                     : PERF_COUNT_HW_CACHE_ITLB) |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  ~TlbMissCounter() {
+#if V8_OS_LINUX
+    if (fd_ >= 0) close(fd_);
+#endif
+  }
+
+  TlbMissCounter(const TlbMissCounter&) = delete;
+  TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+  bool IsAvailable() const { return fd_ >= 0; }
+
+  void Start() {
+#if V8_OS_LINUX
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  uint64_t Stop() {
+    uint64_t count = 0;
+#if V8_OS_LINUX
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd_, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+    return count;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+// Builds a ring of |objects| objects in random order and returns a function
+// that follows it for a given number of steps. Consecutive steps land on
+// unrelated pages of the heap.
+constexpr char kPointerChaseSource[] = R"(
+  (function(objects) {
+    const nodes = [];
+    for (let i = 0; i < objects; i++) nodes.push({next: null, value: i});
+    for (let i = objects - 1; i > 0; i--) {
+      const j = Math.floor(Math.random() * (i + 1));
+      [nodes[i], nodes[j]] = [nodes[j], nodes[i]];
+    }
+    for (let i = 0; i < objects; i++) {
+      nodes[i].next = nodes[(i + 1) % objects];
+    }
+    let current = nodes[0];
+    return function(steps) {
+      let sum = 0;
+      for (let i = 0; i < steps; i++) {
+        sum += current.value;
+        current = current.next;
+      }
+      return sum;
+    };
+  })
+)";
+
+// Defines |functions| distinct functions and returns one that calls each of
+// them once, so that their code is spread over many pages of the code space.
+constexpr char kManyFunctionsSource[] = R"(
+  (function(functions) {
+    const fs = [];
+    for (let i = 0; i < functions; i++) {
+      fs.push(new Function('x', `return (x * ${i} + ${i}) | 0;`));
+    }
+    return function(rounds) {
+      let sum = 0;
+      for (let r = 0; r < rounds; r++) {
+        for (let i = 0; i < fs.length; i++) sum = fs[i](sum);
+      }
+      return sum;
+    };
+  })
+)";
+
+constexpr int kStepsPerIteration = 1 << 20;
+
+class HugePagesBenchmark : public benchmark::Fixture {
+ public:
+  static void InitializeProcess(int* argc, char** argv) {
+    v8::V8::InitializeICUDefaultLocation(argv[0]);
+    v8::V8::InitializeExternalStartupData(argv[0]);
+    // V8 flags such as --transparent-huge-pages are consumed here, the rest
+    // is left for the benchmark library.
+    v8::V8::SetFlagsFromCommandLine(argc, argv, true);
+    platform_ = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform(platform_.get());
+    v8::V8::Initialize();
+  }
+
+  static void ShutdownProcess() {
+    v8::V8::Dispose();
+    v8::V8::DisposePlatform();
+    platform_.reset();
+  }
+
+  void SetUp(::benchmark::State& state) override {
+    allocator_.reset(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = allocator_.get();
+    isolate_ = v8::Isolate::New(create_params);
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    isolate_->Dispose();
+    isolate_ = nullptr;
+  }
+
+ protected:
+  // Runs the function that |source| returns for |size| with
+  // |steps_per_iteration| in every iteration.
+  void Run(::benchmark::State& state, const char* source, int size,
+           int steps_per_iteration) {
+    v8::Isolate::Scope isolate_scope(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Context> context = v8::Context::New(isolate_);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Function> setup = Compile(context, source);
+    v8::Local<v8::Value> size_arg = v8::Integer::New(isolate_, size);
+    v8::Local<v8::Function> run = v8::Local<v8::Function>::Cast(
+        setup->Call(context, context->Global(), 1, &size_arg)
+            .ToLocalChecked());
+    v8::Local<v8::Value> steps_arg =
+        v8::Integer::New(isolate_, steps_per_iteration);
+
+    TlbMissCounter dtlb(TlbMissCounter::Tlb::kData);
+    TlbMissCounter itlb(TlbMissCounter::Tlb::kInstruction);
+    uint64_t dtlb_misses = 0;
+    uint64_t itlb_misses = 0;
+    for (auto _ : state) {
+      v8::HandleScope iteration_scope(isolate_);
+      if (dtlb.IsAvailable()) dtlb.Start();
+      if (itlb.IsAvailable()) itlb.Start();
+      v8::Local<v8::Value> result =
+          run->Call(context, context->Global(), 1, &steps_arg)
+              .ToLocalChecked();
+      if (itlb.IsAvailable()) itlb_misses += itlb.Stop();
+      if (dtlb.IsAvailable()) dtlb_misses += dtlb.Stop();
+      benchmark::DoNotOptimize(result);
+    }
+    if (dtlb.IsAvailable()) {
+      state.counters["dTLB-load-misses"] = benchmark::Counter(
+          static_cast<double>(dtlb_misses), benchmark::Counter::kAvgIterations);
+    }
+    if (itlb.IsAvailable()) {
+      state.counters["iTLB-load-misses"] = benchmark::Counter(
+          static_cast<double>(itlb_misses), benchmark::Counter::kAvgIterations);
+    }
+  }
+
+ private:
+  v8::Local<v8::Function> Compile(v8::Local<v8::Context> context,
+                                  const char* source) {
+    v8::Local<v8::String> source_string =
+        v8::String::NewFromUtf8(isolate_, source).ToLocalChecked();
+    v8::Local<v8::Script> script =
+        v8::Script::Compile(context, source_string).ToLocalChecked();
+    return v8::Local<v8::Function>::Cast(
+        script->Run(context).ToLocalChecked());
+  }
+
+  static std::unique_ptr<v8::Platform> platform_;
+
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator_;
+  v8::Isolate* isolate_ = nullptr;
+};
+
+std::unique_ptr<v8::Platform> HugePagesBenchmark::platform_;
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(HugePagesBenchmark, PointerChase)
+(benchmark::State& state) {
+  Run(state, kPointerChaseSource, static_cast<int>(state.range(0)),
+      kStepsPerIteration);
+}
+BENCHMARK_DEFINE_F(HugePagesBenchmark, ManyFunctions)
+(benchmark::State& state) {
+  Run(state, kManyFunctionsSource, static_cast<int>(state.range(0)), 16);
+}
+
+// 1M objects are roughly 40MB, 4M objects roughly 160MB of old space.
+BENCHMARK_REGISTER_F(HugePagesBenchmark, PointerChase)
+    ->Arg(1 << 20)
+    ->Arg(1 << 22);
+BENCHMARK_REGISTER_F(HugePagesBenchmark, ManyFunctions)
+    ->Arg(1 << 12)
+    ->Arg(1 << 14);
+
+// Expanded macro BENCHMARK_MAIN() to allow per-process setup.
+int main(int argc, char** argv) {
+  HugePagesBenchmark::InitializeProcess(&argc, argv);
+  // Contents of BENCHMARK_MAIN().
+  {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+  }
+  HugePagesBenchmark::ShutdownProcess();
+  return 0;
+}
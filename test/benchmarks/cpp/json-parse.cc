@@ -0,0 +1,159 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "include/libplatform/libplatform.h"
+#include "include/v8-array-buffer.h"
+#include "include/v8-context.h"
+#include "include/v8-initialization.h"
+#include "include/v8-isolate.h"
+#include "include/v8-json.h"
+#include "include/v8-local-handle.h"
+#include "include/v8-primitive.h"
+#include "src/base/logging.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace {
+
+// Builds a document shaped like a typical API response: an array of records
+// with short keys, medium-sized string values, numbers, booleans and a nested
+// array. |indent| selects between compact and pretty-printed output, and
+// |two_byte| adds a non-Latin1 character to every description so that the
+// parser sees a two-byte source.
+std::string MakeJsonDocument(size_t records, bool indent, bool two_byte) {
+  const char* nl = indent ? "\n" : "";
+  const char* in1 = indent ? "  " : "";
+  const char* in2 = indent ? "    " : "";
+  const char* sp = indent ? " " : "";
+  std::string json = "[";
+  json += nl;
+  for (size_t i = 0; i < records; i++) {
+    std::string id = std::to_string(i);
+    json += in1;
+    json += "{";
+    json += nl;
+    json += in2 + std::string("\"id\":") + sp + id + "," + nl;
+    json += in2 + std::string("\"name\":") + sp + "\"user-" + id + "\"," + nl;
+    json += in2 + std::string("\"email\":") + sp + "\"user" + id +
+            "@example.com\"," + nl;
+    json += in2 + std::string("\"description\":") + sp +
+            "\"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed "
+            "do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
+            "Ut enim ad minim veniam, quis nostrud exercitation.";
+    json += two_byte ? "\xE2\x9C\x93" : "";
+    json += "\\n\"," + std::string(nl);
+    json += in2 + std::string("\"score\":") + sp + id + ".25," + nl;
+    json += in2 + std::string("\"active\":") + sp +
+            (i % 2 ? "true" : "false") + "," + nl;
+    json += in2 + std::string("\"tags\":") + sp +
+            "[\"alpha\",\"beta\",\"gamma\"]" + nl;
+    json += in1;
+    json += i + 1 < records ? "}," : "}";
+    json += nl;
+  }
+  json += "]";
+  return json;
+}
+
+class JsonParseBenchmark : public benchmark::Fixture {
+ public:
+  static void InitializeProcess(const char* argv0) {
+    v8::V8::InitializeICUDefaultLocation(argv0);
+    v8::V8::InitializeExternalStartupData(argv0);
+    platform_ = v8::platform::NewDefaultPlatform();
+    v8::V8::InitializePlatform(platform_.get());
+    v8::V8::Initialize();
+  }
+
+  static void ShutdownProcess() {
+    v8::V8::Dispose();
+    v8::V8::DisposePlatform();
+    platform_.reset();
+  }
+
+  void SetUp(::benchmark::State& state) override {
+    allocator_.reset(v8::ArrayBuffer::Allocator::NewDefaultAllocator());
+    v8::Isolate::CreateParams create_params;
+    create_params.array_buffer_allocator = allocator_.get();
+    isolate_ = v8::Isolate::New(create_params);
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    isolate_->Dispose();
+    isolate_ = nullptr;
+  }
+
+ protected:
+  void Run(::benchmark::State& state, bool indent, bool two_byte) {
+    std::string json = MakeJsonDocument(state.range(0), indent, two_byte);
+    v8::Isolate::Scope isolate_scope(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Context> context = v8::Context::New(isolate_);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::String> source =
+        v8::String::NewFromUtf8(isolate_, json.data(),
+                                v8::NewStringType::kNormal,
+                                static_cast<int>(json.size()))
+            .ToLocalChecked();
+    CHECK_EQ(two_byte, !source->IsOneByte());
+    for (auto _ : state) {
+      v8::HandleScope iteration_scope(isolate_);
+      v8::Local<v8::Value> result =
+          v8::JSON::Parse(context, source).ToLocalChecked();
+      benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            source->Length() *
+                            (two_byte ? sizeof(uint16_t) : sizeof(uint8_t)));
+  }
+
+ private:
+  static std::unique_ptr<v8::Platform> platform_;
+
+  std::unique_ptr<v8::ArrayBuffer::Allocator> allocator_;
+  v8::Isolate* isolate_ = nullptr;
+};
+
+std::unique_ptr<v8::Platform> JsonParseBenchmark::platform_;
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(JsonParseBenchmark, OneByteCompact)
+(benchmark::State& state) { Run(state, false, false); }
+BENCHMARK_DEFINE_F(JsonParseBenchmark, OneByteIndented)
+(benchmark::State& state) { Run(state, true, false); }
+BENCHMARK_DEFINE_F(JsonParseBenchmark, TwoByteCompact)
+(benchmark::State& state) { Run(state, false, true); }
+BENCHMARK_DEFINE_F(JsonParseBenchmark, TwoByteIndented)
+(benchmark::State& state) { Run(state, true, true); }
+
+// 1k records are roughly 300KB, 16k records roughly 5MB of JSON.
+BENCHMARK_REGISTER_F(JsonParseBenchmark, OneByteCompact)
+    ->Arg(1024)
+    ->Arg(16384);
+BENCHMARK_REGISTER_F(JsonParseBenchmark, OneByteIndented)
+    ->Arg(1024)
+    ->Arg(16384);
+BENCHMARK_REGISTER_F(JsonParseBenchmark, TwoByteCompact)
+    ->Arg(1024)
+    ->Arg(16384);
+BENCHMARK_REGISTER_F(JsonParseBenchmark, TwoByteIndented)
+    ->Arg(1024)
+    ->Arg(16384);
+
+// Expanded macro BENCHMARK_MAIN() to allow per-process setup.
+int main(int argc, char** argv) {
+  JsonParseBenchmark::InitializeProcess(argv[0]);
+  // Contents of BENCHMARK_MAIN().
+  {
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+  }
+  JsonParseBenchmark::ShutdownProcess();
+  return 0;
+}
@@ -38,6 +38,7 @@
   V(MarkCompactCollector)                                   \
   V(MarkCompactEpochCounter)                                \
   V(MemoryReducerActivationForSmallHeaps)                   \
+  V(NearHeapLimitCallbackCappedByCage)                      \
   V(NoPromotion)                                            \
   V(NumberStringCacheSize)                                  \
   V(ObjectGroups)                                           \
@@ -6587,6 +6587,61 @@ UNINITIALIZED_TEST(OutOfMemoryIneffectiveGCRunningJS) {
   FATAL("Should not get here as OOMCallback should be called");
 }
 
+#ifdef V8_COMPRESS_POINTERS
+void CageCappedOOMCallback(const char* location, const OOMDetails& details) {
+  CHECK(details.is_heap_oom);
+  CHECK_NOT_NULL(details.detail);
+  CHECK_EQ(0, strcmp(details.detail,
+                     "heap limit is capped by the pointer compression cage"));
+  base::OS::ExitProcess(0);
+}
+
+UNINITIALIZED_TEST(OutOfMemoryCappedByPointerCompressionCage) {
+  // Ask for an old generation as large as the whole cage, which is capped to
+  // what is left of the cage after the young generation and the isolate.
+  v8_flags.max_old_space_size = kPtrComprCageReservationSize / MB;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+  Heap* heap = i_isolate->heap();
+  CHECK_LT(heap->MaxOldGenerationSize(), kPtrComprCageReservationSize);
+
+  isolate->SetOOMErrorHandler(CageCappedOOMCallback);
+  // Filling the cage would take gigabytes, so fail the way the heap does once
+  // an allocation at the capped limit can't be satisfied.
+  heap->FatalProcessOutOfMemory("CALL_AND_RETRY_LAST");
+}
+
+size_t RaiseHeapLimitBeyondCage(void* data, size_t current_heap_limit,
+                                size_t initial_heap_limit) {
+  return 2 * kPtrComprCageReservationSize;
+}
+
+UNINITIALIZED_HEAP_TEST(NearHeapLimitCallbackCappedByCage) {
+  v8_flags.max_old_space_size = 64;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+  heap->AddNearHeapLimitCallback(RaiseHeapLimitBeyondCage, nullptr);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    // The first request raises the limit up to what the cage can hold.
+    CHECK(heap->InvokeNearHeapLimitCallback());
+    CHECK_EQ(heap->AllocatorLimitOnMaxOldGenerationSize(),
+             heap->max_old_generation_size());
+    // The limit cannot grow any further, so the heap is out of memory even
+    // though the callback asks for more.
+    CHECK(!heap->InvokeNearHeapLimitCallback());
+    CHECK_EQ(heap->AllocatorLimitOnMaxOldGenerationSize(),
+             heap->max_old_generation_size());
+  }
+  heap->RemoveNearHeapLimitCallback(RaiseHeapLimitBeyondCage, 0);
+  isolate->Dispose();
+}
+#endif  // V8_COMPRESS_POINTERS
+
 HEAP_TEST(Regress779503) {
   // The following regression test ensures that the Scavenger does not allocate
   // over invalid slots. More specific, the Scavenger should not sweep a page
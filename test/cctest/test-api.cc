@@ -47,6 +47,7 @@
 #include "include/v8-json.h"
 #include "include/v8-locker.h"
 #include "include/v8-primitive-object.h"
+#include "include/v8-profiler.h"
 #include "include/v8-regexp.h"
 #include "include/v8-util.h"
 #include "src/api/api-inl.h"
@@ -20780,6 +20781,78 @@ THREADED_TEST(JSONParseArray) {
                      i::PACKED_ELEMENTS);
 }
 
+namespace {
+class JSONParseThread : public v8::base::Thread {
+ public:
+  explicit JSONParseThread(v8::JSON::ParseTask* task)
+      : Thread(Options("JSONParseThread")), task_(task) {}
+
+  void Run() override { task_->Run(); }
+
+ private:
+  v8::JSON::ParseTask* task_;
+};
+
+void TestJSONBackgroundParse(Local<Context> context, const char* input_str,
+                             bool run_on_thread) {
+  v8::Isolate* isolate = context->GetIsolate();
+  Local<String> input = v8_str(input_str);
+  std::unique_ptr<v8::JSON::ParseTask> task =
+      v8::JSON::StartParse(isolate, input);
+  if (run_on_thread) {
+    JSONParseThread thread(task.get());
+    CHECK(thread.Start());
+    thread.Join();
+  } else {
+    task->Run();
+  }
+  Local<Value> obj =
+      v8::JSON::FinishParse(context, input, std::move(task)).ToLocalChecked();
+  Local<Value> expected = v8::JSON::Parse(context, input).ToLocalChecked();
+  Local<String> json = v8::JSON::Stringify(context, obj).ToLocalChecked();
+  Local<String> expected_json =
+      v8::JSON::Stringify(context, expected).ToLocalChecked();
+  CHECK(json->StrictEquals(expected_json));
+}
+}  // namespace
+
+THREADED_TEST(JSONBackgroundParse) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+
+  TestJSONBackgroundParse(context.local(), "42", false);
+  TestJSONBackgroundParse(context.local(), "-0.5e3", false);
+  TestJSONBackgroundParse(context.local(), "\"a\\u00e9\\n\\\"b\"", false);
+  TestJSONBackgroundParse(context.local(), "[1, 2.5, \"x\", true, null, []]",
+                          false);
+  TestJSONBackgroundParse(context.local(),
+                          "{\"a\": {}, \"1\": false, \"\\u0032\": [{\"b\": 1}, "
+                          "{\"b\": 2}], \"\\u20ac\": \"\\u20ac\"}",
+                          true);
+  TestJSONBackgroundParse(context.local(), " [ {\"x\" : 1} , {\"x\": 2} ] ",
+                          true);
+}
+
+THREADED_TEST(JSONBackgroundParseInvalid) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+
+  const char* inputs[] = {"", "[1,]", "{\"a\" 1}", "\"\\x\"", "\"\\u12\"",
+                          "\"abc", "01", "-", "1.", "1e+", "tru"};
+  for (const char* input_str : inputs) {
+    v8::TryCatch try_catch(isolate);
+    Local<String> input = v8_str(input_str);
+    std::unique_ptr<v8::JSON::ParseTask> task =
+        v8::JSON::StartParse(isolate, input);
+    task->Run();
+    CHECK(v8::JSON::FinishParse(context.local(), input, std::move(task))
+              .IsEmpty());
+    CHECK(try_catch.HasCaught());
+    CHECK(try_catch.Exception()->IsNativeError());
+  }
+}
+
 THREADED_TEST(JSONStringifyObject) {
   LocalContext context;
   HandleScope scope(context->GetIsolate());
@@ -20876,6 +20949,113 @@ void UnreachableCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
   UNREACHABLE();
 }
 
+namespace {
+class JSONTestOutputStream : public v8::OutputStream {
+ public:
+  explicit JSONTestOutputStream(int abort_after_chunks = -1)
+      : abort_after_chunks_(abort_after_chunks) {}
+
+  void EndOfStream() override { ended_ = true; }
+  int GetChunkSize() override { return 7; }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    CHECK(!ended_);
+    CHECK_LE(size, GetChunkSize());
+    output_.append(data, size);
+    return ++chunks_ == abort_after_chunks_ ? kAbort : kContinue;
+  }
+
+  const std::string& output() const { return output_; }
+  bool ended() const { return ended_; }
+
+ private:
+  const int abort_after_chunks_;
+  int chunks_ = 0;
+  bool ended_ = false;
+  std::string output_;
+};
+
+void TestJSONStringifyToStream(LocalContext* context, const char* source,
+                               const char* gap = nullptr) {
+  v8::Isolate* isolate = (*context)->GetIsolate();
+  Local<Value> value = CompileRun(source);
+  Local<String> gap_string = gap ? v8_str(gap) : Local<String>();
+  Local<String> expected =
+      v8::JSON::Stringify(context->local(), value, gap_string)
+          .ToLocalChecked();
+  JSONTestOutputStream stream;
+  CHECK(v8::JSON::StringifyToStream(context->local(), value, &stream,
+                                    gap_string)
+            .FromJust());
+  CHECK(stream.ended());
+  v8::String::Utf8Value utf8(isolate, expected);
+  CHECK_EQ(std::string(*utf8, utf8.length()), stream.output());
+}
+}  // namespace
+
+THREADED_TEST(JSONStringifyToStream) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+
+  TestJSONStringifyToStream(&context, "({x: 42, y: [1.5, 'a', null]})");
+  TestJSONStringifyToStream(&context, "({x: {y: [true, false]}})", "  ");
+  // Large enough to flush the internal buffer several times.
+  TestJSONStringifyToStream(&context,
+                            "Array.from({length: 5000}, (_, i) => ({i}))");
+  TestJSONStringifyToStream(&context, "'a'.repeat(100000)");
+  // Latin1, two-byte characters and surrogate pairs, also across flushes.
+  TestJSONStringifyToStream(&context,
+                            "['\\u00e9\\u20ac\\ud83d\\ude00'.repeat(5000),"
+                            " '\\ud800', '\\n\\u0001']");
+}
+
+THREADED_TEST(JSONStringifyToStreamUnchangedAndAbort) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+
+  JSONTestOutputStream unchanged_stream;
+  CHECK(!v8::JSON::StringifyToStream(context.local(),
+                                     v8::Undefined(context->GetIsolate()),
+                                     &unchanged_stream)
+             .FromJust());
+  CHECK(unchanged_stream.output().empty());
+  CHECK(!unchanged_stream.ended());
+
+  JSONTestOutputStream aborted_stream(3);
+  CHECK(v8::JSON::StringifyToStream(
+            context.local(), CompileRun("'x'.repeat(10000)"), &aborted_stream)
+            .FromJust());
+  CHECK_EQ(static_cast<size_t>(3 * aborted_stream.GetChunkSize()),
+           aborted_stream.output().size());
+  CHECK(!aborted_stream.ended());
+}
+
+THREADED_TEST(JSONStringifyToStreamStopsAfterAbort) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+
+  // Each element is about 100 characters long, so only a few dozen of them
+  // are serialized before the first chunk is written.
+  CompileRun(
+      "var calls = 0;"
+      "var element = {toJSON() { calls++; return 'x'.repeat(100); }};"
+      "var array = Array(10000).fill(element);"
+      "var object = {};"
+      "for (let i = 0; i < 10000; i++) {"
+      "  Object.defineProperty(object, 'p' + i, {"
+      "      enumerable: true,"
+      "      get() { calls++; return 'x'.repeat(100); }});"
+      "}");
+  for (const char* source : {"array", "object", "[[array]]"}) {
+    CompileRun("calls = 0");
+    JSONTestOutputStream stream(1);
+    CHECK(v8::JSON::StringifyToStream(context.local(), CompileRun(source),
+                                      &stream)
+              .FromJust());
+    CHECK(!stream.ended());
+    CHECK_GT(100, CompileRun("calls")->Int32Value(context.local()).FromJust());
+  }
+}
+
 TEST(JSONStringifyAccessCheck) {
   v8::Isolate* isolate = CcTest::isolate();
   v8::HandleScope scope(isolate);
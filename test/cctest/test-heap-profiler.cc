@@ -52,6 +52,10 @@
 #include "test/cctest/heap/heap-utils.h"
 #include "test/cctest/jsonstream-helper.h"
 
+#ifdef V8_USE_ZLIB
+#include "third_party/zlib/google/compression_utils_portable.h"
+#endif  // V8_USE_ZLIB
+
 using i::AllocationTraceNode;
 using i::AllocationTraceTree;
 using i::AllocationTracker;
@@ -1193,6 +1197,84 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+TEST(HeapSnapshotJSONSerializationParallel) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  // Create enough nodes and edges to fill several batches of row chunks.
+  CompileRun(
+      "var objects = [];\n"
+      "for (var i = 0; i < 300000; i++) objects.push({index: i});\n");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  i::v8_flags.heap_snapshot_parallel_serialization = false;
+  v8::internal::TestJSONStream sequential_stream;
+  snapshot->Serialize(&sequential_stream, v8::HeapSnapshot::kJSON);
+  i::v8_flags.heap_snapshot_parallel_serialization = true;
+  v8::internal::TestJSONStream parallel_stream;
+  snapshot->Serialize(&parallel_stream, v8::HeapSnapshot::kJSON);
+
+  CHECK_EQ(1, sequential_stream.eos_signaled());
+  CHECK_EQ(1, parallel_stream.eos_signaled());
+  CHECK_EQ(sequential_stream.size(), parallel_stream.size());
+  v8::base::ScopedVector<char> sequential_json(sequential_stream.size());
+  sequential_stream.WriteTo(sequential_json);
+  v8::base::ScopedVector<char> parallel_json(parallel_stream.size());
+  parallel_stream.WriteTo(parallel_json);
+  CHECK_EQ(0, memcmp(sequential_json.begin(), parallel_json.begin(),
+                     sequential_json.length()));
+}
+
+#ifdef V8_USE_ZLIB
+TEST(HeapSnapshotCompressedJSONSerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  v8::internal::TestJSONStream json_stream;
+  snapshot->Serialize(&json_stream, v8::HeapSnapshot::kJSON);
+  v8::internal::TestJSONStream compressed_stream;
+  snapshot->Serialize(&compressed_stream, v8::HeapSnapshot::kCompressedJSON);
+  CHECK_EQ(1, compressed_stream.eos_signaled());
+  CHECK_GT(compressed_stream.size(), 0);
+  CHECK_LT(compressed_stream.size(), json_stream.size());
+
+  // The output is a gzip stream of the uncompressed JSON.
+  v8::base::ScopedVector<char> compressed(compressed_stream.size());
+  compressed_stream.WriteTo(compressed);
+  CHECK_EQ(0x1F, static_cast<uint8_t>(compressed[0]));
+  CHECK_EQ(0x8B, static_cast<uint8_t>(compressed[1]));
+  v8::base::ScopedVector<char> json(json_stream.size());
+  json_stream.WriteTo(json);
+  // One more byte than expected, so that trailing output would be detected.
+  v8::base::ScopedVector<char> inflated(json.length() + 1);
+  uLongf inflated_size = static_cast<uLongf>(inflated.length());
+  CHECK_EQ(Z_OK,
+           zlib_internal::UncompressHelper(
+               zlib_internal::GZIP, reinterpret_cast<Bytef*>(inflated.begin()),
+               &inflated_size,
+               reinterpret_cast<const Bytef*>(compressed.begin()),
+               static_cast<uLong>(compressed.length())));
+  CHECK_EQ(static_cast<uLongf>(json.length()), inflated_size);
+  CHECK_EQ(0, memcmp(json.begin(), inflated.begin(), json.length()));
+}
+
+TEST(HeapSnapshotCompressedJSONSerializationAborting) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  v8::internal::TestJSONStream stream(5);
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kCompressedJSON);
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+}
+#endif  // V8_USE_ZLIB
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
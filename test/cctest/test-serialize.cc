@@ -61,6 +61,7 @@
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-utils.h"
 #include "test/cctest/setup-isolate-for-tests.h"
+#include "test/common/flag-utils.h"
 
 namespace v8 {
 namespace internal {
@@ -457,6 +458,35 @@ UNINITIALIZED_TEST(SnapshotCompression) {
 }
 #endif  // SNAPSHOT_COMPRESSION
 
+#ifdef V8_SNAPSHOT_COMPRESSION
+UNINITIALIZED_TEST(SnapshotCompressionChunks) {
+  DisableAlwaysOpt();
+  base::Vector<const uint8_t> startup_blob;
+  base::Vector<const uint8_t> read_only_blob;
+  base::Vector<const uint8_t> shared_space_blob;
+  base::Vector<const uint8_t> context_blob;
+  SerializeContext(&startup_blob, &read_only_blob, &shared_space_blob,
+                   &context_blob);
+  SnapshotData original_snapshot_data(startup_blob);
+  // Use small chunks so that the data is split into many of them.
+  FlagScope<int> chunk_size(&i::v8_flags.snapshot_compression_chunk_size, 4);
+  for (const char* codec : {"deflate", "store"}) {
+    FlagScope<const char*> codec_scope(
+        &i::v8_flags.snapshot_compression_codec, codec);
+    SnapshotData compressed =
+        i::SnapshotCompression::Compress(&original_snapshot_data);
+    SnapshotData decompressed =
+        i::SnapshotCompression::Decompress(compressed.RawData());
+    CHECK_EQ(startup_blob, decompressed.RawData());
+  }
+
+  startup_blob.Dispose();
+  read_only_blob.Dispose();
+  shared_space_blob.Dispose();
+  context_blob.Dispose();
+}
+#endif  // V8_SNAPSHOT_COMPRESSION
+
 UNINITIALIZED_TEST(ContextSerializerContext) {
   DisableAlwaysOpt();
   base::Vector<const uint8_t> startup_blob;
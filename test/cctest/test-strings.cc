@@ -32,6 +32,9 @@
 
 #include <stdlib.h>
 
+#include <string>
+#include <vector>
+
 #include "include/v8-json.h"
 #include "src/api/api-inl.h"
 #include "src/base/platform/elapsed-timer.h"
@@ -40,6 +43,7 @@
 #include "src/heap/factory.h"
 #include "src/heap/heap-inl.h"
 #include "src/objects/objects-inl.h"
+#include "src/strings/string-hasher-inl.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-utils.h"
 
@@ -1831,6 +1835,48 @@ TEST(HashArrayIndexStrings) {
   }
 }
 
+TEST(HashSequentialStringsBatch) {
+  const uint64_t seed = 0x1234567890abcdefull;
+  std::vector<std::string> keys = {"", "a", "id", "name", "0", "007", "123",
+                                   "4294967295", "9007199254740993", "key"};
+  for (int length : {15, 31, 32, 33, 64, 100, String::kMaxHashCalcLength + 1}) {
+    keys.push_back(std::string(length, 'x'));
+    keys.push_back(std::to_string(length) + std::string(length, '1'));
+  }
+  for (int i = 0; i < 50; i++) keys.push_back("property" + std::to_string(i));
+
+  const int count = static_cast<int>(keys.size());
+  std::vector<std::vector<uint16_t>> two_byte_keys;
+  std::vector<const uint8_t*> one_byte_chars;
+  std::vector<int> lengths;
+  for (const std::string& key : keys) {
+    two_byte_keys.emplace_back(key.begin(), key.end());
+    one_byte_chars.push_back(reinterpret_cast<const uint8_t*>(key.data()));
+    lengths.push_back(static_cast<int>(key.size()));
+  }
+  std::vector<const uint16_t*> two_byte_chars;
+  for (const std::vector<uint16_t>& key : two_byte_keys) {
+    two_byte_chars.push_back(key.data());
+  }
+
+  // Every prefix of the key list, so that strings that need the full hash
+  // computation show up at every position of an interleaved group.
+  for (int n = 0; n <= count; n++) {
+    std::vector<uint32_t> one_byte_hashes(n);
+    std::vector<uint32_t> two_byte_hashes(n);
+    StringHasher::HashSequentialStrings(one_byte_chars.data(), lengths.data(),
+                                        n, seed, one_byte_hashes.data());
+    StringHasher::HashSequentialStrings(two_byte_chars.data(), lengths.data(),
+                                        n, seed, two_byte_hashes.data());
+    for (int i = 0; i < n; i++) {
+      uint32_t expected = StringHasher::HashSequentialString(
+          one_byte_chars[i], lengths[i], seed);
+      CHECK_EQ(expected, one_byte_hashes[i]);
+      CHECK_EQ(expected, two_byte_hashes[i]);
+    }
+  }
+}
+
 TEST(StringEquals) {
   v8::Isolate* isolate = CcTest::isolate();
   v8::HandleScope scope(isolate);
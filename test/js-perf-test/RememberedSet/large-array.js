@@ -0,0 +1,50 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Stores young objects into an old array in the large object space. The
+// store benchmark is dominated by the generational write barrier, the sparse
+// benchmark by scavenges that process the remembered set of the array.
+
+const kLength = 256 * 1024;
+const kSparseStride = 64;
+const kSparseGarbage = 16 * 1024;
+
+let array;
+let sink;
+
+function Setup() {
+  array = [];
+  for (let i = 0; i < kLength; i++) array.push(0);
+  // Promote the array, it is allocated in the young large object space.
+  gc({type: 'minor'});
+  gc({type: 'minor'});
+}
+
+function TearDown() {
+  array = undefined;
+  sink = undefined;
+}
+
+function Store() {
+  for (let i = 0; i < kLength; i++) array[i] = {value: i};
+}
+
+function Sparse() {
+  for (let i = 0; i < kLength; i += kSparseStride) {
+    array[i] = {value: i};
+    // Short-lived garbage keeps the scavenger busy while the array holds
+    // young objects.
+    for (let j = 0; j < kSparseGarbage / kSparseStride; j++) {
+      sink = new Array(4);
+    }
+  }
+}
+
+var LargeArrayStoreBenchmark = new BenchmarkSuite('LargeArray-Store', [1000], [
+  new Benchmark('LargeArray-Store', false, false, 0, Store, Setup, TearDown),
+]);
+
+var LargeArraySparseBenchmark = new BenchmarkSuite('LargeArray-Sparse', [1000], [
+  new Benchmark('LargeArray-Sparse', false, false, 0, Sparse, Setup, TearDown),
+]);
@@ -0,0 +1,82 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tight numeric loops over typed arrays, as found in image and audio
+// processing code.
+
+const SIZE = 4096;
+let a;
+let b;
+let out;
+let result;
+
+function Float64Axpy() {
+  const alpha = 1.5;
+  for (let i = 0; i < a.length; i++) {
+    out[i] = alpha * a[i] + b[i];
+  }
+}
+
+function Float32Scale() {
+  for (let i = 0; i < a.length; i++) {
+    out[i] = a[i] * 0.5;
+  }
+}
+
+function Int32Sum() {
+  let sum = 0;
+  for (let i = 0; i < a.length; i++) {
+    sum = (sum + a[i]) | 0;
+  }
+  result = sum;
+}
+
+function Uint8Blend() {
+  for (let i = 0; i < a.length; i++) {
+    out[i] = (a[i] * 3 + b[i]) >> 2;
+  }
+}
+
+function CreateSetup(TAConstructor) {
+  return () => {
+    a = new TAConstructor(SIZE);
+    b = new TAConstructor(SIZE);
+    out = new TAConstructor(SIZE);
+    for (let i = 0; i < SIZE; i++) {
+      a[i] = i & 0xff;
+      b[i] = (SIZE - i) & 0xff;
+    }
+  };
+}
+
+function CreateTearDown(expected) {
+  return () => {
+    for (let i = 0; i < SIZE; i++) {
+      const value = expected(i & 0xff, (SIZE - i) & 0xff);
+      if (out[i] !== value) {
+        throw new TypeError(`Unexpected result at ${i}: ${out[i]}`);
+      }
+    }
+    a = b = out = void 0;
+  };
+}
+
+function Int32SumTearDown() {
+  let expected = 0;
+  for (let i = 0; i < SIZE; i++) expected = (expected + (i & 0xff)) | 0;
+  if (result !== expected) throw new TypeError(`Unexpected sum: ${result}`);
+  a = b = out = void 0;
+}
+
+createSuite(
+  'Float64Axpy', 1000, Float64Axpy, CreateSetup(Float64Array),
+  CreateTearDown((x, y) => 1.5 * x + y));
+createSuite(
+  'Float32Scale', 1000, Float32Scale, CreateSetup(Float32Array),
+  CreateTearDown((x, y) => x * 0.5));
+createSuite(
+  'Int32Sum', 1000, Int32Sum, CreateSetup(Int32Array), Int32SumTearDown);
+createSuite(
+  'Uint8Blend', 1000, Uint8Blend, CreateSetup(Uint8Array),
+  CreateTearDown((x, y) => (x * 3 + y) >> 2));
@@ -0,0 +1,41 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbofan --no-always-turbofan
+// Flags: --no-always-sparkplug --turboshaft --turboshaft-loop-vectorization
+// Flags: --turboshaft-trace-loop-vectorization
+
+function Optimize(kernel, ...args) {
+  %PrepareFunctionForOptimization(kernel);
+  kernel(...args);
+  %OptimizeFunctionOnNextCall(kernel);
+  kernel(...args);
+}
+
+function Float64Axpy(out, a, b) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = 1.5 * a[i] + b[i];
+  }
+}
+
+function Int8Add(out, a, b) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = a[i] + b[i];
+  }
+}
+
+// Math.sin has no Simd128 equivalent.
+function Float64Sin(out, a) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = Math.sin(a[i]);
+  }
+}
+
+print('Float64Axpy');
+Optimize(Float64Axpy, new Float64Array(16), new Float64Array(16),
+         new Float64Array(16));
+print('Int8Add');
+Optimize(Int8Add, new Int8Array(16), new Int8Array(16), new Int8Array(16));
+print('Float64Sin');
+Optimize(Float64Sin, new Float64Array(16), new Float64Array(16));
@@ -0,0 +1,136 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turboshaft --turboshaft-loop-peeling
+// Flags: --turboshaft-loop-unrolling
+
+// Trip counts around the unroll count of 4, including 0 and 1.
+const kTripCounts = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 100];
+
+function Optimize(f, ...args) {
+  %PrepareFunctionForOptimization(f);
+  f(...args);
+  f(...args);
+  %OptimizeFunctionOnNextCall(f);
+  f(...args);
+}
+
+// Values computed in the loop are used after it.
+(function TestValuesAfterLoop() {
+  function SumAndCount(n) {
+    let sum = 0;
+    let i = 0;
+    for (; i < n; i++) {
+      sum += i * 3;
+    }
+    return [sum, i];
+  }
+  Optimize(SumAndCount, 10);
+  for (const n of kTripCounts) {
+    assertEquals([3 * n * (n - 1) / 2, n], SumAndCount(n), `n = ${n}`);
+  }
+})();
+
+// Exits in the middle of the unrolled copies.
+(function TestEarlyExit() {
+  function IndexOf(array, value) {
+    for (let i = 0; i < array.length; i++) {
+      if (array[i] === value) return i;
+    }
+    return -1;
+  }
+  function FirstAbove(array, limit) {
+    let i = 0;
+    while (i < array.length) {
+      if (array[i] > limit) break;
+      i++;
+    }
+    return i;
+  }
+  const array = Array.from({length: 20}, (_, i) => i * 2);
+  Optimize(IndexOf, array, 10);
+  Optimize(FirstAbove, array, 10);
+  for (let i = 0; i < array.length; i++) {
+    assertEquals(i, IndexOf(array, i * 2));
+    assertEquals(i, FirstAbove(array, i * 2 - 1));
+  }
+  assertEquals(-1, IndexOf(array, 3));
+  assertEquals(array.length, FirstAbove(array, 100));
+  assertEquals(-1, IndexOf([], 0));
+  assertEquals(0, FirstAbove([], 0));
+})();
+
+// Loop-carried values of several iterations.
+(function TestTripCounts() {
+  function Fibonacci(n) {
+    let a = 0;
+    let b = 1;
+    for (let i = 0; i < n; i++) {
+      const c = a + b;
+      a = b;
+      b = c;
+    }
+    return a;
+  }
+  const expected = [0, 1];
+  for (let i = 2; i <= 100; i++) {
+    expected.push(expected[i - 1] + expected[i - 2]);
+  }
+  Optimize(Fibonacci, 10);
+  for (const n of kTripCounts) {
+    assertEquals(expected[n], Fibonacci(n), `n = ${n}`);
+  }
+  assertOptimized(Fibonacci);
+})();
+
+// Deoptimizes in each of the unrolled copies.
+(function TestDeoptInLoop() {
+  function Sum(array) {
+    let sum = 0;
+    for (let i = 0; i < array.length; i++) {
+      sum += array[i];
+    }
+    return sum;
+  }
+  for (let deopt_at = 0; deopt_at < 8; deopt_at++) {
+    const ints = [1, 2, 3, 4, 5, 6, 7, 8, 9];
+    Optimize(Sum, ints);
+    assertEquals(45, Sum(ints));
+    // A double element deoptimizes the Smi addition.
+    const mixed = ints.slice();
+    mixed[deopt_at] = 0.5;
+    assertEquals(45 - (deopt_at + 1) + 0.5, Sum(mixed), `at ${deopt_at}`);
+  }
+
+  function SumWithDeopt(n, deopt_at) {
+    let sum = 0;
+    for (let i = 0; i < n; i++) {
+      if (i === deopt_at) %DeoptimizeNow();
+      sum += i;
+    }
+    return sum;
+  }
+  for (let deopt_at = 0; deopt_at < 8; deopt_at++) {
+    Optimize(SumWithDeopt, 10, -1);
+    assertEquals(45, SumWithDeopt(10, deopt_at), `at ${deopt_at}`);
+  }
+})();
+
+// Interrupts requested in any iteration are handled by the check of the
+// unrolled loop.
+(function TestInterruptInLoop() {
+  function CountWithInterrupt(n, interrupt_at) {
+    let count = 0;
+    for (let i = 0; i < n; i++) {
+      if (i === interrupt_at) %ScheduleGCInStackCheck();
+      count++;
+    }
+    return count;
+  }
+  Optimize(CountWithInterrupt, 10, -1);
+  for (let interrupt_at = 0; interrupt_at < 8; interrupt_at++) {
+    assertEquals(1000, CountWithInterrupt(1000, interrupt_at));
+  }
+  assertOptimized(CountWithInterrupt);
+})();
@@ -0,0 +1,92 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turboshaft --turboshaft-loop-vectorization
+
+function Check(kernel, expected, out, ...inputs) {
+  %PrepareFunctionForOptimization(kernel);
+  kernel(out, ...inputs);
+  %OptimizeFunctionOnNextCall(kernel);
+  // A fresh output array, so that the results of the unoptimized call can't
+  // hide missing stores of the optimized one.
+  const optimized_out = new out.constructor(out.length);
+  kernel(optimized_out, ...inputs);
+  for (let i = 0; i < expected.length; i++) {
+    assertEquals(expected[i], optimized_out[i], `index ${i}`);
+  }
+}
+
+function Float64Axpy(out, a, b) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = 1.5 * a[i] + b[i];
+  }
+}
+
+function Float32Scale(out, a) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = a[i] * 0.5;
+  }
+}
+
+function Int8Add(out, a, b) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = a[i] + b[i];
+  }
+}
+
+function Int32Mul(out, a) {
+  for (let i = 0; i < out.length; i++) {
+    out[i] = Math.imul(a[i], a[i]) ^ 0x5555;
+  }
+}
+
+// Lengths that are not a multiple of the lane count, so that the scalar loop
+// executes the remaining iterations.
+for (const length of [0, 1, 3, 17, 1001]) {
+  const a = new Float64Array(length).map((_, i) => i / 3);
+  const b = new Float64Array(length).map((_, i) => length - i);
+  Check(Float64Axpy, a.map((x, i) => 1.5 * x + b[i]),
+        new Float64Array(length), a, b);
+
+  const c = new Float32Array(length).map((_, i) => i / 7);
+  Check(Float32Scale, c.map(x => Math.fround(x * 0.5)),
+        new Float32Array(length), c);
+
+  const d = new Uint8Array(length).map((_, i) => i * 7);
+  const e = new Int8Array(length).map((_, i) => -i);
+  Check(Int8Add, d.map((x, i) => x + e[i]), new Uint8Array(length), d, e);
+
+  const f = new Int32Array(length).map((_, i) => i * 0x10001);
+  Check(Int32Mul, f.map(x => Math.imul(x, x) ^ 0x5555),
+        new Int32Array(length), f);
+}
+
+// Overlapping views of the same buffer, for which each iteration reads the
+// result of the previous one.
+(function() {
+  function Expected(length, offset) {
+    const out = new Int32Array(length + offset).map((_, i) => i);
+    for (let i = 0; i < length; i++) out[i + offset] = out[i] + 1;
+    return out;
+  }
+  function Setup(length, offset) {
+    const buffer = new Int32Array(length + offset).map((_, i) => i).buffer;
+    const a = new Int32Array(buffer, 0, length);
+    const out = new Int32Array(buffer, offset * 4, length);
+    return [out, a, new Int32Array(length).fill(1)];
+  }
+  function Kernel(out, a, b) {
+    for (let i = 0; i < out.length; i++) {
+      out[i] = a[i] + b[i];
+    }
+  }
+  for (const offset of [0, 1, 3, 4, 5]) {
+    const [out, a, b] = Setup(64, offset);
+    %PrepareFunctionForOptimization(Kernel);
+    Kernel(new Int32Array(8), new Int32Array(8), new Int32Array(8));
+    %OptimizeFunctionOnNextCall(Kernel);
+    Kernel(out, a, b);
+    assertEquals(Expected(64, offset), new Int32Array(out.buffer));
+  }
+})();
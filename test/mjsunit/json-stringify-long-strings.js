@@ -0,0 +1,58 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Long strings are serialized in segments; make sure that characters that
+// need escaping and surrogate pairs are handled at every position.
+
+function Escape(c) {
+  switch (c) {
+    case '"': return '\\"';
+    case '\\': return '\\\\';
+    case '\b': return '\\b';
+    case '\f': return '\\f';
+    case '\n': return '\\n';
+    case '\r': return '\\r';
+    case '\t': return '\\t';
+  }
+  let code = c.charCodeAt(0);
+  if (code < 0x20 || (code >= 0xD800 && code <= 0xDFFF)) {
+    return '\\u' + code.toString(16).padStart(4, '0');
+  }
+  return c;
+}
+
+function Expected(str) {
+  let result = '"';
+  for (let i = 0; i < str.length; i++) {
+    let code = str.charCodeAt(i);
+    if (code >= 0xD800 && code <= 0xDBFF && i + 1 < str.length) {
+      let next = str.charCodeAt(i + 1);
+      if (next >= 0xDC00 && next <= 0xDFFF) {
+        result += str[i] + str[i + 1];
+        i++;
+        continue;
+      }
+    }
+    result += Escape(str[i]);
+  }
+  return result + '"';
+}
+
+const kSpecial = ['"', '\\', '\n', '\x01', '\x7f', '\xff', ' ',
+                  '😀', '\uD83D', '\uDE00'];
+
+for (let length of [15, 16, 17, 100, 20000, 70000]) {
+  let plain = 'a'.repeat(length);
+  assertEquals('"' + plain + '"', JSON.stringify(plain));
+  for (let special of kSpecial) {
+    for (let position of [0, 1, 15, length >> 1, length - 1]) {
+      let str = plain.substring(0, position) + special +
+                plain.substring(position);
+      assertEquals(Expected(str), JSON.stringify(str));
+      assertEquals([str], JSON.parse(JSON.stringify([str])));
+    }
+    let repeated = special.repeat(length / special.length);
+    assertEquals(Expected(repeated), JSON.stringify(repeated));
+  }
+}
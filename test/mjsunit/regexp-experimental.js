@@ -96,3 +96,16 @@ Test(/x$/m, "x\na", ["x"], 0);
 
 // The dotall flag.
 Test(/asdf.xyz/s,  "asdf\nxyz", ["asdf\nxyz"], 0);
+
+// The ignore case flag.
+Test(/asdf/i, "xyzASdF", ["ASdF"], 0);
+Test(/[a-c]x/i, "XbX", ["bX"], 0);
+Test(/[^a-c]/i, "ABCd", ["d"], 0);
+Test(/\w+/i, "--aB1_--", ["aB1_"], 0);
+Test(/(ä)(ö+)/i, "xÄöÖ", ["ÄöÖ", "Ä", "öÖ"], 0);
+Test(/σ/i, "Σ", ["Σ"], 0);
+
+// Character classes with many ranges.
+Test(/[aceg]+/, "xaceggb", ["acegg"], 0);
+Test(/[^aceg]+/, "aceXYZg", ["XYZ"], 0);
+Test(/(?:[ab]|[bc])+c/, "xabcbc", ["abcbc"], 0);
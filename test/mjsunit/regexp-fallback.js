@@ -24,14 +24,40 @@ regexp = new RegExp(regexp.source, "g");
 assertEquals("", subject.replace(regexp, function () { return ""; }));
 assertEquals("", subject.replace(regexp, function () { return ""; }));
 
+// Case-insensitive patterns fall back as well.
+regexp = new RegExp(regexp.source, "i");
+assertArrayEquals([match.toUpperCase()], regexp.exec(subject.toUpperCase()));
+assertArrayEquals([match.toUpperCase()], regexp.exec(subject.toUpperCase()));
+
 // If an explicit backtrack limit is larger than the default, then we should
 // take the default limit.
 regexp = %NewRegExpWithBacktrackLimit(regexp.source, "", 1000000000)
 assertArrayEquals([match], regexp.exec(subject));
 assertArrayEquals([match], regexp.exec(subject));
 
+// Case-insensitive character classes with several ranges fall back on an
+// explicit backtrack limit, too.
+let class_source = "[a-cx-z]+".repeat(100) + "!";
+let class_match = "aXz".repeat(100) + "!";
+let class_regexp = %NewRegExpWithBacktrackLimit(class_source, "i", 100)
+assertArrayEquals([class_match], class_regexp.exec(class_match.repeat(3)));
+assertArrayEquals([class_match], class_regexp.exec(class_match.repeat(3)));
+class_regexp =
+    %NewRegExpWithBacktrackLimit("[^!]+".repeat(100) + "!", "i", 100)
+assertArrayEquals([class_match], class_regexp.exec(class_match.repeat(3)));
+
 // If the experimental engine can't handle a regexp with an explicit backtrack
 // limit, we should abort and return null on excessive backtracking.
 regexp = %NewRegExpWithBacktrackLimit(regexp.source + "(?=a)", "", 100)
 assertEquals(null, regexp.exec(subject));
 assertEquals(null, regexp.exec(subject));
+
+// Lookaheads and the unicode flags are not supported by the experimental
+// engine yet.
+regexp = %NewRegExpWithBacktrackLimit("(?=a)" + "a+".repeat(100) + "x", "",
+                                      100)
+assertEquals(null, regexp.exec(subject));
+regexp = %NewRegExpWithBacktrackLimit("a+".repeat(100) + "x", "iu", 100)
+assertEquals(null, regexp.exec(subject));
+regexp = %NewRegExpWithBacktrackLimit("a+".repeat(100) + "x", "v", 100)
+assertEquals(null, regexp.exec(subject));
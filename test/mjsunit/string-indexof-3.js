@@ -0,0 +1,81 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Patterns of up to 64 characters are searched for a block of subject
+// positions at a time. Check matches around block boundaries, candidates that
+// only match the first and last character, and the scalar tail.
+
+function NaiveIndexOf(subject, pattern, start) {
+  outer: for (let i = start; i <= subject.length - pattern.length; i++) {
+    for (let j = 0; j < pattern.length; j++) {
+      if (subject[j + i] !== pattern[j]) continue outer;
+    }
+    return i;
+  }
+  return -1;
+}
+
+function MakePattern(length, filler) {
+  // Same first and last character as the decoys below, different middle.
+  return 'x' + filler.repeat(length - 2) + 'y';
+}
+
+function Check(subject, pattern) {
+  for (let start of [0, 1, 15, 16, 17, 31, 32, 33]) {
+    assertEquals(NaiveIndexOf(subject, pattern, start),
+                 subject.indexOf(pattern, start));
+  }
+  assertEquals(NaiveIndexOf(subject, pattern, 0) != -1,
+               subject.includes(pattern));
+}
+
+for (let two_byte of [false, true]) {
+  const filler = two_byte ? '☃' : 'b';
+  for (let length = 2; length <= 65; length++) {
+    const pattern = MakePattern(length, filler);
+    // A decoy has the right first and last character only, or just the right
+    // first character for two-character patterns.
+    const decoy = length > 2 ? 'x' + 'c'.repeat(length - 2) + 'y' : 'xx';
+    for (let position of [0, 1, 14, 15, 16, 17, 31, 32, 33, 40, 70]) {
+      const subject =
+          'a'.repeat(position) + decoy + pattern + 'a'.repeat(length % 7);
+      Check(subject, pattern);
+      Check(subject.slice(0, -1), pattern);
+      Check('a'.repeat(position) + decoy, pattern);
+    }
+    // Many false candidates.
+    const decoys = (decoy + 'a').repeat(40);
+    Check(decoys + pattern, pattern);
+    assertEquals(2, (decoys + pattern + decoys).split(pattern).length);
+    assertEquals(41, decoys.split(decoy).length);
+    assertEquals('-'.repeat(3),
+                 (pattern + pattern + pattern).replaceAll(pattern, '-'));
+  }
+}
+
+// Sparse false candidates over a long subject, some of which share a long
+// prefix with the pattern. The search may switch to Boyer-Moore-Horspool on
+// the way, and has to find the same matches either way.
+for (let two_byte of [false, true]) {
+  const filler = two_byte ? '☃' : 'b';
+  for (let length of [2, 7, 8, 16, 33, 64]) {
+    const pattern = MakePattern(length, filler);
+    const near_miss = length > 2 ? pattern.slice(0, -2) + 'cy' : 'xx';
+    for (let gap of [1, 15, 40, 100, 1000]) {
+      const piece = near_miss + 'a'.repeat(gap);
+      const prefix = piece.repeat(Math.ceil(2000 / gap) + 10);
+      const subject = prefix + pattern + piece;
+      assertEquals(prefix.length, subject.indexOf(pattern));
+      assertEquals(prefix.length, subject.indexOf(pattern, 100));
+      assertEquals(-1, subject.indexOf(pattern, prefix.length + 1));
+      assertTrue(subject.includes(pattern));
+      assertFalse(prefix.includes(pattern));
+    }
+  }
+}
+
+// Two-byte patterns cannot occur in one-byte subjects.
+assertEquals(-1, 'abcdefghijklmnop'.repeat(4).indexOf('ab☃'));
+assertEquals(19, ('ab☃' + 'a'.repeat(13) + 'abc' + 'abcdefghijklmnop')
+                     .indexOf('abcdefghijklmnop'));
@@ -9,7 +9,12 @@
 #include "include/v8-platform.h"
 #include "include/v8-primitive.h"
 #include "include/v8-script.h"
+#include "src/baseline/baseline.h"
 #include "src/codegen/compilation-cache.h"
+#include "src/execution/tiering-manager.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/shared-function-info-inl.h"
+#include "test/common/flag-utils.h"
 #include "test/unittests/heap/heap-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -58,6 +63,51 @@ class DeserializeTest : public TestWithPlatform {
         .ToLocalChecked();
   }
 
+  i::Handle<i::JSFunction> GlobalFunc(const char* name) {
+    Local<Value> func =
+        context()->Global()->Get(context(), NewString(name)).ToLocalChecked();
+    return i::Handle<i::JSFunction>::cast(Utils::OpenHandle(*func));
+  }
+
+  i::SharedFunctionInfo GlobalFuncShared(const char* name) {
+    return GlobalFunc(name)->shared();
+  }
+
+  // Runs |source| in a fresh isolate, sets the cached tiering decision of its
+  // function foo to |decision| and returns the code cache of the script.
+  std::unique_ptr<ScriptCompiler::CachedData> CreateCodeCacheWithDecision(
+      const char* source, i::CachedTieringDecision decision,
+      bool feedback_unstable = false) {
+    IsolateAndContextScope scope(this);
+
+    Local<Script> script =
+        Script::Compile(context(), NewString(source)).ToLocalChecked();
+
+    CHECK(!script->Run(context()).IsEmpty());
+    CHECK_EQ(RunGlobalFunc("foo"), Integer::New(isolate(), 42));
+    GlobalFuncShared("foo")->set_cached_tiering_decision(decision);
+    GlobalFuncShared("foo")->set_cached_feedback_unstable(feedback_unstable);
+
+    return std::unique_ptr<ScriptCompiler::CachedData>(
+        ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+  }
+
+  // Compiles |source| with |cached_data| in the current isolate, checks that
+  // the cache is accepted and runs the script.
+  void RunWithCodeCache(
+      const char* source,
+      std::unique_ptr<ScriptCompiler::CachedData> cached_data) {
+    ScriptCompiler::Source script_source(NewString(source),
+                                         cached_data.release());
+    Local<Script> script =
+        ScriptCompiler::Compile(context(), &script_source,
+                                ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+
+    CHECK(!script_source.GetCachedData()->rejected);
+    CHECK(!script->Run(context()).IsEmpty());
+  }
+
   Isolate* isolate() { return isolate_; }
   v8::Local<v8::Context> context() { return context_.ToLocalChecked(); }
 
@@ -137,6 +187,180 @@ TEST_F(DeserializeTest, DeserializeRejectsDifferentSource) {
   }
 }
 
+// Check that cached tiering decisions survive the code cache.
+TEST_F(DeserializeTest, DeserializeKeepsCachedTieringDecision) {
+  i::FlagScope<bool> flag_scope(&i::v8_flags.profile_guided_optimization,
+                                true);
+  const char* source = "function foo() { return 42; }";
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data =
+      CreateCodeCacheWithDecision(source,
+                                  i::CachedTieringDecision::kEarlyTurbofan);
+
+  {
+    IsolateAndContextScope scope(this);
+
+    RunWithCodeCache(source, std::move(cached_data));
+    CHECK_EQ(i::CachedTieringDecision::kEarlyTurbofan,
+             GlobalFuncShared("foo")->cached_tiering_decision());
+  }
+}
+
+// Check that new closures of a function with a cached tiering decision tier up
+// with a reduced interrupt budget.
+TEST_F(DeserializeTest, CachedTieringDecisionReducesInterruptBudget) {
+  i::FlagScope<bool> flag_scope(&i::v8_flags.profile_guided_optimization,
+                                true);
+  // Without Sparkplug, the budget only depends on the feedback vector and the
+  // cached tiering decision.
+  i::FlagScope<bool> sparkplug_scope(&i::v8_flags.sparkplug, false);
+  const char* source = "function foo() { return 42; }";
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data =
+      CreateCodeCacheWithDecision(source,
+                                  i::CachedTieringDecision::kEarlyTurbofan);
+
+  {
+    IsolateAndContextScope scope(this);
+
+    RunWithCodeCache(source, std::move(cached_data));
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate());
+    i::Handle<i::JSFunction> function = GlobalFunc("foo");
+    const int bytecode_length =
+        function->shared()->GetBytecodeArray(i_isolate)->length();
+
+    // The feedback vector is allocated on the first tick.
+    CHECK(!function->has_feedback_vector());
+    CHECK_EQ(bytecode_length,
+             i::TieringManager::InterruptBudgetFor(i_isolate, *function));
+
+    i::IsCompiledScope is_compiled_scope(
+        function->shared()->is_compiled_scope(i_isolate));
+    i::JSFunction::EnsureFeedbackVector(i_isolate, function,
+                                        &is_compiled_scope);
+    const int early_budget =
+        i::v8_flags.invocation_count_for_early_optimization * bytecode_length;
+    CHECK_EQ(early_budget,
+             i::TieringManager::InterruptBudgetFor(i_isolate, *function));
+
+    // Without the decision, the function tiers up at the regular budget.
+    function->shared()->set_cached_tiering_decision(
+        i::CachedTieringDecision::kPending);
+    CHECK_LT(early_budget,
+             i::TieringManager::InterruptBudgetFor(i_isolate, *function));
+  }
+}
+
+// Check that functions whose optimized code deoptimized before don't tier up
+// early, but keep the rest of their cached tiering decision.
+TEST_F(DeserializeTest, CachedUnstableFeedbackPreventsEarlyTierUp) {
+  i::FlagScope<bool> flag_scope(&i::v8_flags.profile_guided_optimization,
+                                true);
+  i::FlagScope<bool> sparkplug_scope(&i::v8_flags.sparkplug, false);
+  const char* source = "function foo() { return 42; }";
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data =
+      CreateCodeCacheWithDecision(
+          source, i::CachedTieringDecision::kEarlyTurbofan, true);
+
+  {
+    IsolateAndContextScope scope(this);
+
+    RunWithCodeCache(source, std::move(cached_data));
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate());
+    i::Handle<i::JSFunction> function = GlobalFunc("foo");
+    CHECK(function->shared()->cached_feedback_unstable());
+    CHECK_EQ(i::CachedTieringDecision::kEarlyTurbofan,
+             function->shared()->cached_tiering_decision());
+    const int bytecode_length =
+        function->shared()->GetBytecodeArray(i_isolate)->length();
+
+    // The feedback vector is still allocated on the first tick.
+    CHECK(!function->has_feedback_vector());
+    CHECK_EQ(bytecode_length,
+             i::TieringManager::InterruptBudgetFor(i_isolate, *function));
+
+    i::IsCompiledScope is_compiled_scope(
+        function->shared()->is_compiled_scope(i_isolate));
+    i::JSFunction::EnsureFeedbackVector(i_isolate, function,
+                                        &is_compiled_scope);
+    const int unstable_budget =
+        i::TieringManager::InterruptBudgetFor(i_isolate, *function);
+    CHECK_LT(i::v8_flags.invocation_count_for_early_optimization *
+                 bytecode_length,
+             unstable_budget);
+
+    // Without the summary bit, the function tiers up early.
+    function->shared()->set_cached_feedback_unstable(false);
+    CHECK_GT(unstable_budget,
+             i::TieringManager::InterruptBudgetFor(i_isolate, *function));
+  }
+}
+
+// Check that an eager deopt records the unstable feedback.
+TEST_F(DeserializeTest, DeoptRecordsUnstableFeedback) {
+  if (!i::v8_flags.turbofan || i::v8_flags.jitless) {
+    GTEST_SKIP() << "Turbofan is not available";
+  }
+  i::FlagScope<bool> flag_scope(&i::v8_flags.profile_guided_optimization,
+                                true);
+  i::FlagScope<bool> natives_scope(&i::v8_flags.allow_natives_syntax, true);
+  IsolateAndContextScope scope(this);
+
+  Local<Script> script =
+      Script::Compile(context(), NewString(R"(
+        function foo(x) { return x + 1; }
+        %PrepareFunctionForOptimization(foo);
+        foo(1);
+        foo(2);
+        %OptimizeFunctionOnNextCall(foo);
+        foo(3);
+      )"))
+          .ToLocalChecked();
+  CHECK(!script->Run(context()).IsEmpty());
+  i::Handle<i::JSFunction> function = GlobalFunc("foo");
+  CHECK(!function->shared()->cached_feedback_unstable());
+
+  // A string argument fails the Smi check of the optimized code.
+  CHECK(!Script::Compile(context(), NewString("foo('a')"))
+             .ToLocalChecked()
+             ->Run(context())
+             .IsEmpty());
+  CHECK(function->shared()->cached_feedback_unstable());
+}
+
+// Check that functions that were optimized before are compiled with Sparkplug
+// on their first calls after their code cache is loaded, and not while it is
+// deserialized.
+TEST_F(DeserializeTest, HotFunctionsCompileWithBaselineOnFirstCalls) {
+  i::FlagScope<bool> flag_scope(&i::v8_flags.profile_guided_optimization,
+                                true);
+  i::FlagScope<bool> sparkplug_scope(&i::v8_flags.sparkplug, true);
+  i::FlagScope<bool> batch_compilation_scope(
+      &i::v8_flags.baseline_batch_compilation, false);
+  const char* source = "function foo() { return 42; }";
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data =
+      CreateCodeCacheWithDecision(source,
+                                  i::CachedTieringDecision::kEarlyMaglev);
+
+  {
+    IsolateAndContextScope scope(this);
+
+    RunWithCodeCache(source, std::move(cached_data));
+    if (!i::CanCompileWithBaseline(reinterpret_cast<i::Isolate*>(isolate()),
+                                   GlobalFuncShared("foo"))) {
+      GTEST_SKIP() << "Sparkplug is not available";
+    }
+    CHECK(!GlobalFuncShared("foo")->HasBaselineCode());
+
+    // The first interrupt tick comes after about one invocation, well before
+    // the regular --invocation-count-for-feedback-allocation.
+    constexpr int kCalls = 3;
+    CHECK_LT(kCalls, i::v8_flags.invocation_count_for_feedback_allocation);
+    for (int i = 0; i < kCalls; i++) {
+      CHECK_EQ(RunGlobalFunc("foo"), Integer::New(isolate(), 42));
+    }
+    CHECK(GlobalFuncShared("foo")->HasBaselineCode());
+  }
+}
+
 class DeserializeThread : public base::Thread {
  public:
   explicit DeserializeThread(ScriptCompiler::ConsumeCodeCacheTask* task)
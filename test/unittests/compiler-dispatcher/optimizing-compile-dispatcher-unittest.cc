@@ -13,8 +13,10 @@
 #include "src/execution/local-isolate.h"
 #include "src/handles/handles.h"
 #include "src/heap/local-heap.h"
+#include "src/objects/js-function-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/parsing/parse-info.h"
+#include "test/common/flag-utils.h"
 #include "test/unittests/test-helpers.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -63,6 +65,42 @@ class BlockingCompilationJob : public TurbofanCompilationJob {
   base::Semaphore semaphore_;
 };
 
+// Appends its id to a list of executed jobs.
+class RecordingCompilationJob : public TurbofanCompilationJob {
+ public:
+  RecordingCompilationJob(Isolate* isolate, Handle<JSFunction> function,
+                          int id, std::vector<int>* executed,
+                          base::Mutex* executed_mutex)
+      : TurbofanCompilationJob(&info_, State::kReadyToExecute),
+        shared_(function->shared(), isolate),
+        zone_(isolate->allocator(), ZONE_NAME),
+        info_(&zone_, isolate, shared_, function, CodeKind::TURBOFAN),
+        id_(id),
+        executed_(executed),
+        executed_mutex_(executed_mutex) {}
+  RecordingCompilationJob(const RecordingCompilationJob&) = delete;
+  RecordingCompilationJob& operator=(const RecordingCompilationJob&) = delete;
+
+  Status PrepareJobImpl(Isolate* isolate) override { UNREACHABLE(); }
+
+  Status ExecuteJobImpl(RuntimeCallStats* stats,
+                        LocalIsolate* local_isolate) override {
+    base::MutexGuard guard(executed_mutex_);
+    executed_->push_back(id_);
+    return SUCCEEDED;
+  }
+
+  Status FinalizeJobImpl(Isolate* isolate) override { return SUCCEEDED; }
+
+ private:
+  Handle<SharedFunctionInfo> shared_;
+  Zone zone_;
+  OptimizedCompilationInfo info_;
+  const int id_;
+  std::vector<int>* const executed_;
+  base::Mutex* const executed_mutex_;
+};
+
 }  // namespace
 
 TEST_F(OptimizingCompileDispatcherTest, Construct) {
@@ -96,5 +134,83 @@ TEST_F(OptimizingCompileDispatcherTest, NonBlockingFlush) {
   dispatcher.Stop();
 }
 
+TEST_F(OptimizingCompileDispatcherTest, HotJobsFirst) {
+  FlagScope<unsigned int> max_threads(&v8_flags.concurrent_turbofan_max_threads,
+                                      1);
+  FlagScope<bool> prioritize_hot(
+      &v8_flags.concurrent_recompilation_prioritize_hot, true);
+  Handle<JSFunction> fun =
+      RunJS<JSFunction>("function f() { function g() {}; return g;}; f();");
+  IsCompiledScope is_compiled_scope;
+  ASSERT_TRUE(Compiler::Compile(i_isolate(), fun, Compiler::CLEAR_EXCEPTION,
+                                &is_compiled_scope));
+  JSFunction::EnsureFeedbackVector(i_isolate(), fun, &is_compiled_scope);
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  BlockingCompilationJob* blocking_job =
+      new BlockingCompilationJob(i_isolate(), fun);
+  dispatcher.QueueForOptimization(blocking_job);
+  // Busy-wait for the only worker to block on the first job.
+  while (!blocking_job->IsBlocking()) {
+  }
+
+  std::vector<int> executed;
+  base::Mutex executed_mutex;
+  fun->feedback_vector()->set_invocation_count(1, kRelaxedStore);
+  dispatcher.QueueForOptimization(new RecordingCompilationJob(
+      i_isolate(), fun, 1, &executed, &executed_mutex));
+  fun->feedback_vector()->set_invocation_count(100, kRelaxedStore);
+  dispatcher.QueueForOptimization(new RecordingCompilationJob(
+      i_isolate(), fun, 2, &executed, &executed_mutex));
+  EXPECT_EQ(2, dispatcher.InputQueueLength());
+
+  blocking_job->Signal();
+  while (dispatcher.InputQueueLength() > 0) {
+  }
+  dispatcher.AwaitCompileTasks();
+  {
+    base::MutexGuard guard(&executed_mutex);
+    EXPECT_EQ((std::vector<int>{2, 1}), executed);
+  }
+  dispatcher.Stop();
+}
+
+TEST_F(OptimizingCompileDispatcherTest, CancelStaleJobs) {
+  FlagScope<unsigned int> max_threads(&v8_flags.concurrent_turbofan_max_threads,
+                                      1);
+  Handle<JSFunction> fun =
+      RunJS<JSFunction>("function f() { function g() {}; return g;}; f();");
+  IsCompiledScope is_compiled_scope;
+  ASSERT_TRUE(Compiler::Compile(i_isolate(), fun, Compiler::CLEAR_EXCEPTION,
+                                &is_compiled_scope));
+  JSFunction::EnsureFeedbackVector(i_isolate(), fun, &is_compiled_scope);
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  BlockingCompilationJob* blocking_job =
+      new BlockingCompilationJob(i_isolate(), fun);
+  dispatcher.QueueForOptimization(blocking_job);
+  while (!blocking_job->IsBlocking()) {
+  }
+
+  std::vector<int> executed;
+  base::Mutex executed_mutex;
+  dispatcher.QueueForOptimization(new RecordingCompilationJob(
+      i_isolate(), fun, 1, &executed, &executed_mutex));
+  // The tiering request is still in progress, so the job is kept.
+  fun->set_tiering_state(TieringState::kInProgress);
+  dispatcher.CancelStaleJobs();
+  EXPECT_EQ(1, dispatcher.InputQueueLength());
+
+  // Resetting the request, e.g. on deoptimization, makes the job stale.
+  fun->reset_tiering_state();
+  dispatcher.CancelStaleJobs();
+  EXPECT_EQ(0, dispatcher.InputQueueLength());
+
+  blocking_job->Signal();
+  dispatcher.Stop();
+  base::MutexGuard guard(&executed_mutex);
+  EXPECT_TRUE(executed.empty());
+}
+
 }  // namespace internal
 }  // namespace v8
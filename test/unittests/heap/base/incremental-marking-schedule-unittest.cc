@@ -145,4 +145,26 @@ TEST_F(IncrementalMarkingScheduleTest, GetCurrentStepInfo) {
   EXPECT_NE(step_info.scheduled_delta_bytes(), 0);
 }
 
+TEST_F(IncrementalMarkingScheduleTest, PauseTargetLimitsStepSize) {
+  auto schedule =
+      IncrementalMarkingSchedule::CreateWithDefaultMinimumMarkedBytesPerStep();
+  schedule->NotifyIncrementalMarkingStart();
+  // 2ms at 10KB/ms allow for 20KB per step.
+  schedule->SetPauseTarget(v8::base::TimeDelta::FromMilliseconds(2),
+                           10 * 1024);
+  schedule->UpdateMutatorThreadMarkedBytes(0.1 * kEstimatedLiveSize);
+  schedule->SetElapsedTimeForTesting(kHalfEstimatedMarkingTime);
+  EXPECT_EQ(20u * 1024,
+            schedule->GetNextIncrementalStepDuration(kEstimatedLiveSize));
+  EXPECT_TRUE(schedule->GetCurrentStepInfo().limited_by_pause_target);
+  EXPECT_TRUE(schedule->GetCurrentStepInfo().is_behind_expectation());
+  // Removing the target restores the regular schedule.
+  schedule->SetPauseTarget(v8::base::TimeDelta(), 10 * 1024);
+  schedule->UpdateMutatorThreadMarkedBytes(0.2 * kEstimatedLiveSize);
+  schedule->SetElapsedTimeForTesting(kHalfEstimatedMarkingTime);
+  EXPECT_EQ(0.3 * kEstimatedLiveSize,
+            schedule->GetNextIncrementalStepDuration(kEstimatedLiveSize));
+  EXPECT_FALSE(schedule->GetCurrentStepInfo().limited_by_pause_target);
+}
+
 }  // namespace heap::base
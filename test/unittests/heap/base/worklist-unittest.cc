@@ -330,5 +330,71 @@ TEST(WorkListTest, MergeGlobalPool) {
   EXPECT_TRUE(worklist2.IsEmpty());
 }
 
+TEST(WorkListTest, WorkStealingAcrossStacks) {
+  TestWorklist worklist(4);
+  EXPECT_EQ(4U, worklist.NumStacks());
+  TestWorklist::Local worklist_local1(worklist);
+  TestWorklist::Local worklist_local2(worklist);
+  SomeObject dummy;
+  for (size_t i = 0; i < 2 * TestWorklist::kMinSegmentSize; i++) {
+    worklist_local1.Push(&dummy);
+  }
+  worklist_local1.Publish();
+  EXPECT_FALSE(worklist.IsEmpty());
+  // The second view publishes to a different stack and has to steal all
+  // segments from the stack of the first view.
+  SomeObject* retrieved = nullptr;
+  for (size_t i = 0; i < 2 * TestWorklist::kMinSegmentSize; i++) {
+    EXPECT_TRUE(worklist_local2.Pop(&retrieved));
+    EXPECT_EQ(&dummy, retrieved);
+  }
+  EXPECT_FALSE(worklist_local2.Pop(&retrieved));
+  EXPECT_FALSE(worklist_local1.Pop(&retrieved));
+  EXPECT_TRUE(worklist.IsEmpty());
+}
+
+TEST(WorkListTest, WorkStealingUpdateAndIterate) {
+  TestWorklist worklist(4);
+  SomeObject objects[4];
+  for (SomeObject& object : objects) {
+    TestWorklist::Local worklist_local(worklist);
+    worklist_local.Push(&object);
+    worklist_local.Publish();
+  }
+  EXPECT_EQ(4U, worklist.Size());
+  size_t count = 0;
+  worklist.Iterate([&count](SomeObject*) { count++; });
+  EXPECT_EQ(4U, count);
+  worklist.Update([&objects](SomeObject* object, SomeObject** out) {
+    if (object == &objects[0]) return false;
+    *out = object;
+    return true;
+  });
+  EXPECT_EQ(3U, worklist.Size());
+  worklist.Clear();
+  EXPECT_TRUE(worklist.IsEmpty());
+}
+
+TEST(WorkListTest, MergeIntoFewerStacks) {
+  TestWorklist worklist1(4);
+  SomeObject dummy;
+  for (int i = 0; i < 4; i++) {
+    TestWorklist::Local worklist_local(worklist1);
+    worklist_local.Push(&dummy);
+    worklist_local.Publish();
+  }
+  TestWorklist worklist2(1);
+  worklist2.Merge(worklist1);
+  EXPECT_TRUE(worklist1.IsEmpty());
+  EXPECT_EQ(4U, worklist2.Size());
+  TestWorklist::Local worklist_local2(worklist2);
+  SomeObject* retrieved = nullptr;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(worklist_local2.Pop(&retrieved));
+    EXPECT_EQ(&dummy, retrieved);
+  }
+  EXPECT_TRUE(worklist2.IsEmpty());
+}
+
 }  // namespace base
 }  // namespace heap
@@ -0,0 +1,101 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/flags/flags.h"
+#include "src/handles/handles-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/large-page.h"
+#include "src/heap/remembered-set.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/objects-inl.h"
+#include "test/common/flag-utils.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using CardTableTest = TestWithHeapInternalsAndContext;
+
+namespace {
+
+// Large enough for the large object space.
+constexpr int kLength = 64 * 1024;
+constexpr int kIndex = kLength / 2;
+
+uint8_t* CardOf(LargePage* page, Address slot) {
+  return page->card_table() +
+         ((slot - page->address()) >> MemoryChunk::kCardSizeLog2);
+}
+
+// Stores a new young array into `array` without keeping a handle to it, so
+// only the card of the slot keeps it alive.
+void StoreYoungArray(Isolate* isolate, Handle<FixedArray> array) {
+  HandleScope scope(isolate);
+  Handle<FixedArray> young = isolate->factory()->NewFixedArray(1);
+  young->set(0, Smi::FromInt(42));
+  array->set(kIndex, *young);
+}
+
+}  // namespace
+
+TEST_F(CardTableTest, ScavengerScansDirtyCards) {
+  if (v8_flags.single_generation || v8_flags.minor_ms) GTEST_SKIP();
+  FlagScope<bool> card_marking(&v8_flags.card_marking_remembered_set, true);
+  ManualGCScope manual_gc_scope(isolate());
+  HandleScope scope(isolate());
+  Handle<FixedArray> array =
+      factory()->NewFixedArray(kLength, AllocationType::kOld);
+  LargePage* page = LargePage::FromHeapObject(*array);
+  ASSERT_EQ(LO_SPACE, page->owner_identity());
+  ASSERT_NE(nullptr, page->card_table());
+
+  StoreYoungArray(isolate(), array);
+  Address slot = array->RawFieldOfElementAt(kIndex).address();
+  uint8_t* card = CardOf(page, slot);
+  EXPECT_EQ(MemoryChunk::kDirtyCard, *card);
+  EXPECT_FALSE(RememberedSet<OLD_TO_NEW>::Contains(page, slot));
+
+  // The first scavenge copies the object within the young generation, so the
+  // card stays dirty.
+  InvokeMinorGC();
+  FixedArray copied = FixedArray::cast(array->get(kIndex));
+  EXPECT_TRUE(Heap::InYoungGeneration(copied));
+  EXPECT_EQ(42, Smi::ToInt(copied->get(0)));
+  EXPECT_EQ(MemoryChunk::kDirtyCard, *card);
+  EXPECT_FALSE(RememberedSet<OLD_TO_NEW>::Contains(page, slot));
+
+  // The second scavenge promotes it and cleans the card.
+  InvokeMinorGC();
+  FixedArray promoted = FixedArray::cast(array->get(kIndex));
+  EXPECT_FALSE(Heap::InYoungGeneration(promoted));
+  EXPECT_EQ(42, Smi::ToInt(promoted->get(0)));
+  EXPECT_EQ(MemoryChunk::kCleanCard, *card);
+  EXPECT_FALSE(RememberedSet<OLD_TO_NEW>::Contains(page, slot));
+}
+
+TEST_F(CardTableTest, MarkCompactUpdatesDirtyCards) {
+  if (v8_flags.single_generation || v8_flags.minor_ms) GTEST_SKIP();
+  FlagScope<bool> card_marking(&v8_flags.card_marking_remembered_set, true);
+  ManualGCScope manual_gc_scope(isolate());
+  HandleScope scope(isolate());
+  Handle<FixedArray> array =
+      factory()->NewFixedArray(kLength, AllocationType::kOld);
+  LargePage* page = LargePage::FromHeapObject(*array);
+  ASSERT_NE(nullptr, page->card_table());
+
+  StoreYoungArray(isolate(), array);
+  uint8_t* card = CardOf(page, array->RawFieldOfElementAt(kIndex).address());
+  EXPECT_EQ(MemoryChunk::kDirtyCard, *card);
+
+  // A full GC empties the young generation and updates the slot.
+  InvokeMajorGC();
+  FixedArray promoted = FixedArray::cast(array->get(kIndex));
+  EXPECT_FALSE(Heap::InYoungGeneration(promoted));
+  EXPECT_EQ(42, Smi::ToInt(promoted->get(0)));
+  EXPECT_EQ(MemoryChunk::kCleanCard, *card);
+}
+
+}  // namespace internal
+}  // namespace v8
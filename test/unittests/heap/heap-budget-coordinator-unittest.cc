@@ -0,0 +1,47 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-budget-coordinator.h"
+
+#include "src/heap/heap.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using HeapBudgetCoordinatorTest = TestWithHeapInternalsAndContext;
+
+TEST_F(HeapBudgetCoordinatorTest, NoLimitBeforeFullGC) {
+  HeapBudgetCoordinator coordinator(64 * MB);
+  coordinator.AddHeap(heap());
+  coordinator.NotifyGC(heap(), GarbageCollector::SCAVENGER);
+  EXPECT_EQ(0u, coordinator.LimitForTesting(heap()));
+  coordinator.RemoveHeap(heap());
+}
+
+TEST_F(HeapBudgetCoordinatorTest, SingleHeapGetsWholeBudget) {
+  const size_t budget = 256 * MB;
+  HeapBudgetCoordinator coordinator(budget);
+  coordinator.AddHeap(heap());
+  InvokeMajorGC();
+  coordinator.NotifyGC(heap(), GarbageCollector::MARK_COMPACTOR);
+  ASSERT_LT(heap()->OldGenerationSizeOfObjects(), budget);
+  EXPECT_EQ(budget, coordinator.LimitForTesting(heap()));
+  coordinator.RemoveHeap(heap());
+  EXPECT_EQ(0u, coordinator.LimitForTesting(heap()));
+}
+
+TEST_F(HeapBudgetCoordinatorTest, OverBudgetHeapGetsMinimalExtraSpace) {
+  HeapBudgetCoordinator coordinator(1);
+  coordinator.AddHeap(heap());
+  InvokeMajorGC();
+  coordinator.NotifyGC(heap(), GarbageCollector::MARK_COMPACTOR);
+  EXPECT_EQ(heap()->OldGenerationSizeOfObjects() + 2 * MB,
+            coordinator.LimitForTesting(heap()));
+  coordinator.RemoveHeap(heap());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,78 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/heap-census.h"
+
+#include "include/v8-profiler.h"
+#include "src/heap/heap.h"
+#include "src/roots/roots-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+using HeapCensusTest = TestWithHeapInternalsAndContext;
+
+TEST_F(HeapCensusTest, SamplerScalesSamples) {
+  Map map = ReadOnlyRoots(heap()).fixed_array_map();
+  HeapCensusSampler sampler;
+  sampler.Start(100);
+  for (int i = 0; i < 10; i++) sampler.Sample(map, 50);
+  ASSERT_EQ(1u, sampler.samples().size());
+  const HeapCensusSampler::Estimate& estimate =
+      sampler.samples().at(map.ptr());
+  EXPECT_EQ(500.0, estimate.size);
+  EXPECT_EQ(10.0, estimate.count);
+}
+
+TEST_F(HeapCensusTest, SamplerCountsLargeObjectsOnce) {
+  Map map = ReadOnlyRoots(heap()).fixed_array_map();
+  HeapCensusSampler sampler;
+  sampler.Start(100);
+  // Covers two sample points.
+  sampler.Sample(map, 250);
+  const HeapCensusSampler::Estimate& estimate =
+      sampler.samples().at(map.ptr());
+  EXPECT_EQ(200.0, estimate.size);
+  EXPECT_DOUBLE_EQ(0.8, estimate.count);
+}
+
+TEST_F(HeapCensusTest, DisabledSamplerRecordsNothing) {
+  Map map = ReadOnlyRoots(heap()).fixed_array_map();
+  HeapCensusSampler sampler;
+  sampler.Start(0);
+  for (int i = 0; i < 1000; i++) sampler.Sample(map, 1 * MB);
+  EXPECT_TRUE(sampler.samples().empty());
+}
+
+TEST_F(HeapCensusTest, CensusFindsConstructor) {
+  v8::HeapProfiler* heap_profiler = v8_isolate()->GetHeapProfiler();
+  EXPECT_TRUE(heap_profiler->GetHeapCensus().empty());
+  // Sample every object.
+  heap_profiler->StartHeapCensus(1);
+  RunJS(
+      "class CensusTestObject {};"
+      "globalThis.objects = [];"
+      "for (let i = 0; i < 1000; i++) objects.push(new CensusTestObject());");
+  InvokeMajorGC();
+  heap_profiler->StopHeapCensus();
+
+  size_t count = 0;
+  for (const v8::HeapCensusEntry& entry : heap_profiler->GetHeapCensus()) {
+    if (entry.constructor_name == "CensusTestObject") {
+      EXPECT_STREQ("JS_OBJECT_TYPE", entry.instance_type);
+      EXPECT_GT(entry.size, 0u);
+      count += entry.count;
+    }
+  }
+  EXPECT_EQ(1000u, count);
+
+  // The census remains available after stopping, but is not updated.
+  InvokeMajorGC();
+  EXPECT_FALSE(heap_profiler->GetHeapCensus().empty());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,97 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/request-scope-nursery.h"
+
+#include "include/v8-isolate.h"
+#include "src/flags/flags.h"
+#include "src/handles/handles-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/new-spaces.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/objects-inl.h"
+#include "test/unittests/heap/heap-utils.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+bool NurseryIsSupported() {
+  return v8_flags.request_scope_nursery && !v8_flags.minor_ms &&
+         !v8_flags.single_generation && !v8_flags.conservative_stack_scanning;
+}
+
+}  // namespace
+
+class RequestScopeNurseryTest : public TestWithHeapInternalsAndContext {
+ protected:
+  RequestScopeNursery* nursery() { return heap()->request_scope_nursery(); }
+};
+
+TEST_F(RequestScopeNurseryTest, DropsObjectsThatDoNotEscape) {
+  if (!NurseryIsSupported()) GTEST_SKIP();
+  ManualGCScope manual_gc_scope(isolate());
+  InvokeMinorGC();
+  const size_t discarded_scopes = nursery()->discarded_scopes();
+  size_t size_at_start;
+  {
+    v8::Isolate::RequestScope request_scope(v8_isolate());
+    ASSERT_TRUE(nursery()->IsActive());
+    size_at_start = heap()->new_space()->Size();
+    HandleScope handle_scope(isolate());
+    {
+      // Nested scopes belong to the outermost one.
+      v8::Isolate::RequestScope nested_scope(v8_isolate());
+      for (int i = 0; i < 100; i++) factory()->NewFixedArray(16);
+    }
+    EXPECT_TRUE(nursery()->IsActive());
+    EXPECT_LT(size_at_start, heap()->new_space()->Size());
+  }
+  EXPECT_FALSE(nursery()->IsActive());
+  EXPECT_EQ(discarded_scopes + 1, nursery()->discarded_scopes());
+  EXPECT_EQ(size_at_start, heap()->new_space()->Size());
+}
+
+TEST_F(RequestScopeNurseryTest, KeepsObjectsReachableFromOldObjects) {
+  if (!NurseryIsSupported()) GTEST_SKIP();
+  ManualGCScope manual_gc_scope(isolate());
+  InvokeMinorGC();
+  const size_t escaped_scopes = nursery()->escaped_scopes();
+  HandleScope handle_scope(isolate());
+  Handle<FixedArray> old_array =
+      factory()->NewFixedArray(1, AllocationType::kOld);
+  {
+    v8::Isolate::RequestScope request_scope(v8_isolate());
+    HandleScope inner_handle_scope(isolate());
+    Handle<FixedArray> young_array = factory()->NewFixedArray(1);
+    young_array->set(0, Smi::FromInt(42));
+    old_array->set(0, *young_array);
+  }
+  EXPECT_EQ(escaped_scopes + 1, nursery()->escaped_scopes());
+  InvokeMinorGC();
+  EXPECT_EQ(42, Smi::ToInt(FixedArray::cast(old_array->get(0))->get(0)));
+}
+
+TEST_F(RequestScopeNurseryTest, KeepsObjectsReachableFromHandles) {
+  if (!NurseryIsSupported()) GTEST_SKIP();
+  ManualGCScope manual_gc_scope(isolate());
+  InvokeMinorGC();
+  const size_t escaped_scopes = nursery()->escaped_scopes();
+  HandleScope handle_scope(isolate());
+  Handle<FixedArray> young_array;
+  {
+    v8::Isolate::RequestScope request_scope(v8_isolate());
+    young_array = factory()->NewFixedArray(1);
+    young_array->set(0, Smi::FromInt(42));
+  }
+  EXPECT_EQ(escaped_scopes + 1, nursery()->escaped_scopes());
+  InvokeMinorGC();
+  EXPECT_EQ(42, Smi::ToInt(young_array->get(0)));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <map>
 #include <optional>
 
@@ -432,6 +433,57 @@ TEST_F(SequentialUnmapperTest, UnmapOnTeardown) {
   tracking_page_allocator()->CheckIsFree(page->address(), page_size);
 #endif  // V8_COMPRESS_POINTERS
 }
+
+TEST_F(SequentialUnmapperTest, TransparentHugePagesPoolWholeHugePages) {
+  if (v8_flags.enable_third_party_heap) return;
+  constexpr size_t kPagesPerHugePage = kHugePageSize / MemoryChunk::kPageSize;
+  if (kPagesPerHugePage <= 1) return;
+  FlagScope<bool> transparent_huge_pages(&v8_flags.transparent_huge_pages,
+                                         true);
+  unmapper()->EnsureUnmappingCompleted();
+  PagedSpace* space = static_cast<PagedSpace*>(heap()->old_space());
+
+  // Old space pages are taken from the pool, which gets refilled with all
+  // pages of one huge page.
+  std::vector<Page*> pages;
+  for (size_t i = 0; i < kPagesPerHugePage; i++) {
+    Page* page = allocator()->AllocatePage(
+        MemoryAllocator::AllocationMode::kRegular, space,
+        Executability::NOT_EXECUTABLE);
+    ASSERT_NE(nullptr, page);
+    pages.push_back(page);
+  }
+  EXPECT_EQ(0, unmapper()->NumberOfChunks());
+  std::vector<Address> addresses;
+  for (Page* page : pages) addresses.push_back(page->address());
+  std::sort(addresses.begin(), addresses.end());
+  EXPECT_TRUE(IsAligned(addresses.front(), kHugePageSize));
+  for (size_t i = 0; i < kPagesPerHugePage; i++) {
+    EXPECT_EQ(addresses.front() + i * MemoryChunk::kPageSize, addresses[i]);
+  }
+
+  // Freed pages are pooled and stay committed, so that the huge page is not
+  // split.
+  for (Page* page : pages) {
+    allocator()->Free(MemoryAllocator::FreeMode::kConcurrently, page);
+  }
+  unmapper()->FreeQueuedChunks();
+  EXPECT_EQ(static_cast<int>(kPagesPerHugePage), unmapper()->NumberOfChunks());
+  for (Address address : addresses) {
+    tracking_page_allocator()->CheckPagePermissions(
+        address, MemoryChunk::kPageSize, PageAllocator::kReadWrite);
+  }
+
+  // The next page reuses the huge page.
+  Page* page =
+      allocator()->AllocatePage(MemoryAllocator::AllocationMode::kRegular,
+                                space, Executability::NOT_EXECUTABLE);
+  ASSERT_NE(nullptr, page);
+  EXPECT_TRUE(std::binary_search(addresses.begin(), addresses.end(),
+                                 page->address()));
+  allocator()->Free(MemoryAllocator::FreeMode::kImmediately, page);
+  unmapper()->TearDown();
+}
 #endif  // !V8_OS_FUCHSIA && !V8_ENABLE_SANDBOX
 
 }  // namespace internal
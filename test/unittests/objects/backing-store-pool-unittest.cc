@@ -0,0 +1,177 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/objects/backing-store-pool.h"
+
+#include "src/execution/isolate.h"
+#include "src/heap/heap.h"
+#include "src/objects/backing-store.h"
+#include "test/common/flag-utils.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+class BackingStorePoolTest : public TestWithIsolate {};
+
+TEST_F(BackingStorePoolTest, SizeClasses) {
+  FlagScope<unsigned> max_block_size(
+      &v8_flags.backing_store_pool_max_block_size, 100);
+  EXPECT_FALSE(BackingStorePool::IsPoolable(0));
+  EXPECT_TRUE(BackingStorePool::IsPoolable(1));
+  // Only full size classes are served by the pool.
+  EXPECT_TRUE(BackingStorePool::IsPoolable(64 * KB));
+  EXPECT_FALSE(BackingStorePool::IsPoolable(64 * KB + 1));
+  EXPECT_EQ(16u, BackingStorePool::BlockSize(1));
+  EXPECT_EQ(16u, BackingStorePool::BlockSize(16));
+  EXPECT_EQ(32u, BackingStorePool::BlockSize(17));
+  EXPECT_EQ(size_t{64 * KB}, BackingStorePool::BlockSize(33 * KB));
+}
+
+TEST_F(BackingStorePoolTest, ReusesFreedBlocks) {
+  BackingStorePool pool(isolate());
+  const size_t block_size = BackingStorePool::BlockSize(100);
+  uint8_t* block = reinterpret_cast<uint8_t*>(
+      pool.Allocate(100, InitializedFlag::kUninitialized));
+  ASSERT_NE(nullptr, block);
+  memset(block, 0xFF, 100);
+  pool.Free(block, block_size);
+  EXPECT_EQ(block_size, pool.CachedBytes());
+
+  uint8_t* reused = reinterpret_cast<uint8_t*>(
+      pool.Allocate(100, InitializedFlag::kZeroInitialized));
+  EXPECT_EQ(block, reused);
+  EXPECT_EQ(0u, pool.CachedBytes());
+  for (int i = 0; i < 100; i++) EXPECT_EQ(0, reused[i]);
+
+  pool.Free(reused, block_size);
+  pool.Trim();
+  EXPECT_EQ(0u, pool.CachedBytes());
+}
+
+TEST_F(BackingStorePoolTest, RespectsCacheLimit) {
+  FlagScope<unsigned> pool_size(&v8_flags.backing_store_pool_size, 1);
+  BackingStorePool pool(isolate());
+  void* small = pool.Allocate(KB, InitializedFlag::kUninitialized);
+  void* large = pool.Allocate(2 * KB, InitializedFlag::kUninitialized);
+  pool.Free(large, 2 * KB);
+  EXPECT_EQ(0u, pool.CachedBytes());
+  pool.Free(small, KB);
+  EXPECT_EQ(size_t{KB}, pool.CachedBytes());
+}
+
+TEST_F(BackingStorePoolTest, StopsCachingAfterTearDown) {
+  BackingStorePool pool(isolate());
+  void* block = pool.Allocate(KB, InitializedFlag::kUninitialized);
+  pool.TearDown();
+  pool.Free(block, KB);
+  EXPECT_EQ(0u, pool.CachedBytes());
+}
+
+// The pool is created with the heap, so the flag has to be set before the
+// isolate of each test is created.
+class BackingStoreAllocateTest : public TestWithIsolate {
+ public:
+  static void SetUpTestSuite() {
+    saved_flag_ = v8_flags.backing_store_pool;
+    v8_flags.backing_store_pool = true;
+    TestWithIsolate::SetUpTestSuite();
+  }
+
+  static void TearDownTestSuite() {
+    TestWithIsolate::TearDownTestSuite();
+    v8_flags.backing_store_pool = saved_flag_;
+  }
+
+  BackingStorePool* pool() {
+    return isolate()->heap()->backing_store_pool().get();
+  }
+
+  std::unique_ptr<BackingStore> Allocate(size_t byte_length) {
+    return BackingStore::Allocate(isolate(), byte_length,
+                                  SharedFlag::kNotShared,
+                                  InitializedFlag::kZeroInitialized);
+  }
+
+ private:
+  static bool saved_flag_;
+};
+
+bool BackingStoreAllocateTest::saved_flag_ = false;
+
+TEST_F(BackingStoreAllocateTest, ReusesPooledMemory) {
+  ASSERT_NE(nullptr, pool());
+  const size_t block_size = BackingStorePool::BlockSize(100);
+  const size_t cached_bytes = pool()->CachedBytes();
+
+  std::unique_ptr<BackingStore> backing_store = Allocate(100);
+  ASSERT_NE(nullptr, backing_store);
+  EXPECT_TRUE(backing_store->is_pooled());
+  EXPECT_EQ(100u, backing_store->byte_length());
+  EXPECT_EQ(block_size, backing_store->byte_capacity());
+  void* start = backing_store->buffer_start();
+  memset(start, 0xFF, 100);
+  backing_store.reset();
+  EXPECT_EQ(cached_bytes + block_size, pool()->CachedBytes());
+
+  // A backing store of the same size class gets the same block, with the
+  // bytes it exposes cleared.
+  backing_store = Allocate(90);
+  ASSERT_NE(nullptr, backing_store);
+  EXPECT_EQ(start, backing_store->buffer_start());
+  EXPECT_EQ(cached_bytes, pool()->CachedBytes());
+  const uint8_t* bytes =
+      reinterpret_cast<const uint8_t*>(backing_store->buffer_start());
+  for (int i = 0; i < 90; i++) EXPECT_EQ(0, bytes[i]);
+
+  // Shared backing stores are not pooled.
+  std::unique_ptr<BackingStore> shared =
+      BackingStore::Allocate(isolate(), 100, SharedFlag::kShared,
+                             InitializedFlag::kZeroInitialized);
+  ASSERT_NE(nullptr, shared);
+  EXPECT_FALSE(shared->is_pooled());
+  EXPECT_EQ(100u, shared->byte_capacity());
+}
+
+TEST_F(BackingStoreAllocateTest, ReallocateLeavesPool) {
+  ASSERT_NE(nullptr, pool());
+  const size_t block_size = BackingStorePool::BlockSize(100);
+  const size_t cached_bytes = pool()->CachedBytes();
+
+  std::unique_ptr<BackingStore> backing_store = Allocate(100);
+  ASSERT_NE(nullptr, backing_store);
+  ASSERT_TRUE(backing_store->is_pooled());
+  void* pooled_start = backing_store->buffer_start();
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(pooled_start);
+  for (int i = 0; i < 100; i++) bytes[i] = static_cast<uint8_t>(i);
+
+  // Growing moves the contents to memory of the embedder's allocator and
+  // returns the block to the pool.
+  ASSERT_TRUE(backing_store->CanReallocate());
+  EXPECT_TRUE(backing_store->Reallocate(isolate(), 200));
+  EXPECT_FALSE(backing_store->is_pooled());
+  EXPECT_EQ(200u, backing_store->byte_length());
+  EXPECT_EQ(200u, backing_store->byte_capacity());
+  EXPECT_EQ(cached_bytes + block_size, pool()->CachedBytes());
+  bytes = reinterpret_cast<uint8_t*>(backing_store->buffer_start());
+  for (int i = 0; i < 100; i++) EXPECT_EQ(i, bytes[i]);
+  for (int i = 100; i < 200; i++) EXPECT_EQ(0, bytes[i]);
+
+  // Shrinking goes through the embedder's allocator only.
+  EXPECT_TRUE(backing_store->Reallocate(isolate(), 10));
+  EXPECT_EQ(10u, backing_store->byte_length());
+  bytes = reinterpret_cast<uint8_t*>(backing_store->buffer_start());
+  for (int i = 0; i < 10; i++) EXPECT_EQ(i, bytes[i]);
+  backing_store.reset();
+  EXPECT_EQ(cached_bytes + block_size, pool()->CachedBytes());
+
+  // The returned block is handed out again.
+  backing_store = Allocate(100);
+  ASSERT_NE(nullptr, backing_store);
+  EXPECT_EQ(pooled_start, backing_store->buffer_start());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,160 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/execution/local-isolate.h"
+#include "src/handles/persistent-handles.h"
+#include "src/heap/local-factory-inl.h"
+#include "src/heap/local-heap-inl.h"
+#include "src/heap/parked-scope-inl.h"
+#include "src/objects/string-table.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Enough keys to grow the string table several times while the threads are
+// inserting into it.
+constexpr int kKeyCount = 8192;
+
+std::string KeyString(int thread_count, int key_index) {
+  return "concurrent-string-table-" + std::to_string(thread_count) + "-" +
+         std::to_string(key_index);
+}
+
+class InternalizeThread final : public ParkingThread {
+ public:
+  InternalizeThread(Isolate* isolate, int thread_count, int thread_index,
+                    ParkingSemaphore* sema_ready,
+                    ParkingSemaphore* sema_execute_start)
+      : ParkingThread(Options("InternalizeThread")),
+        isolate_(isolate),
+        thread_count_(thread_count),
+        thread_index_(thread_index),
+        sema_ready_(sema_ready),
+        sema_execute_start_(sema_execute_start) {}
+
+  void Run() override {
+    LocalIsolate local_isolate(isolate_, ThreadKind::kBackground);
+    UnparkedScope unparked_scope(local_isolate.heap());
+
+    sema_ready_->Signal();
+    sema_execute_start_->ParkedWait(&local_isolate);
+
+    // Every thread internalizes every key, starting at a different offset, so
+    // that threads both race to insert the same strings and insert different
+    // strings at the same time.
+    results_.resize(kKeyCount);
+    const int offset = thread_index_ * (kKeyCount / thread_count_);
+    for (int i = 0; i < kKeyCount; i++) {
+      const int key_index = (offset + i) % kKeyCount;
+      std::string key = KeyString(thread_count_, key_index);
+      Handle<String> result = local_isolate.factory()->InternalizeString(
+          base::Vector<const uint8_t>(
+              reinterpret_cast<const uint8_t*>(key.data()), key.size()));
+      results_[key_index] = local_isolate.heap()->NewPersistentHandle(result);
+    }
+    persistent_handles_ = local_isolate.heap()->DetachPersistentHandles();
+  }
+
+  Handle<String> result(int key_index) const { return results_[key_index]; }
+
+ private:
+  Isolate* isolate_;
+  const int thread_count_;
+  const int thread_index_;
+  ParkingSemaphore* sema_ready_;
+  ParkingSemaphore* sema_execute_start_;
+  std::vector<Handle<String>> results_;
+  std::unique_ptr<PersistentHandles> persistent_handles_;
+};
+
+// Internalizes the same set of strings from several threads and checks that
+// every thread ends up with the same internalized string for each key.
+void InternalizeFromThreads(Isolate* isolate, int thread_count) {
+  ParkingSemaphore sema_ready(0);
+  ParkingSemaphore sema_execute_start(0);
+  std::vector<std::unique_ptr<InternalizeThread>> threads;
+  for (int i = 0; i < thread_count; i++) {
+    auto thread = std::make_unique<InternalizeThread>(
+        isolate, thread_count, i, &sema_ready, &sema_execute_start);
+    CHECK(thread->Start());
+    threads.push_back(std::move(thread));
+  }
+
+  LocalIsolate* local_isolate = isolate->main_thread_local_isolate();
+  for (int i = 0; i < thread_count; i++) sema_ready.ParkedWait(local_isolate);
+  for (int i = 0; i < thread_count; i++) sema_execute_start.Signal();
+  ParkingThread::ParkedJoinAll(local_isolate, threads);
+
+  HandleScope handle_scope(isolate);
+  for (int i = 0; i < kKeyCount; i++) {
+    Handle<String> expected = isolate->factory()->InternalizeUtf8String(
+        KeyString(thread_count, i).c_str());
+    EXPECT_TRUE(IsInternalizedString(*expected));
+    EXPECT_EQ(v8_flags.shared_string_table, expected->IsShared());
+    for (const std::unique_ptr<InternalizeThread>& thread : threads) {
+      EXPECT_EQ(*expected, *thread->result(i));
+    }
+  }
+  // All keys ended up in the table.
+  EXPECT_GE(isolate->string_table()->NumberOfElements(), kKeyCount);
+}
+
+}  // namespace
+
+class ConcurrentStringTableTest : public TestWithContext,
+                                  public ::testing::WithParamInterface<int> {};
+
+// The reported test time doubles as a measure of internalization throughput
+// for the given number of threads.
+TEST_P(ConcurrentStringTableTest, InternalizeFromThreads) {
+  InternalizeFromThreads(i_isolate(), GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(ConcurrentStringTable, ConcurrentStringTableTest,
+                         ::testing::Values(1, 2, 4, 8, 16, 32));
+
+// Runs the same test with --shared-string-table, where the table is owned by
+// the shared space isolate and its strings live in the shared heap. The flag
+// has to be set before the isolate of each test is created.
+class ConcurrentSharedStringTableTest
+    : public TestWithContext,
+      public ::testing::WithParamInterface<int> {
+ public:
+  static void SetUpTestSuite() {
+    saved_flag_ = v8_flags.shared_string_table;
+    if (V8_CAN_CREATE_SHARED_HEAP_BOOL) v8_flags.shared_string_table = true;
+    TestWithContext::SetUpTestSuite();
+  }
+
+  static void TearDownTestSuite() {
+    TestWithContext::TearDownTestSuite();
+    v8_flags.shared_string_table = saved_flag_;
+  }
+
+ private:
+  static bool saved_flag_;
+};
+
+bool ConcurrentSharedStringTableTest::saved_flag_ = false;
+
+TEST_P(ConcurrentSharedStringTableTest, InternalizeFromThreads) {
+  if (!V8_CAN_CREATE_SHARED_HEAP_BOOL) GTEST_SKIP();
+  ASSERT_TRUE(v8_flags.shared_string_table);
+  InternalizeFromThreads(i_isolate(), GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(ConcurrentSharedStringTable,
+                         ConcurrentSharedStringTableTest,
+                         ::testing::Values(1, 4, 16));
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,186 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/snapshot/read-only-heap-image.h"
+
+#include <cstring>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "src/base/platform/wrappers.h"
+#include "src/heap/read-only-heap.h"
+#include "src/heap/read-only-spaces.h"
+#include "src/objects/objects-inl.h"
+#include "src/snapshot/snapshot.h"
+#include "src/utils/allocation.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr char kImagePath[] = "read-only-heap-image-unittest.img";
+constexpr char kModifiedImagePath[] = "read-only-heap-image-unittest-mod.img";
+
+std::vector<uint8_t> ReadFile(const char* path) {
+  std::vector<uint8_t> bytes;
+  FILE* fp = base::OS::FOpen(path, "rb");
+  CHECK_NOT_NULL(fp);
+  uint8_t buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+    bytes.insert(bytes.end(), buffer, buffer + read);
+  }
+  base::Fclose(fp);
+  return bytes;
+}
+
+void WriteFile(const char* path, const std::vector<uint8_t>& bytes) {
+  FILE* fp = base::OS::FOpen(path, "wb");
+  CHECK_NOT_NULL(fp);
+  CHECK_EQ(bytes.size(), fwrite(bytes.data(), 1, bytes.size(), fp));
+  base::Fclose(fp);
+}
+
+// Whether the deserializer or rehashing rewrites `object` after its bytes
+// were copied or mapped from the snapshot, see
+// ReadOnlyDeserializer::PostProcessNewObjects.
+bool IsRewrittenAfterDeserialization(Isolate* isolate, HeapObject object) {
+  const InstanceType type = object->map()->instance_type();
+  return InstanceTypeChecker::IsCode(type) ||
+         InstanceTypeChecker::IsSharedFunctionInfo(type) ||
+         InstanceTypeChecker::IsName(type) || object->NeedsRehashing(type) ||
+         object.ptr() == ReadOnlyRoots(isolate).hash_seed().ptr();
+}
+
+}  // namespace
+
+class ReadOnlyHeapImageTest : public TestWithIsolate {
+ protected:
+  void SetUp() override {
+    if (!V8_STATIC_ROOTS_BOOL || !base::OS::IsRemapPageSupported()) {
+      GTEST_SKIP() << "The read-only heap image requires static roots";
+    }
+    blob_ = Snapshot::DefaultSnapshotBlob();
+    if (blob_ == nullptr) GTEST_SKIP() << "Requires a snapshot";
+    CHECK(Snapshot::WriteReadOnlyHeapImage(blob_, kImagePath));
+  }
+
+  void TearDown() override {
+    base::OS::Remove(kImagePath);
+    base::OS::Remove(kModifiedImagePath);
+  }
+
+  std::unique_ptr<ReadOnlyHeapImage> OpenModifiedImage(
+      const std::vector<uint8_t>& bytes) {
+    WriteFile(kModifiedImagePath, bytes);
+    return Snapshot::OpenReadOnlyHeapImage(blob_, kModifiedImagePath);
+  }
+
+  const v8::StartupData* blob_ = nullptr;
+};
+
+TEST_F(ReadOnlyHeapImageTest, MappedPagesMatchDeserializedSpace) {
+  std::unique_ptr<ReadOnlyHeapImage> image =
+      Snapshot::OpenReadOnlyHeapImage(blob_, kImagePath);
+  ASSERT_NE(nullptr, image);
+
+  v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
+  const Address cage_base = i_isolate()->GetPtrComprCage()->base();
+  const std::vector<ReadOnlyPage*>& pages =
+      i_isolate()->read_only_heap()->read_only_space()->pages();
+  int compared_objects = 0;
+  for (size_t i = 0; i < pages.size(); i++) {
+    const ReadOnlyPage* page = pages[i];
+    const size_t header_size = page->area_start() - page->address();
+    uint8_t* scratch = static_cast<uint8_t*>(AllocatePages(
+        page_allocator, nullptr, page->size(),
+        page_allocator->AllocatePageSize(), PageAllocator::kReadWrite));
+    ASSERT_NE(nullptr, scratch);
+    memset(scratch, 0xAB, header_size);
+
+    // The header of the target page is preserved.
+    ASSERT_TRUE(image->MapPage(
+        static_cast<int>(i), static_cast<uint32_t>(page->address() - cage_base),
+        reinterpret_cast<Address>(scratch), page->size(), header_size));
+    for (size_t j = 0; j < header_size; j++) {
+      ASSERT_EQ(0xAB, scratch[j]);
+    }
+
+    // The mapped contents equal the deserialized objects, other than those
+    // that are rewritten after deserialization.
+    ReadOnlyPageObjectIterator it(page);
+    for (HeapObject object = it.Next(); !object.is_null();
+         object = it.Next()) {
+      if (IsRewrittenAfterDeserialization(i_isolate(), object)) continue;
+      const size_t offset = object.address() - page->address();
+      const int size = object->Size();
+      ASSERT_EQ(0, memcmp(scratch + offset,
+                          reinterpret_cast<void*>(object.address()), size))
+          << "object at page " << i << " offset " << offset;
+      compared_objects++;
+    }
+    FreePages(page_allocator, scratch, page->size());
+  }
+  EXPECT_LT(0, compared_objects);
+}
+
+TEST_F(ReadOnlyHeapImageTest, RejectsPageOfOtherAddress) {
+  std::unique_ptr<ReadOnlyHeapImage> image =
+      Snapshot::OpenReadOnlyHeapImage(blob_, kImagePath);
+  ASSERT_NE(nullptr, image);
+
+  const ReadOnlyPage* page =
+      i_isolate()->read_only_heap()->read_only_space()->pages()[0];
+  const uint32_t compressed_address = static_cast<uint32_t>(
+      page->address() - i_isolate()->GetPtrComprCage()->base());
+  std::vector<uint8_t> memory(page->size(), 0xAB);
+  // The page address doesn't match, so the memory must not be touched.
+  EXPECT_FALSE(image->MapPage(0, compressed_address + kRegularPageSize,
+                              reinterpret_cast<Address>(memory.data()),
+                              memory.size(), 0));
+  EXPECT_FALSE(image->MapPage(
+      static_cast<int>(
+          i_isolate()->read_only_heap()->read_only_space()->pages().size()),
+      compressed_address, reinterpret_cast<Address>(memory.data()),
+      memory.size(), 0));
+  for (uint8_t byte : memory) ASSERT_EQ(0xAB, byte);
+}
+
+TEST_F(ReadOnlyHeapImageTest, RejectsTruncatedFile) {
+  std::vector<uint8_t> bytes = ReadFile(kImagePath);
+  ASSERT_LT(ReadOnlyHeapImage::kPageAlignment, bytes.size());
+  // Cut off the contents of the last page.
+  bytes.resize(bytes.size() - ReadOnlyHeapImage::kPageAlignment / 2);
+  EXPECT_EQ(nullptr, OpenModifiedImage(bytes));
+  // Cut off the header.
+  bytes.resize(2 * sizeof(uint32_t));
+  EXPECT_EQ(nullptr, OpenModifiedImage(bytes));
+}
+
+TEST_F(ReadOnlyHeapImageTest, RejectsBadHeader) {
+  std::vector<uint8_t> bytes = ReadFile(kImagePath);
+  // The magic number is the first field of the header.
+  bytes[0] ^= 0xFF;
+  EXPECT_EQ(nullptr, OpenModifiedImage(bytes));
+  bytes[0] ^= 0xFF;
+  EXPECT_NE(nullptr, OpenModifiedImage(bytes));
+
+  // A page count that doesn't fit in the file.
+  const uint32_t page_count = 0x10000000;
+  memcpy(bytes.data() + 2 * sizeof(uint32_t), &page_count, sizeof(page_count));
+  EXPECT_EQ(nullptr, OpenModifiedImage(bytes));
+}
+
+TEST_F(ReadOnlyHeapImageTest, RejectsChecksumMismatch) {
+  std::vector<uint8_t> bytes = ReadFile(kImagePath);
+  // The checksum of the read-only snapshot is the second field of the header.
+  bytes[sizeof(uint32_t)] ^= 0x01;
+  EXPECT_EQ(nullptr, OpenModifiedImage(bytes));
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -4,6 +4,9 @@
 
 #include "src/utils/allocation.h"
 
+#include "src/base/platform/platform.h"
+#include "src/flags/flags.h"
+#include "src/heap/code-range.h"
 #include "test/unittests/test-utils.h"
 
 #if V8_OS_POSIX
@@ -179,5 +182,92 @@ TEST_F(AllocationTest, ReserveMemory) {
   v8::internal::FreePages(page_allocator, mem_addr, kAllocationSize);
 }
 
+class TransparentHugePagesTest : public TestWithPlatform {
+ protected:
+  // Writes to a page committed in {page_allocator}, which must succeed
+  // whether or not the memory is backed by huge pages.
+  static void CommitAndWrite(v8::PageAllocator* page_allocator,
+                             Address address) {
+    const size_t commit_size = page_allocator->CommitPageSize();
+    void* page = reinterpret_cast<void*>(address);
+    CHECK(SetPermissions(page_allocator, page, commit_size,
+                         PageAllocator::Permission::kReadWrite));
+    static_cast<volatile int*>(page)[0] = 42;
+    CHECK_EQ(42, static_cast<volatile int*>(page)[0]);
+    CHECK(SetPermissions(page_allocator, page, commit_size,
+                         PageAllocator::Permission::kNoAccess));
+  }
+
+  FlagScope<bool> transparent_huge_pages_{&v8_flags.transparent_huge_pages,
+                                          true};
+};
+
+TEST_F(TransparentHugePagesTest, RegionWithoutAlignedHugePage) {
+  // The advice is only given for the huge pages that are contained in the
+  // region, and this region spans two huge pages without containing one.
+  const Address base = RoundUp(Address{1} << 32, size_t{kHugePageSize});
+  const size_t page_size = AllocatePageSize();
+  EXPECT_FALSE(AdviseTransparentHugePages(
+      base::AddressRegion(base + page_size, kHugePageSize)));
+  EXPECT_FALSE(AdviseTransparentHugePages(
+      base::AddressRegion(base + page_size, kHugePageSize - 2 * page_size)));
+  EXPECT_FALSE(AdviseTransparentHugePages(base::AddressRegion(base, 0)));
+}
+
+TEST_F(TransparentHugePagesTest, DisabledByFlag) {
+  FlagScope<bool> no_transparent_huge_pages(&v8_flags.transparent_huge_pages,
+                                            false);
+  v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
+  VirtualMemory reservation(page_allocator, 2 * size_t{kHugePageSize},
+                            page_allocator->GetRandomMmapAddr(),
+                            kHugePageSize);
+  ASSERT_TRUE(reservation.IsReserved());
+  EXPECT_FALSE(AdviseTransparentHugePages(reservation.region()));
+}
+
+TEST_F(TransparentHugePagesTest, ReserveCage) {
+  v8::PageAllocator* page_allocator = GetPlatformPageAllocator();
+  VirtualMemoryCage::ReservationParams params;
+  params.page_allocator = page_allocator;
+  params.reservation_size = 4 * size_t{kHugePageSize};
+  params.base_alignment = kHugePageSize;
+  params.page_size = page_allocator->CommitPageSize();
+  params.requested_start_hint =
+      reinterpret_cast<Address>(page_allocator->GetRandomMmapAddr());
+  params.jit = JitPermission::kNoJit;
+
+  VirtualMemoryCage cage;
+  ASSERT_TRUE(cage.InitReservation(params));
+  // The kernel may not be built with transparent huge page support, in which
+  // case the advice fails, but the reservation stays usable.
+  bool advised = AdviseTransparentHugePages(cage.region());
+  if (!base::OS::IsTransparentHugePageSupported()) EXPECT_FALSE(advised);
+
+  CommitAndWrite(page_allocator, cage.base());
+  CommitAndWrite(page_allocator, cage.base() + kHugePageSize);
+  cage.Free();
+}
+
+TEST_F(TransparentHugePagesTest, ReserveCodeRange) {
+  CodeRange code_range;
+  ASSERT_TRUE(code_range.InitReservation(
+      GetPlatformPageAllocator(),
+      std::max(kMinimumCodeRangeSize, 4 * size_t{kHugePageSize})));
+  // The code range is reserved with huge page alignment so that its start
+  // can be backed by a huge page as well.
+  EXPECT_TRUE(IsAligned(code_range.region().begin(), size_t{kHugePageSize}));
+
+  v8::PageAllocator* page_allocator = code_range.page_allocator();
+  void* page = AllocatePages(page_allocator, nullptr,
+                             page_allocator->AllocatePageSize(),
+                             page_allocator->AllocatePageSize(),
+                             PageAllocator::Permission::kReadWrite);
+  ASSERT_NE(nullptr, page);
+  static_cast<volatile int*>(page)[0] = 42;
+  EXPECT_EQ(42, static_cast<volatile int*>(page)[0]);
+  FreePages(page_allocator, page, page_allocator->AllocatePageSize());
+  code_range.Free();
+}
+
 }  // namespace internal
 }  // namespace v8